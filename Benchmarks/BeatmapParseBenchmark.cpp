@@ -0,0 +1,112 @@
+// BeatmapParseBenchmark.cpp : Measures the time to parse a beatmap without the beatmap cache,
+// on synthetic beatmaps of every kind.
+
+#include <BenchmarkSupport/Benchmark.h>
+
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/Beatmap.h>
+#include <Content/OsuBot/SliderPathCache.h>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotBenchmarks;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// Moves the [HitObjects] section in front of the [Difficulty] section,
+	// the hit objects are read before the values they depend on.
+	std::string MoveHitObjectsFirst(_In_ const std::string& content) {
+		const size_t difficulty = content.find("[Difficulty]");
+		const size_t hitObjects = content.find("[HitObjects]");
+		return content.substr(0U, difficulty) + content.substr(hitObjects) + "\r\n" + content.substr(difficulty, hitObjects - difficulty);
+	}
+
+	// Parses the beatmap the run count times, every parse flattens its sliders again
+	// unless the paths of the slider path cache are kept.
+	// Returns FALSE if the beatmap could not be parsed.
+	bool MeasureParse(_In_ const char* name, _In_ const std::wstring& beatmapPath, _In_ const UINT& runCount, _In_opt_ const bool& keepSliderPaths = FALSE) {
+		UINT hitObjectCount = 0U;
+		bool parsed = TRUE;
+		const BenchmarkTimes times = MeasureRuns(runCount, [&]() {
+			if (!keepSliderPaths) {
+				SliderPathCache::GetInstance().Clear();
+			}
+
+			Beatmap beatmap(beatmapPath.c_str());
+			parsed = parsed && beatmap.ParseBeatmap(FALSE);
+			hitObjectCount = beatmap.GetHitObjectsCount();
+		});
+		if (!parsed || hitObjectCount == 0U) {
+			printf("%s could not be parsed.\n", name);
+			return FALSE;
+		}
+
+		printf("%-40s %10.2f ms %10.2f ms\n", name, times.m_best * 1000.0, times.m_median * 1000.0);
+		PrintResult("  per hit object", hitObjectCount, times);
+		return TRUE;
+	}
+}
+
+
+int main(int argc, char** argv) {
+	const BenchmarkOptions options = GetBenchmarkOptions(argc, argv);
+	const TestDirectory directory("BeatmapParseBenchmark");
+
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = options.m_quick ? 500U : 10000U;
+	const std::string mixed = MakeSyntheticBeatmap(synthetic);
+	synthetic.m_kind = BeatmapKind::Circles;
+	const std::string circles = MakeSyntheticBeatmap(synthetic);
+	synthetic.m_kind = BeatmapKind::StackedStreams;
+	const std::string stackedStreams = MakeSyntheticBeatmap(synthetic);
+
+	printf("%u hit objects per beatmap\n", synthetic.m_hitObjectCount);
+	PrintResultHeader("beatmaps");
+
+	bool parsed = MeasureParse("Mixed", directory.WriteFile("Mixed.osu", mixed), options.m_runCount);
+	parsed = parsed && MeasureParse("Mixed, hit objects first", directory.WriteFile("MixedHitObjectsFirst.osu", MoveHitObjectsFirst(mixed)), options.m_runCount);
+	parsed = parsed && MeasureParse("Circles", directory.WriteFile("Circles.osu", circles), options.m_runCount);
+	parsed = parsed && MeasureParse("StackedStreams", directory.WriteFile("StackedStreams.osu", stackedStreams), options.m_runCount);
+
+	// The mixed beatmap with the paths of its sliders in the slider path cache,
+	// and another difficulty with the same sliders.
+	SyntheticBeatmap otherDifficulty;
+	otherDifficulty.m_hitObjectCount = synthetic.m_hitObjectCount;
+	otherDifficulty.m_approachRate = 7.f;
+	const std::wstring mixedPath = directory.WriteFile("Mixed.osu", mixed);
+	const std::wstring otherDifficultyPath = directory.WriteFile("OtherDifficulty.osu", MakeSyntheticBeatmap(otherDifficulty));
+
+	SliderPathCache& sliderPathCache = SliderPathCache::GetInstance();
+	sliderPathCache.Clear();
+	Beatmap(mixedPath.c_str()).ParseBeatmap(FALSE);
+	const SliderPathCache::Statistics firstStatistics = sliderPathCache.GetStatistics();
+
+	printf("\nSlider path cache: %zu paths, %.2f MB\n", firstStatistics.pathCount, firstStatistics.memoryUsage / 1048576.0);
+	parsed = parsed && MeasureParse("Mixed again", mixedPath, options.m_runCount, TRUE);
+	parsed = parsed && MeasureParse("Other difficulty, same sliders", otherDifficultyPath, options.m_runCount, TRUE);
+
+	const SliderPathCache::Statistics statistics = sliderPathCache.GetStatistics();
+	const ULONGLONG hits = statistics.hits - firstStatistics.hits;
+	const ULONGLONG misses = statistics.misses - firstStatistics.misses;
+	printf("%llu hits, %llu misses after the first parse\n", hits, misses);
+
+	// A large beatmap parsed in chunks, with at most the thread count.
+	SyntheticBeatmap large;
+	large.m_hitObjectCount = options.m_quick ? 4096U : 50000U;
+	const std::wstring largePath = directory.WriteFile("Large.osu", MakeSyntheticBeatmap(large));
+
+	printf("\n%u hit objects, %u cores\n", large.m_hitObjectCount, std::thread::hardware_concurrency());
+	for (const UINT threadCount : { 1U, 2U, 4U, 8U }) {
+		char name[64];
+		snprintf(name, sizeof(name), "Mixed, %u threads", threadCount);
+
+		Beatmap::SetParseThreadCount(threadCount);
+		parsed = parsed && MeasureParse(name, largePath, options.m_quick ? 1U : 10U);
+	}
+	Beatmap::SetParseThreadCount(0U);
+
+	return parsed ? 0 : 1;
+}
\ No newline at end of file
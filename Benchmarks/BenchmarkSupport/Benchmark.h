@@ -0,0 +1,81 @@
+// Benchmark.h : Declares the timing functions of the headless benchmarks.
+// Every benchmark file is its own executable, run it with --quick for a short run (ctest does).
+
+#pragma once
+
+#include <Common/Pch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+namespace OsuBotBenchmarks
+{
+	// The settings of a benchmark run.
+	struct BenchmarkOptions {
+		// A short run, to check that the benchmark still works.
+		bool m_quick = FALSE;
+		// The number of timed runs, the best and median run are reported.
+		UINT m_runCount = 15U;
+	};
+
+	// Returns the settings from the command line.
+	inline BenchmarkOptions GetBenchmarkOptions(_In_ int argc, _In_ char** argv) {
+		BenchmarkOptions options;
+		for (int i = 1; i < argc; i++) {
+			if (strcmp(argv[i], "--quick") == 0) {
+				options.m_quick = TRUE;
+				options.m_runCount = 3U;
+			}
+		}
+		return options;
+	}
+
+	// The wall times of the runs of a benchmark, in seconds.
+	struct BenchmarkTimes {
+		double m_best;
+		double m_median;
+	};
+
+	// Runs the function the run count times, and returns the best and median wall time.
+	template<typename _Function>
+	inline BenchmarkTimes MeasureRuns(_In_ const UINT& runCount, _In_ _Function&& function) {
+		std::vector<double> times;
+		for (UINT run = 0U; run < (std::max)(runCount, 1U); run++) {
+			const auto startTime = std::chrono::steady_clock::now();
+			function();
+			const auto stopTime = std::chrono::steady_clock::now();
+			times.push_back(std::chrono::duration<double>(stopTime - startTime).count());
+		}
+
+		std::sort(times.begin(), times.end());
+		return { times.front(), times[times.size() / 2U] };
+	}
+
+	// Keeps the compiler from removing the calculation of the value.
+	template<typename _T>
+	inline void KeepValue(_In_ const _T& value) {
+#ifdef _MSC_VER
+		static volatile const void* keptValue;
+		keptValue = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r"(&value) : "memory");
+#endif
+	}
+
+	// Prints a result line: the name, the nanoseconds per item and the items per second (best and median run).
+	inline void PrintResult(_In_ const char* name, _In_ const double& itemCount, _In_ const BenchmarkTimes& times) {
+		printf("%-40s %10.2f ns %10.2f ns %10.2f M/s %10.2f M/s\n", name,
+			times.m_best * 1000000000.0 / itemCount, times.m_median * 1000000000.0 / itemCount,
+			itemCount / times.m_best / 1000000.0, itemCount / times.m_median / 1000000.0);
+	}
+
+	// Prints the header of the result lines.
+	inline void PrintResultHeader(_In_ const char* itemName) {
+		printf("%-40s %13s %13s %14s %14s\n", itemName, "best/item", "median/item", "best", "median");
+	}
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+// BezierBenchmark.cpp : Measures the points per second of the batch bezier evaluator,
+// one time per call (the scalar evaluator) and 4096 times per call (the SSE2 or AVX kernel),
+// against the Bernstein form with pow that the bot used before.
+
+#include <BenchmarkSupport/Benchmark.h>
+
+#include <TestSupport/ReferenceSliderPath.h>
+
+#include <Content/OsuBot/Bezier.h>
+
+#include <random>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotBenchmarks;
+using namespace OsuBotTests;
+
+
+int main(int argc, char** argv) {
+	const BenchmarkOptions options = GetBenchmarkOptions(argc, argv);
+	const UINT timeCount = 4096U;
+
+	std::vector<float> times(timeCount);
+	for (UINT i = 0U; i < timeCount; i++) {
+		times[i] = static_cast<float>(i) / static_cast<float>(timeCount - 1U);
+	}
+	std::vector<vec2f> points(timeCount);
+
+	std::mt19937 random(1U);
+	PrintResultHeader("points");
+
+	for (const UINT degree : { 2U, 3U, 5U, 8U, 12U, 16U, 20U }) {
+		std::vector<vec2f> curve(degree + 1U);
+		for (vec2f& point : curve) {
+			point = vec2f(static_cast<float>(random() % 513U), static_cast<float>(random() % 385U));
+		}
+		const UINT pointCount = (UINT)curve.size();
+		char name[64];
+
+		snprintf(name, sizeof(name), "degree %u, Bernstein form", degree);
+		PrintResult(name, timeCount, MeasureRuns(options.m_quick ? 1U : 5U, [&]() {
+			float sum = 0.f;
+			for (const float& time : times) {
+				sum += GetReferenceBezierPoint(curve.data(), pointCount, time).X;
+			}
+			KeepValue(sum);
+		}));
+
+		snprintf(name, sizeof(name), "degree %u, one time per call", degree);
+		PrintResult(name, timeCount, MeasureRuns(options.m_runCount, [&]() {
+			for (UINT i = 0U; i < timeCount; i++) {
+				GetPointsOnBezier(curve.data(), pointCount, &times[i], 1U, &points[i]);
+			}
+			KeepValue(points[timeCount / 2U]);
+		}));
+
+		snprintf(name, sizeof(name), "degree %u, batch", degree);
+		PrintResult(name, timeCount, MeasureRuns(options.m_runCount, [&]() {
+			GetPointsOnBezier(curve.data(), pointCount, times.data(), timeCount, points.data());
+			KeepValue(points[timeCount / 2U]);
+		}));
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+// HitObjectScanBenchmark.cpp : Measures FindHitObjectAtT, which scans the time and type arrays of the hit object table,
+// against the same scan over hit objects that are stored as one 88 byte struct each, the way they were stored before.
+
+#include <BenchmarkSupport/Benchmark.h>
+
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/Beatmap.h>
+
+#include <random>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotBenchmarks;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// A hit object with all its values in one struct, the scan only reads the first three.
+	struct HitObjectRecord {
+		int m_startTime;
+		int m_endTime;
+		UINT m_objectType;
+		BYTE m_otherValues[76];
+	};
+	static_assert(sizeof(HitObjectRecord) == 88U, "HitObjectRecord: the hit objects were 88 bytes");
+
+	// The scan of FindHitObjectAtT over the records.
+	UINT FindRecordAtT(_In_ const std::vector<HitObjectRecord>& records, _In_ const double& songTime) {
+		const UINT recordCount = (UINT)records.size();
+		for (UINT i = 0U; i < recordCount; i++) {
+			const HitObjectRecord& record = records[i];
+			if (record.m_startTime >= songTime && record.m_objectType == HITOBJECT_CIRCLE) {
+				return i;
+			}
+			else if (record.m_endTime > songTime) {
+				continue;
+			}
+
+			if (record.m_endTime <= songTime && record.m_objectType != HITOBJECT_CIRCLE) {
+				return i;
+			}
+			else if (i == recordCount - 1U) {
+				return i;
+			}
+		}
+		return recordCount;
+	}
+}
+
+
+int main(int argc, char** argv) {
+	const BenchmarkOptions options = GetBenchmarkOptions(argc, argv);
+	const TestDirectory directory("HitObjectScanBenchmark");
+
+	printf("The scan reads %zu bytes of every hit object in the table, and %zu bytes apart in the records\n",
+		sizeof(int) * 2U + sizeof(BYTE), sizeof(HitObjectRecord));
+	PrintResultHeader("visited hit objects");
+
+	const std::vector<UINT> hitObjectCounts = options.m_quick ? std::vector<UINT>{ 5000U } : std::vector<UINT>{ 5000U, 10000U, 200000U };
+	for (const UINT hitObjectCount : hitObjectCounts) {
+		SyntheticBeatmap synthetic;
+		synthetic.m_kind = BeatmapKind::Circles;
+		synthetic.m_hitObjectCount = hitObjectCount;
+		const std::wstring beatmapPath = directory.WriteFile("Circles.osu", MakeSyntheticBeatmap(synthetic));
+
+		Beatmap beatmap(beatmapPath.c_str());
+		if (!beatmap.ParseBeatmap(FALSE) || beatmap.GetHitObjectsCount() != hitObjectCount) {
+			printf("The beatmap could not be parsed.\n");
+			return 1;
+		}
+
+		std::vector<HitObjectRecord> records(hitObjectCount);
+		for (UINT i = 0U; i < hitObjectCount; i++) {
+			const HitObject hitObject = beatmap.GetHitObjectAtIndex(i);
+			records[i].m_startTime = hitObject.GetStartTime();
+			records[i].m_endTime = hitObject.GetEndTime();
+			records[i].m_objectType = hitObject.GetObjectType();
+		}
+
+		// Song times all over the beatmap, the scans visit half of the hit objects on average.
+		std::mt19937 random(1U);
+		const UINT callCount = options.m_quick ? 100U : 1000U;
+		std::vector<double> songTimes(callCount);
+		double visitedCount = 0.0;
+		for (double& songTime : songTimes) {
+			songTime = 1000.0 + random() % static_cast<UINT>(hitObjectCount * synthetic.m_circleInterval);
+			const UINT index = beatmap.FindHitObjectAtT(songTime);
+			if (index != FindRecordAtT(records, songTime)) {
+				printf("The scans found different hit objects at %.0f ms\n", songTime);
+				return 1;
+			}
+			visitedCount += (std::min)(index + 1U, hitObjectCount);
+		}
+
+		char name[64];
+		snprintf(name, sizeof(name), "%u circles, table", hitObjectCount);
+		PrintResult(name, visitedCount, MeasureRuns(options.m_runCount, [&]() {
+			UINT sum = 0U;
+			for (const double& songTime : songTimes) {
+				sum += beatmap.FindHitObjectAtT(songTime);
+			}
+			KeepValue(sum);
+		}));
+
+		snprintf(name, sizeof(name), "%u circles, records", hitObjectCount);
+		PrintResult(name, visitedCount, MeasureRuns(options.m_runCount, [&]() {
+			UINT sum = 0U;
+			for (const double& songTime : songTimes) {
+				sum += FindRecordAtT(records, songTime);
+			}
+			KeepValue(sum);
+		}));
+	}
+
+	return 0;
+}
\ No newline at end of file
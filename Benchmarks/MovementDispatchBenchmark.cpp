@@ -0,0 +1,150 @@
+// MovementDispatchBenchmark.cpp : Measures the movement of a tick with the strategy bound once in a variant,
+// against the dispatch the bot had before: a switch on the mode every tick and a call through a member function pointer.
+
+#include <BenchmarkSupport/Benchmark.h>
+
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/Beatmap.h>
+#include <Content/OsuBot/MovementModes.h>
+
+
+using namespace OsuBot;
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotBenchmarks;
+using namespace OsuBotTests;
+
+
+#ifdef _MSC_VER
+#define DISPATCH_NOINLINE __declspec(noinline)
+#else
+#define DISPATCH_NOINLINE __attribute__((noinline))
+#endif
+
+
+namespace
+{
+	// The dispatch before the strategies: the mode is switched on every tick, the move function of the mode
+	// is passed to MoveToObject as a member function pointer, which was in another translation unit.
+	class PointerDispatch {
+	public:
+		explicit PointerDispatch(_In_ const BYTE& movementMode) : m_movementMode(movementMode) {}
+
+		vec2f Tick(_In_ const MovementSegment& segment, _In_ const double& songTime) {
+			switch (m_movementMode) {
+			case MODE_STANDARD:
+				return MoveToObject(segment, songTime, &PointerDispatch::MovementStandard);
+			case MODE_FLOWING:
+				return MoveToObject(segment, songTime, &PointerDispatch::MovementFlowing);
+			case MODE_PREDICTING:
+				return MoveToObject(segment, songTime, &PointerDispatch::MovementPredicting);
+			default:
+				return vec2f();
+			}
+		}
+
+	private:
+		DISPATCH_NOINLINE vec2f MoveToObject(_In_ const MovementSegment& segment, _In_ const double& songTime,
+			_In_ vec2f(PointerDispatch::* movement)(const MovementSegment&, const double&)) {
+			return (this->*movement)(segment, songTime);
+		}
+
+		vec2f MovementStandard(_In_ const MovementSegment& segment, _In_ const double& songTime) { return segment.GetPoint(songTime); }
+		vec2f MovementFlowing(_In_ const MovementSegment& segment, _In_ const double& songTime) { return segment.GetPoint(songTime); }
+		vec2f MovementPredicting(_In_ const MovementSegment& segment, _In_ const double& songTime) { return segment.GetPoint(songTime); }
+
+		BYTE m_movementMode;
+	};
+
+	// The dispatch of the bot: the strategy is bound once, the visit calls the inlined move of the strategy.
+	class VariantDispatch {
+	public:
+		explicit VariantDispatch(_In_ const BYTE& movementMode) : m_strategy(GetMovementStrategy(movementMode)) {}
+
+		vec2f Tick(_In_ const MovementSegment& segment, _In_ const double& songTime) const {
+			return std::visit([&](const auto& strategy) { return MoveToObject(segment, songTime, strategy); }, m_strategy);
+		}
+
+	private:
+		template <typename Strategy>
+		static vec2f MoveToObject(_In_ const MovementSegment& segment, _In_ const double& songTime, _In_ const Strategy& strategy) {
+			UNREFERENCED_PARAMETER(strategy);
+			return segment.GetPoint(songTime);
+		}
+		static vec2f MoveToObject(_In_ const MovementSegment& segment, _In_ const double& songTime, _In_ const MovementNone& strategy) {
+			UNREFERENCED_PARAMETER(segment); UNREFERENCED_PARAMETER(songTime); UNREFERENCED_PARAMETER(strategy);
+			return vec2f();
+		}
+
+		MovementStrategy m_strategy;
+	};
+
+	// Plays the plan at 1000 ticks per second, the segment of the tick is found like the bot finds its hit object.
+	template <typename Dispatch>
+	vec2f PlayPlan(_In_ const MovementPlan& plan, _In_ Dispatch& dispatch, _In_ const UINT& tickCount) {
+		vec2f sum;
+		UINT index = 0U;
+		for (UINT tick = 0U; tick < tickCount; tick++) {
+			const double songTime = static_cast<double>(tick);
+			while (index + 1U < plan.GetCount() && plan.GetSegment(index).m_endTime < songTime) {
+				index++;
+			}
+			sum = sum + dispatch.Tick(plan.GetSegment(index), songTime);
+		}
+		return sum;
+	}
+}
+
+
+int main(int argc, char** argv) {
+	const BenchmarkOptions options = GetBenchmarkOptions(argc, argv);
+	const TestDirectory directory("MovementDispatchBenchmark");
+
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = options.m_quick ? 500U : 3000U;
+	const std::wstring beatmapPath = directory.WriteFile("Mixed.osu", MakeSyntheticBeatmap(synthetic));
+	Beatmap beatmap(beatmapPath.c_str());
+	if (!beatmap.ParseBeatmap(FALSE)) {
+		printf("The beatmap could not be parsed.\n");
+		return 1;
+	}
+
+	// Predicting eases the time of long moves, standard moves are linear.
+	const struct {
+		const char* m_name;
+		BYTE m_movementMode;
+	} movementModes[] = {
+		{ "Eased segments", (BYTE)MODE_PREDICTING },
+		{ "Linear segments", (BYTE)MODE_STANDARD },
+	};
+
+	PrintResultHeader("ticks");
+	for (const auto& movementMode : movementModes) {
+		MovementModes movement;
+		movement.SetMovementModes(movementMode.m_movementMode, MODE_STANDARD, MODE_STANDARD);
+		const MovementPlan plan = movement.CompileMovementPlan(beatmap, 1.f);
+		const UINT tickCount = static_cast<UINT>(plan.GetSegment(plan.GetCount() - 1U).m_endTime);
+
+		PointerDispatch pointerDispatch(movementMode.m_movementMode);
+		VariantDispatch variantDispatch(movementMode.m_movementMode);
+		const vec2f pointerSum = PlayPlan(plan, pointerDispatch, tickCount);
+		const vec2f variantSum = PlayPlan(plan, variantDispatch, tickCount);
+		if (pointerSum.X != variantSum.X || pointerSum.Y != variantSum.Y) {
+			printf("%s: the dispatches moved the cursor to different points\n", movementMode.m_name);
+			return 1;
+		}
+
+		char name[64];
+		snprintf(name, sizeof(name), "%s, switch + pointer", movementMode.m_name);
+		PrintResult(name, tickCount, MeasureRuns(options.m_runCount, [&]() {
+			KeepValue(PlayPlan(plan, pointerDispatch, tickCount));
+		}));
+
+		snprintf(name, sizeof(name), "%s, bound variant", movementMode.m_name);
+		PrintResult(name, tickCount, MeasureRuns(options.m_runCount, [&]() {
+			KeepValue(PlayPlan(plan, variantDispatch, tickCount));
+		}));
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+// ParseNumberBenchmark.cpp : Measures the numbers per second of ParseNumber against std::stof and std::stoi,
+// on the number fields of hit object and timing point lines.
+
+#include <BenchmarkSupport/Benchmark.h>
+
+#include <Common/ParseNumber.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+
+using namespace OsuBotBenchmarks;
+
+
+namespace
+{
+	// Returns number fields the way beatmaps write them.
+	std::vector<std::string> MakeNumbers(_In_ const UINT& count, _In_ const bool& decimals) {
+		std::mt19937 random(1U);
+		std::vector<std::string> numbers;
+		numbers.reserve(count);
+
+		for (UINT i = 0U; i < count; i++) {
+			char str[32];
+			if (decimals) {
+				// Beat lenghts, slider velocities and pixel lenghts.
+				switch (random() % 3U) {
+				case 0U:
+					snprintf(str, sizeof(str), "%.12f", 200.0 + (random() % 300000U) / 1000.0);
+					break;
+				case 1U:
+					snprintf(str, sizeof(str), "-%u", 25U + random() % 200U);
+					break;
+				default:
+					snprintf(str, sizeof(str), "%u.%u", random() % 400U, random() % 10U);
+					break;
+				}
+			}
+			else {
+				// Positions and times.
+				snprintf(str, sizeof(str), "%u", (random() % 2U) ? random() % 513U : random() % 600000U);
+			}
+			numbers.push_back(str);
+		}
+
+		return numbers;
+	}
+}
+
+
+int main(int argc, char** argv) {
+	const BenchmarkOptions options = GetBenchmarkOptions(argc, argv);
+	const UINT numberCount = options.m_quick ? 20000U : 1000000U;
+
+	const std::vector<std::string> integers = MakeNumbers(numberCount, FALSE);
+	const std::vector<std::string> decimals = MakeNumbers(numberCount, TRUE);
+
+	// Check that both parse the same numbers before timing them.
+	for (UINT i = 0U; i < numberCount; i++) {
+		int integer = 0;
+		float decimal = 0.f;
+		if (ParseNumber(std::string_view(integers[i]), integer) != ParseError::None || integer != std::stoi(integers[i]) ||
+			ParseNumber(std::string_view(decimals[i]), decimal) != ParseError::None || decimal != std::stof(decimals[i])) {
+			printf("ParseNumber and the standard library differ at %s, %s\n", integers[i].c_str(), decimals[i].c_str());
+			return 1;
+		}
+	}
+
+	PrintResultHeader("numbers");
+
+	PrintResult("std::stoi", numberCount, MeasureRuns(options.m_runCount, [&]() {
+		int sum = 0;
+		for (const std::string& number : integers) {
+			sum += std::stoi(number);
+		}
+		KeepValue(sum);
+	}));
+	PrintResult("ParseNumber int", numberCount, MeasureRuns(options.m_runCount, [&]() {
+		int sum = 0;
+		for (const std::string& number : integers) {
+			int value = 0;
+			ParseNumber(std::string_view(number), value);
+			sum += value;
+		}
+		KeepValue(sum);
+	}));
+
+	PrintResult("std::stof", numberCount, MeasureRuns(options.m_runCount, [&]() {
+		float sum = 0.f;
+		for (const std::string& number : decimals) {
+			sum += std::stof(number);
+		}
+		KeepValue(sum);
+	}));
+	PrintResult("ParseNumber float", numberCount, MeasureRuns(options.m_runCount, [&]() {
+		float sum = 0.f;
+		for (const std::string& number : decimals) {
+			float value = 0.f;
+			ParseNumber(std::string_view(number), value);
+			sum += value;
+		}
+		KeepValue(sum);
+	}));
+
+	return 0;
+}
\ No newline at end of file
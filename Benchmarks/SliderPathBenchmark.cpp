@@ -0,0 +1,140 @@
+// SliderPathBenchmark.cpp : Measures the latency of a point on a slider, on the flattened slider paths
+// and on the evaluator the bot used before, which walked the curve samples from the start on every call.
+// And the time and points to flatten the sliders, against the 50 samples per control point of that evaluator.
+
+#include <BenchmarkSupport/Benchmark.h>
+
+#include <TestSupport/ReferenceSliderPath.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/Beatmap.h>
+#include <Content/OsuBot/SliderPathCache.h>
+
+#include <sstream>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotBenchmarks;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// Returns the beatmap with only its linear and bezier sliders, the sliders the old evaluator could sample.
+	std::string KeepLinearAndBezierSliders(_In_ const std::string& content) {
+		const size_t hitObjects = content.find("[HitObjects]");
+		std::istringstream lines(content.substr(hitObjects));
+		std::string result = content.substr(0U, hitObjects);
+
+		std::string line;
+		while (std::getline(lines, line)) {
+			if (!line.empty() && (line.front() == '[' || line.find(",L|") != std::string::npos || line.find(",B|") != std::string::npos)) {
+				result += line + "\n";
+			}
+		}
+		return result;
+	}
+}
+
+
+int main(int argc, char** argv) {
+	const BenchmarkOptions options = GetBenchmarkOptions(argc, argv);
+	const TestDirectory directory("SliderPathBenchmark");
+
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = options.m_quick ? 200U : 5000U;
+	const std::string content = MakeSyntheticBeatmap(synthetic);
+	const std::wstring beatmapPath = directory.WriteFile("Mixed.osu", content);
+
+	Beatmap beatmap(beatmapPath.c_str());
+	if (!beatmap.ParseBeatmap(FALSE)) {
+		printf("The beatmap could not be parsed.\n");
+		return 1;
+	}
+
+	// The linear and bezier sliders, the old evaluator had no arcs or splines.
+	const std::vector<ReferenceSlider> sliders = ReadReferenceSliders(content);
+	std::vector<SliderPath> paths;
+	std::vector<ReferenceSliderPath> referencePaths;
+	for (UINT i = 0U; i < beatmap.GetHitObjectsCount() && i < sliders.size(); i++) {
+		if (sliders[i].m_sliderType == 'L' || sliders[i].m_sliderType == 'B') {
+			paths.push_back(beatmap.GetHitObjectAtIndex(i).GetSliderPath());
+			referencePaths.emplace_back(sliders[i]);
+		}
+	}
+
+	// The times of the ticks on a slider, 200 calls per slider.
+	const UINT callCount = 200U;
+	std::vector<double> times(callCount);
+	for (UINT j = 0U; j < callCount; j++) {
+		times[j] = j / static_cast<double>(callCount - 1U);
+	}
+	const double pointCount = static_cast<double>(paths.size()) * callCount;
+
+	printf("%zu sliders, %u calls per slider\n", paths.size(), callCount);
+	PrintResultHeader("points");
+
+	PrintResult("old evaluator", pointCount, MeasureRuns(options.m_quick ? 1U : 5U, [&]() {
+		float sum = 0.f;
+		for (const ReferenceSliderPath& path : referencePaths) {
+			for (const double& time : times) {
+				sum += path.GetPointByTOld(time).X;
+			}
+		}
+		KeepValue(sum);
+	}));
+
+	PrintResult("SliderPath::GetPointByT", pointCount, MeasureRuns(options.m_runCount, [&]() {
+		float sum = 0.f;
+		for (const SliderPath& path : paths) {
+			for (const double& time : times) {
+				sum += path.GetPointByT(time).X;
+			}
+		}
+		KeepValue(sum);
+	}));
+
+	std::vector<vec2f> points(callCount);
+	PrintResult("SliderPath::GetPointsByT", pointCount, MeasureRuns(options.m_runCount, [&]() {
+		float sum = 0.f;
+		for (const SliderPath& path : paths) {
+			path.GetPointsByT(times.data(), callCount, points.data());
+			sum += points[callCount / 2U].X;
+		}
+		KeepValue(sum);
+	}));
+
+	// Flatten the sliders of the beatmap, the beatmap is parsed without the slider path cache.
+	const std::string sliderContent = KeepLinearAndBezierSliders(content);
+	const std::wstring sliderBeatmapPath = directory.WriteFile("Sliders.osu", sliderContent);
+	const std::vector<ReferenceSlider> referenceSliders = ReadReferenceSliders(sliderContent);
+
+	UINT sliderCount = 0U;
+	size_t pathPointCount = 0U;
+	const BenchmarkTimes flattenTimes = MeasureRuns(options.m_quick ? 1U : 10U, [&]() {
+		SliderPathCache::GetInstance().Clear();
+
+		Beatmap sliderBeatmap(sliderBeatmapPath.c_str());
+		sliderBeatmap.ParseBeatmap(FALSE);
+		sliderCount = sliderBeatmap.GetHitObjectsCount();
+		pathPointCount = 0U;
+		for (UINT i = 0U; i < sliderCount; i++) {
+			pathPointCount += sliderBeatmap.GetHitObjectAtIndex(i).GetSliderPath().GetPointCount();
+		}
+	});
+
+	size_t sampleCount = 0U;
+	const BenchmarkTimes sampleTimes = MeasureRuns(options.m_quick ? 1U : 10U, [&]() {
+		sampleCount = 0U;
+		for (const ReferenceSlider& slider : referenceSliders) {
+			sampleCount += ReferenceSliderPath(slider).GetSampleCount();
+		}
+	});
+
+	printf("\n%u linear and bezier sliders: %zu sampled points, %zu flattened path points\n", sliderCount, sampleCount, pathPointCount);
+	PrintResultHeader("sliders");
+	PrintResult("old sampling", sliderCount, sampleTimes);
+	PrintResult("parse and flatten", sliderCount, flattenTimes);
+
+	return 0;
+}
\ No newline at end of file
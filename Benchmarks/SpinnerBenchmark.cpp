@@ -0,0 +1,96 @@
+// SpinnerBenchmark.cpp : Measures the points of the spinner follower, taken from a rotation table,
+// against the points from cosf and sinf of the angle at every tick, the way the spinner was spun before.
+
+#include <BenchmarkSupport/Benchmark.h>
+
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/SpinnerFollower.h>
+
+#include <cmath>
+#include <random>
+
+
+using namespace OsuBot;
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotBenchmarks;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// The spinner movement before the rotation table: the angle at the song time, and its cosine and sine.
+	vec2f GetSinCosPoint(_In_ const HitObject& spinner, _In_ const vec2f& center, _In_ const float& radius, _In_ const float& rpm, _In_ const double& songTime) {
+		const double rotations = (std::max)(songTime - spinner.GetStartTime(), 0.0) * rpm / 60000.0;
+		const float angle = static_cast<float>((rotations - floor(rotations)) * -2.0 * M_PI);
+
+		vec2f point = vec2f(cosf(angle) * radius, sinf(angle) * radius);
+		point.Add(center);
+		return point;
+	}
+}
+
+
+int main(int argc, char** argv) {
+	const BenchmarkOptions options = GetBenchmarkOptions(argc, argv);
+	const TestDirectory directory("SpinnerBenchmark");
+
+	// A spinner of 3319 milliseconds.
+	const std::wstring beatmapPath = directory.WriteFile("Spinner.osu",
+		"osu file format v14\r\n\r\n[TimingPoints]\r\n0,400,4,2,0,60,1,0\r\n\r\n[HitObjects]\r\n"
+		"256,192,1000,12,0,4319,0:0:0:0:\r\n");
+	Beatmap beatmap(beatmapPath.c_str());
+	if (!beatmap.ParseBeatmap(FALSE) || beatmap.GetHitObjectsCount() != 1U) {
+		printf("The beatmap could not be parsed.\n");
+		return 1;
+	}
+	const HitObject spinner = beatmap.GetHitObjectAtIndex(0U);
+	const vec2f center(400.f, 300.f);
+	const float radius = 50.f;
+	const float rpm = 477.f;
+
+	SpinnerFollower follower;
+	follower.Follow(spinner, center, radius, rpm);
+
+	// The ticks of the spinner, 0.5 to 3 milliseconds apart.
+	std::mt19937 random(25U);
+	std::vector<double> songTimes;
+	for (double songTime = spinner.GetStartTime(); songTime <= spinner.GetEndTime(); songTime += 0.5 + (random() % 2500U) / 1000.0) {
+		songTimes.push_back(songTime);
+	}
+
+	double largestDistance = 0.0;
+	for (const double& songTime : songTimes) {
+		const vec2f point = follower.GetPointAtTime(songTime);
+		const vec2f sinCosPoint = GetSinCosPoint(spinner, center, radius, rpm, songTime);
+		largestDistance = (std::max)(largestDistance, static_cast<double>((point - sinCosPoint).Length()));
+	}
+	printf("%zu ticks, the points of the table are at most %.4f pixels from the points of cosf and sinf\n", songTimes.size(), largestDistance);
+
+	// The ticks of the spinner are played a number of times in every run.
+	const UINT spinCount = options.m_quick ? 10U : 200U;
+	const double tickCount = static_cast<double>(songTimes.size()) * spinCount;
+
+	PrintResultHeader("ticks");
+	PrintResult("Rotation table", tickCount, MeasureRuns(options.m_runCount, [&]() {
+		vec2f sum;
+		for (UINT spin = 0U; spin < spinCount; spin++) {
+			for (const double& songTime : songTimes) {
+				sum = sum + follower.GetPointAtTime(songTime);
+			}
+		}
+		KeepValue(sum);
+	}));
+
+	PrintResult("cosf and sinf", tickCount, MeasureRuns(options.m_runCount, [&]() {
+		vec2f sum;
+		for (UINT spin = 0U; spin < spinCount; spin++) {
+			for (const double& songTime : songTimes) {
+				sum = sum + GetSinCosPoint(spinner, center, radius, rpm, songTime);
+			}
+		}
+		KeepValue(sum);
+	}));
+
+	return 0;
+}
\ No newline at end of file
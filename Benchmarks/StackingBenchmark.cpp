@@ -0,0 +1,89 @@
+// StackingBenchmark.cpp : Measures the stacking of the hit objects, which finds the hit objects at the same position
+// in a grid, against the stacking scan of osu!, which compares every hit object in the time window.
+
+#include <BenchmarkSupport/Benchmark.h>
+
+#include <TestSupport/ReferenceStacking.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/Beatmap.h>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotBenchmarks;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// A synthetic beatmap to stack, with its name in the results.
+	struct StackingCase {
+		const char* m_name;
+		SyntheticBeatmap m_synthetic;
+	};
+
+	StackingCase MakeStackingCase(_In_ const char* name, _In_ const BeatmapKind& kind, _In_ const UINT& hitObjectCount,
+		_In_ const float& approachRate, _In_ const int& circleInterval) {
+		StackingCase stackingCase = { name, SyntheticBeatmap() };
+		stackingCase.m_synthetic.m_kind = kind;
+		stackingCase.m_synthetic.m_hitObjectCount = hitObjectCount;
+		stackingCase.m_synthetic.m_approachRate = approachRate;
+		stackingCase.m_synthetic.m_circleInterval = circleInterval;
+		return stackingCase;
+	}
+}
+
+
+int main(int argc, char** argv) {
+	const BenchmarkOptions options = GetBenchmarkOptions(argc, argv);
+	const TestDirectory directory("StackingBenchmark");
+	const UINT hitObjectCount = options.m_quick ? 2000U : 10000U;
+
+	// The time window is 315 milliseconds at approach rate 9 and 1260 milliseconds at approach rate 0.
+	const StackingCase stackingCases[] = {
+		MakeStackingCase("Random circles, AR 9", BeatmapKind::Circles, hitObjectCount, 9.f, 40),
+		MakeStackingCase("5 ms random circles, AR 0", BeatmapKind::Circles, hitObjectCount, 0.f, 5),
+		MakeStackingCase("Mixed, AR 9", BeatmapKind::Mixed, hitObjectCount, 9.f, 40),
+		MakeStackingCase("Stacked streams, AR 9", BeatmapKind::StackedStreams, hitObjectCount, 9.f, 40),
+		MakeStackingCase("Stacked streams, AR 0", BeatmapKind::StackedStreams, hitObjectCount, 0.f, 40),
+		MakeStackingCase("5 ms streams, AR 0", BeatmapKind::StackedStreams, hitObjectCount, 0.f, 5),
+	};
+
+	PrintResultHeader("hit objects");
+	for (const StackingCase& stackingCase : stackingCases) {
+		const std::wstring beatmapPath = directory.WriteFile("Stacking.osu", MakeSyntheticBeatmap(stackingCase.m_synthetic));
+		Beatmap beatmap(beatmapPath.c_str());
+		if (!beatmap.ParseBeatmap(FALSE) || beatmap.GetHitObjectsCount() != hitObjectCount) {
+			printf("The beatmap could not be parsed.\n");
+			return 1;
+		}
+
+		// The synthetic beatmaps have a stack leniency of 0.7.
+		ReferenceStacking reference(beatmap, stackingCase.m_synthetic.m_approachRate, 0.7f);
+		const std::vector<int>& stackIndices = reference.CalculateStacking();
+		UINT stackedCount = 0U;
+		for (UINT i = 0U; i < hitObjectCount; i++) {
+			if (beatmap.GetHitObjectAtIndex(i).GetStackIndex() != stackIndices[i]) {
+				printf("%s: the stack index of hit object %u is not the one of osu!\n", stackingCase.m_name, i);
+				return 1;
+			}
+			stackedCount += (stackIndices[i] != 0) ? 1U : 0U;
+		}
+
+		char name[64];
+		snprintf(name, sizeof(name), "%s, grid", stackingCase.m_name);
+		PrintResult(name, hitObjectCount, MeasureRuns(options.m_runCount, [&]() {
+			beatmap.CalculateStacking();
+			KeepValue(beatmap.GetHitObjectAtIndex(0U).GetStackIndex());
+		}));
+
+		snprintf(name, sizeof(name), "%s, osu! scan", stackingCase.m_name);
+		PrintResult(name, hitObjectCount, MeasureRuns(options.m_runCount, [&]() {
+			KeepValue(reference.CalculateStacking()[0]);
+		}));
+
+		printf("%s: %u of %u hit objects are stacked\n", stackingCase.m_name, stackedCount, hitObjectCount);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <Common/Pch.h>
+#include <Common/ParseNumber.h>
 
 
 namespace ConfigurationIni
@@ -132,7 +133,10 @@ namespace ConfigurationIni
 						}
 
 
-						if (readLine.at(valuePos) == L'-') {
+						// Keep the position of the sign so negative values are parsed as such.
+						const UINT numberPos = valuePos;
+
+						if (readLine.at(valuePos) == L'-' && valuePos + 1U < (UINT)readLine.size()) {
 							// Value is negative.
 							valuePos += 1U;
 						}
@@ -140,13 +144,28 @@ namespace ConfigurationIni
 						// Set the value.
 						if (numbers.find(readLine.at(valuePos)) != std::wstring::npos) {
 							// The character at valuePos is a number.
+							const wchar_t* first = readLine.data() + numberPos;
+							const wchar_t* last = readLine.data() + readLine.size();
+
 							if (readLine.find(L'.') != std::wstring::npos) {
 								// Value is has a decimal.
-								*reinterpret_cast<DOUBLE*>(lpResultValue) = std::stod(readLine.substr(valuePos));
+								DOUBLE value;
+								if (ParseNumber(first, last, value).error != ParseError::None) {
+									// Value is out of range, return FALSE.
+									delete lpReadLine;
+									return FALSE;
+								}
+								*reinterpret_cast<DOUBLE*>(lpResultValue) = value;
 							}
 							else {
 								// Value is of type UINT.
-								*reinterpret_cast<UINT*>(lpResultValue) = std::stoi(readLine.substr(valuePos));
+								int value;
+								if (ParseNumber(first, last, value).error != ParseError::None) {
+									// Value is out of range, return FALSE.
+									delete lpReadLine;
+									return FALSE;
+								}
+								*reinterpret_cast<UINT*>(lpResultValue) = (UINT)value;
 							}
 						}
 						else {
@@ -0,0 +1,81 @@
+// MappedFile.h : Defines a class that maps a file read-only into memory,
+// so the content can be read in place without copying it into buffers.
+
+#pragma once
+
+#include <string_view>
+
+
+class MappedFile {
+public:
+	// Constructor and destructor.
+	explicit MappedFile(_In_ const std::wstring& path) :
+		m_file(INVALID_HANDLE_VALUE),
+		m_mapping(NULL),
+		m_view(nullptr),
+		m_size(0U)
+	{
+		// Open the file for reading, other processes (the game) can keep using it.
+		m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (m_file == INVALID_HANDLE_VALUE) {
+			return;
+		}
+
+		// Empty files can't be mapped.
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart <= 0) {
+			return;
+		}
+
+		// Map the whole file into memory.
+		m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0UL, 0UL, nullptr);
+		if (m_mapping == NULL) {
+			return;
+		}
+
+		m_view = MapViewOfFile(m_mapping, FILE_MAP_READ, 0UL, 0UL, 0U);
+		if (m_view != nullptr) {
+			m_size = static_cast<size_t>(fileSize.QuadPart);
+		}
+	}
+	~MappedFile() {
+		Close();
+	}
+
+	// The mapping is owned by a single object.
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator= (const MappedFile&) = delete;
+
+
+	// Member functions.
+	void Close() {
+		if (m_view != nullptr) {
+			UnmapViewOfFile(m_view);
+			m_view = nullptr;
+		}
+		if (m_mapping != NULL) {
+			CloseHandle(m_mapping);
+			m_mapping = NULL;
+		}
+		if (m_file != INVALID_HANDLE_VALUE) {
+			CloseHandle(m_file);
+			m_file = INVALID_HANDLE_VALUE;
+		}
+		m_size = 0U;
+	}
+
+	// Accessor functions.
+	bool				IsOpen() const				{ return m_view != nullptr; }
+	HANDLE				GetFileHandle() const		{ return m_file; }
+	const char*			GetData() const				{ return static_cast<const char*>(m_view); }
+	size_t				GetSize() const				{ return m_size; }
+	std::string_view	GetView() const				{ return std::string_view(GetData(), m_size); }
+
+
+private:
+	// Member variables.
+	HANDLE m_file;
+	HANDLE m_mapping;
+	LPVOID m_view;
+	size_t m_size;
+};
\ No newline at end of file
@@ -0,0 +1,237 @@
+// ParseNumber.h : Defines functions that parse numbers from a character range
+// without exceptions, similar to std::from_chars. Works on char and wchar_t.
+
+#pragma once
+
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <string_view>
+
+
+// The error codes of a parse.
+enum class ParseError {
+	None,				// The number was parsed.
+	InvalidArgument,	// The range doesn't start with a number.
+	OutOfRange			// The number doesn't fit the type, the value is not changed.
+};
+
+// The result of a parse.
+// ptr points to the first character after the number.
+template<typename _Char>
+struct ParseResult {
+	const _Char* ptr;
+	ParseError error;
+};
+
+
+namespace ParseNumberInternal
+{
+	// Powers of 10 that are exact as a double.
+	constexpr double exactPowersOf10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	template<typename _Char>
+	inline bool IsDigit(_Char c) {
+		return c >= _Char('0') && c <= _Char('9');
+	}
+
+	// Skips the spaces and tabs in front of the number (std::stof does this too).
+	template<typename _Char>
+	inline const _Char* SkipSpaces(const _Char* first, const _Char* last) {
+		while (first != last && (*first == _Char(' ') || *first == _Char('\t'))) {
+			++first;
+		}
+		return first;
+	}
+
+	// Parses an integer into a 64 bit value with its sign.
+	// Fails with OutOfRange when the magnitude doesn't fit 64 bits.
+	template<typename _Char>
+	inline ParseResult<_Char> ParseInteger(const _Char* first, const _Char* last, bool& negative, unsigned long long& magnitude) {
+		const _Char* current = SkipSpaces(first, last);
+
+		negative = FALSE;
+		if (current != last && (*current == _Char('-') || *current == _Char('+'))) {
+			negative = *current == _Char('-');
+			++current;
+		}
+
+		if (current == last || !IsDigit(*current)) {
+			// No digits.
+			return { first, ParseError::InvalidArgument };
+		}
+
+		bool overflow = FALSE;
+		magnitude = 0ULL;
+		for (; current != last && IsDigit(*current); ++current) {
+			unsigned long long digit = static_cast<unsigned long long>(*current - _Char('0'));
+			if (magnitude > (ULLONG_MAX - digit) / 10ULL) {
+				overflow = TRUE;
+			}
+			magnitude = magnitude * 10ULL + digit;
+		}
+
+		return { current, overflow ? ParseError::OutOfRange : ParseError::None };
+	}
+
+	// Parses a decimal number with an optional fraction and exponent into a double.
+	template<typename _Char>
+	inline ParseResult<_Char> ParseDecimal(const _Char* first, const _Char* last, double& value) {
+		const _Char* current = SkipSpaces(first, last);
+
+		bool negative = FALSE;
+		if (current != last && (*current == _Char('-') || *current == _Char('+'))) {
+			negative = *current == _Char('-');
+			++current;
+		}
+
+		// Read up to 19 significant digits, the digits after that only move the exponent.
+		unsigned long long mantissa = 0ULL;
+		int significantDigits = 0;
+		int exponent = 0;
+		bool digitsFound = FALSE;
+
+		for (; current != last && IsDigit(*current); ++current) {
+			digitsFound = TRUE;
+			if (significantDigits < 19) {
+				mantissa = mantissa * 10ULL + static_cast<unsigned long long>(*current - _Char('0'));
+				significantDigits += mantissa > 0ULL ? 1 : 0;
+			}
+			else {
+				exponent++;
+			}
+		}
+
+		if (current != last && *current == _Char('.')) {
+			for (++current; current != last && IsDigit(*current); ++current) {
+				digitsFound = TRUE;
+				if (significantDigits < 19) {
+					mantissa = mantissa * 10ULL + static_cast<unsigned long long>(*current - _Char('0'));
+					significantDigits += mantissa > 0ULL ? 1 : 0;
+					exponent--;
+				}
+			}
+		}
+
+		if (!digitsFound) {
+			// No digits.
+			return { first, ParseError::InvalidArgument };
+		}
+
+		// Read the exponent, only if it has digits.
+		if (current != last && (*current == _Char('e') || *current == _Char('E'))) {
+			const _Char* exponentStart = current + 1;
+			bool exponentNegative = FALSE;
+			if (exponentStart != last && (*exponentStart == _Char('-') || *exponentStart == _Char('+'))) {
+				exponentNegative = *exponentStart == _Char('-');
+				++exponentStart;
+			}
+
+			if (exponentStart != last && IsDigit(*exponentStart)) {
+				int exponentValue = 0;
+				for (current = exponentStart; current != last && IsDigit(*current); ++current) {
+					if (exponentValue < 100000) {
+						exponentValue = exponentValue * 10 + static_cast<int>(*current - _Char('0'));
+					}
+				}
+				exponent += exponentNegative ? -exponentValue : exponentValue;
+			}
+		}
+
+		// Scale the mantissa, exact for the common short decimals.
+		double result = static_cast<double>(mantissa);
+		if (mantissa == 0ULL) {
+			result = 0.0;
+		}
+		else if (exponent >= 0 && exponent <= 22) {
+			result *= exactPowersOf10[exponent];
+		}
+		else if (exponent < 0 && exponent >= -22) {
+			result /= exactPowersOf10[-exponent];
+		}
+		else {
+			result *= pow(10.0, static_cast<double>(exponent));
+		}
+
+		if (result > DBL_MAX || (result == 0.0 && mantissa != 0ULL)) {
+			// Overflow to infinity or underflow to zero.
+			return { current, ParseError::OutOfRange };
+		}
+
+		value = negative ? -result : result;
+		return { current, ParseError::None };
+	}
+}
+
+
+// Parses a signed integer.
+template<typename _Char>
+inline ParseResult<_Char> ParseNumber(const _Char* first, const _Char* last, int& value) {
+	bool negative;
+	unsigned long long magnitude;
+	ParseResult<_Char> result = ParseNumberInternal::ParseInteger(first, last, negative, magnitude);
+
+	if (result.error == ParseError::None) {
+		if (magnitude > (negative ? static_cast<unsigned long long>(INT_MAX) + 1ULL : static_cast<unsigned long long>(INT_MAX))) {
+			result.error = ParseError::OutOfRange;
+		}
+		else {
+			value = negative ? static_cast<int>(0ULL - magnitude) : static_cast<int>(magnitude);
+		}
+	}
+
+	return result;
+}
+
+// Parses an unsigned integer, negative numbers are out of range.
+template<typename _Char>
+inline ParseResult<_Char> ParseNumber(const _Char* first, const _Char* last, UINT& value) {
+	bool negative;
+	unsigned long long magnitude;
+	ParseResult<_Char> result = ParseNumberInternal::ParseInteger(first, last, negative, magnitude);
+
+	if (result.error == ParseError::None) {
+		if ((negative && magnitude != 0ULL) || magnitude > static_cast<unsigned long long>(UINT_MAX)) {
+			result.error = ParseError::OutOfRange;
+		}
+		else {
+			value = static_cast<UINT>(magnitude);
+		}
+	}
+
+	return result;
+}
+
+// Parses a double.
+template<typename _Char>
+inline ParseResult<_Char> ParseNumber(const _Char* first, const _Char* last, double& value) {
+	return ParseNumberInternal::ParseDecimal(first, last, value);
+}
+
+// Parses a float, values outside of the float range are out of range.
+template<typename _Char>
+inline ParseResult<_Char> ParseNumber(const _Char* first, const _Char* last, float& value) {
+	double result = 0.0;
+	ParseResult<_Char> parseResult = ParseNumberInternal::ParseDecimal(first, last, result);
+
+	if (parseResult.error == ParseError::None) {
+		if (fabs(result) > static_cast<double>(FLT_MAX) || (result != 0.0 && static_cast<float>(result) == 0.f)) {
+			parseResult.error = ParseError::OutOfRange;
+		}
+		else {
+			value = static_cast<float>(result);
+		}
+	}
+
+	return parseResult;
+}
+
+// Parses a number from the start of a string view.
+// Characters after the number are ignored (like std::stoi and std::stof).
+template<typename _Char, typename _T>
+inline ParseError ParseNumber(std::basic_string_view<_Char> str, _T& value) {
+	return ParseNumber(str.data(), str.data() + str.size(), value).error;
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#ifdef _WIN32
 #include <Common/Targetver.h>
 
 // Exclude rarely-used stuff from windows headers.
@@ -23,8 +24,17 @@
 #include <d2d1_3.h>
 #include <dwrite_3.h>
 #include <DirectXMath.h>
+#else
+// The bot logic is built headless on other platforms, against the Win32 functions it uses.
+#include <Common/Win32Shim.h>
+
+// C RunTime header files:
+#include <stdlib.h>
+#include <wchar.h>
+#endif
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <thread>
 
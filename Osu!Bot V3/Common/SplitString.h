@@ -1,9 +1,14 @@
 // SplitString.h : Defines a funtion that splits a std::string on a delimiter
 // into a std::vector<std::string>. Also has std::wstring support.
+// And a tokenizer that splits a std::string_view without allocating,
+// the tokens are views into the original string.
 
 #pragma once
 
 #include <vector>
+#include <array>
+#include <stdexcept>
+#include <string_view>
 
 
 // SplitString for std::string.
@@ -62,4 +67,83 @@ inline std::vector<std::wstring> SplitString(
 
 	// return the result with the splitted string.
 	return result;
-}
\ No newline at end of file
+}
+
+// Splits a string into tokens one at a time.
+class StringTokenizer {
+public:
+	// Constructor.
+	StringTokenizer(_In_ std::string_view str, _In_ char delimiter) :
+		m_remaining(str),
+		m_delimiter(delimiter),
+		m_finished(FALSE)
+	{}
+
+	// Stores the next token in token.
+	// Returns FALSE when all tokens have been read.
+	bool Next(_Out_ std::string_view& token) {
+		if (m_finished) {
+			// All tokens have been read.
+			return FALSE;
+		}
+
+		size_t delimiterPosition = m_remaining.find(m_delimiter);
+		if (delimiterPosition == std::string_view::npos) {
+			// No delimiter left, the remaining string is the last token.
+			token = m_remaining;
+			m_finished = TRUE;
+		}
+		else {
+			// Delimiter found, move past it for the next token.
+			token = m_remaining.substr(0U, delimiterPosition);
+			m_remaining.remove_prefix(delimiterPosition + 1U);
+		}
+
+		return TRUE;
+	}
+
+	// Returns the part of the string that has not been read yet.
+	std::string_view GetRemaining() const { return m_finished ? std::string_view() : m_remaining; }
+
+
+private:
+	// Member variables.
+	std::string_view m_remaining;
+	char m_delimiter;
+	bool m_finished;
+};
+
+// Splits a string into at most _Size tokens stored on the stack.
+// Tokens after the first _Size are not stored.
+template<size_t _Size>
+class StringTokens {
+public:
+	// Constructor.
+	StringTokens(_In_ std::string_view str, _In_ char delimiter) :
+		m_count(0U)
+	{
+		StringTokenizer tokenizer(str, delimiter);
+		while (m_count < _Size && tokenizer.Next(m_tokens[m_count])) {
+			m_count++;
+		}
+	}
+
+	// Accessor functions.
+	size_t size() const { return m_count; }
+
+	std::string_view operator[] (size_t index) const { return m_tokens[index]; }
+
+	// Throws std::out_of_range like std::vector::at(), when the token was not in the string.
+	std::string_view at(size_t index) const {
+		if (index >= m_count) {
+			throw std::out_of_range("StringTokens index out of range");
+		}
+		return m_tokens[index];
+	}
+
+
+private:
+	// Member variables.
+	std::array<std::string_view, _Size> m_tokens;
+	size_t m_count;
+};
\ No newline at end of file
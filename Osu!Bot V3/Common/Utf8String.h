@@ -0,0 +1,45 @@
+// Utf8String.h : Defines functions that convert between UTF-8 strings
+// (beatmap content) and std::wstring (window titles and the HUD).
+
+#pragma once
+
+#include <string_view>
+
+
+// Converts a UTF-8 string to a std::wstring. (WIDE CONVERSIONS).
+inline std::wstring Utf8ToWide(_In_ std::string_view str) {
+	std::wstring result;
+
+	if (str.empty()) {
+		// Nothing to convert, return empty result.
+		return result;
+	}
+
+	// Get the converted size first, then convert into the result.
+	int size = MultiByteToWideChar(CP_UTF8, 0UL, str.data(), (INT)str.size(), nullptr, 0);
+	if (size > 0) {
+		result.resize(static_cast<size_t>(size));
+		MultiByteToWideChar(CP_UTF8, 0UL, str.data(), (INT)str.size(), &result[0], size);
+	}
+
+	return result;
+}
+
+// Converts a std::wstring to a UTF-8 string.
+inline std::string WideToUtf8(_In_ std::wstring_view str) {
+	std::string result;
+
+	if (str.empty()) {
+		// Nothing to convert, return empty result.
+		return result;
+	}
+
+	// Get the converted size first, then convert into the result.
+	int size = WideCharToMultiByte(CP_UTF8, 0UL, str.data(), (INT)str.size(), nullptr, 0, nullptr, nullptr);
+	if (size > 0) {
+		result.resize(static_cast<size_t>(size));
+		WideCharToMultiByte(CP_UTF8, 0UL, str.data(), (INT)str.size(), &result[0], size, nullptr, nullptr);
+	}
+
+	return result;
+}
\ No newline at end of file
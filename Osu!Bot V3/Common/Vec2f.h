@@ -105,7 +105,7 @@ public:
 		return this->Dev(this->Length());
 	}
 
-	vec2f ConvertToWindowSpace(const float& stackOffset, const UINT& stackIndex, const DX::Size<FLOAT>& multiplier, const DX::Size<INT>& offset) {
+	vec2f ConvertToWindowSpace(const float& stackOffset, const int& stackIndex, const DX::Size<FLOAT>& multiplier, const DX::Size<INT>& offset) {
 		this->Sub(stackOffset * (FLOAT)stackIndex);
 		this->Mult((FLOAT)multiplier.Width, (FLOAT)multiplier.Height);
 		this->Add((FLOAT)offset.Width, (FLOAT)offset.Height);
@@ -115,6 +115,13 @@ public:
 
 		return *this;
 	}
+
+	vec2f ConvertToPlayfieldSpace(const DX::Size<FLOAT>& multiplier, const DX::Size<INT>& offset) {
+		this->Sub((FLOAT)offset.Width, (FLOAT)offset.Height);
+		this->Dev(vec2f((FLOAT)multiplier.Width, (FLOAT)multiplier.Height));
+
+		return *this;
+	}
 };
 
 // Inline operators.
@@ -0,0 +1,405 @@
+// Win32Shim.cpp : Defines the content in Win32Shim.h with the POSIX functions.
+// This file is only built headless, the Windows build uses the real Win32 API.
+
+#include <Common/Pch.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace
+{
+	// A file or file mapping handle.
+	// A file mapping has no file of its own, it maps the file of the file handle it was made from.
+	struct ShimHandle {
+		int fileDescriptor;
+		bool ownsFile;
+		size_t size;
+	};
+
+	// The sizes of the mapped views, munmap needs them.
+	std::mutex mappedViewsMutex;
+	std::unordered_map<LPCVOID, size_t> mappedViews;
+
+	// Appends the code point to the UTF-8 string.
+	void AppendUtf8(_Inout_ std::string& str, _In_ uint32_t codePoint) {
+		if (codePoint > 0x10FFFFU || (codePoint >= 0xD800U && codePoint <= 0xDFFFU)) {
+			// Not a code point, use the replacement character.
+			codePoint = 0xFFFDU;
+		}
+
+		if (codePoint < 0x80U) {
+			str += static_cast<char>(codePoint);
+		}
+		else if (codePoint < 0x800U) {
+			str += static_cast<char>(0xC0U | (codePoint >> 6));
+			str += static_cast<char>(0x80U | (codePoint & 0x3FU));
+		}
+		else if (codePoint < 0x10000U) {
+			str += static_cast<char>(0xE0U | (codePoint >> 12));
+			str += static_cast<char>(0x80U | ((codePoint >> 6) & 0x3FU));
+			str += static_cast<char>(0x80U | (codePoint & 0x3FU));
+		}
+		else {
+			str += static_cast<char>(0xF0U | (codePoint >> 18));
+			str += static_cast<char>(0x80U | ((codePoint >> 12) & 0x3FU));
+			str += static_cast<char>(0x80U | ((codePoint >> 6) & 0x3FU));
+			str += static_cast<char>(0x80U | (codePoint & 0x3FU));
+		}
+	}
+
+	// Converts the wide string to UTF-8, wchar_t holds a whole code point here.
+	std::string ToUtf8(_In_ LPCWSTR str, _In_ const size_t& lenght) {
+		std::string result;
+		result.reserve(lenght);
+		for (size_t i = 0U; i < lenght; i++) {
+			AppendUtf8(result, static_cast<uint32_t>(str[i]));
+		}
+
+		return result;
+	}
+
+	// Converts the path to a UTF-8 POSIX path.
+	std::string ToPosixPath(_In_ LPCWSTR path) {
+		std::string result = ToUtf8(path, wcslen(path));
+		for (char& pathChar : result) {
+			if (pathChar == '\\') {
+				pathChar = '/';
+			}
+		}
+
+		return result;
+	}
+
+	// Returns the time as a FILETIME (100 nanosecond intervals since 1601).
+	FILETIME ToFileTime(_In_ const timespec& time) {
+		const ULONGLONG intervals = (static_cast<ULONGLONG>(time.tv_sec) + 11644473600ULL) * 10000000ULL + static_cast<ULONGLONG>(time.tv_nsec) / 100U;
+
+		FILETIME fileTime;
+		fileTime.dwLowDateTime = static_cast<DWORD>(intervals & 0xFFFFFFFFULL);
+		fileTime.dwHighDateTime = static_cast<DWORD>(intervals >> 32);
+
+		return fileTime;
+	}
+}
+
+
+// Debug output.
+void OutputDebugStringW(_In_opt_ LPCWSTR outputString) {
+	if (outputString != nullptr) {
+		fputs(ToUtf8(outputString, wcslen(outputString)).c_str(), stderr);
+	}
+}
+
+
+// Timer functions.
+BOOL QueryPerformanceFrequency(_Out_ LARGE_INTEGER* frequency) {
+	frequency->QuadPart = 1000000000LL;
+	return TRUE;
+}
+
+BOOL QueryPerformanceCounter(_Out_ LARGE_INTEGER* performanceCount) {
+	timespec time;
+	if (clock_gettime(CLOCK_MONOTONIC, &time) != 0) {
+		return FALSE;
+	}
+
+	performanceCount->QuadPart = static_cast<LONGLONG>(time.tv_sec) * 1000000000LL + time.tv_nsec;
+	return TRUE;
+}
+
+
+// String conversion functions.
+// Returns the number of characters (with a 0 terminator if the input lenght is -1), or 0 when the output is too small.
+int MultiByteToWideChar(UINT codePage, DWORD flags, const char* multiByteStr, int multiByte, LPWSTR wideCharStr, int wideChar) {
+	UNREFERENCED_PARAMETER(flags);
+	if (codePage != CP_UTF8 || multiByteStr == nullptr) {
+		return 0;
+	}
+
+	const size_t lenght = (multiByte < 0) ? strlen(multiByteStr) + 1U : static_cast<size_t>(multiByte);
+	const unsigned char* str = reinterpret_cast<const unsigned char*>(multiByteStr);
+
+	std::wstring result;
+	result.reserve(lenght);
+	for (size_t i = 0U; i < lenght;) {
+		// The lenght of the sequence from the lead byte.
+		const unsigned char lead = str[i];
+		size_t sequenceLenght = (lead < 0x80U) ? 1U : (lead >> 5) == 0x6U ? 2U : (lead >> 4) == 0xEU ? 3U : (lead >> 3) == 0x1EU ? 4U : 0U;
+		uint32_t codePoint = (sequenceLenght == 1U) ? lead : (sequenceLenght == 2U) ? lead & 0x1FU : (sequenceLenght == 3U) ? lead & 0x0FU : lead & 0x07U;
+
+		bool valid = sequenceLenght > 0U && i + sequenceLenght <= lenght;
+		for (size_t j = 1U; valid && j < sequenceLenght; j++) {
+			valid = (str[i + j] & 0xC0U) == 0x80U;
+			codePoint = (codePoint << 6) | (str[i + j] & 0x3FU);
+		}
+
+		if (valid) {
+			result += static_cast<wchar_t>(codePoint);
+			i += sequenceLenght;
+		}
+		else {
+			// Invalid sequence, use the replacement character for the lead byte.
+			result += static_cast<wchar_t>(0xFFFDU);
+			i++;
+		}
+	}
+
+	if (wideChar == 0) {
+		return static_cast<int>(result.size());
+	}
+	if (wideCharStr == nullptr || static_cast<size_t>(wideChar) < result.size()) {
+		return 0;
+	}
+
+	wmemcpy(wideCharStr, result.data(), result.size());
+	return static_cast<int>(result.size());
+}
+
+int WideCharToMultiByte(UINT codePage, DWORD flags, LPCWSTR wideCharStr, int wideChar, char* multiByteStr, int multiByte, const char* defaultChar, BOOL* usedDefaultChar) {
+	UNREFERENCED_PARAMETER(flags);
+	UNREFERENCED_PARAMETER(defaultChar);
+	if (usedDefaultChar != nullptr) {
+		*usedDefaultChar = FALSE;
+	}
+	if (codePage != CP_UTF8 || wideCharStr == nullptr) {
+		return 0;
+	}
+
+	const size_t lenght = (wideChar < 0) ? wcslen(wideCharStr) + 1U : static_cast<size_t>(wideChar);
+	const std::string result = ToUtf8(wideCharStr, lenght);
+
+	if (multiByte == 0) {
+		return static_cast<int>(result.size());
+	}
+	if (multiByteStr == nullptr || static_cast<size_t>(multiByte) < result.size()) {
+		return 0;
+	}
+
+	memcpy(multiByteStr, result.data(), result.size());
+	return static_cast<int>(result.size());
+}
+
+
+// File functions.
+// Only the share modes and dispositions that the bot uses are supported.
+HANDLE CreateFileW(LPCWSTR fileName, DWORD desiredAccess, DWORD shareMode, SECURITY_ATTRIBUTES* securityAttributes, DWORD creationDisposition, DWORD flagsAndAttributes, HANDLE templateFile) {
+	UNREFERENCED_PARAMETER(shareMode);
+	UNREFERENCED_PARAMETER(securityAttributes);
+	UNREFERENCED_PARAMETER(flagsAndAttributes);
+	UNREFERENCED_PARAMETER(templateFile);
+
+	int openFlags = ((desiredAccess & GENERIC_WRITE) != 0UL) ? (((desiredAccess & GENERIC_READ) != 0UL) ? O_RDWR : O_WRONLY) : O_RDONLY;
+	if (creationDisposition == CREATE_ALWAYS) {
+		openFlags |= O_CREAT | O_TRUNC;
+	}
+	else if (creationDisposition != OPEN_EXISTING) {
+		return INVALID_HANDLE_VALUE;
+	}
+
+	const int fileDescriptor = open(ToPosixPath(fileName).c_str(), openFlags | O_CLOEXEC, 0644);
+	if (fileDescriptor < 0) {
+		return INVALID_HANDLE_VALUE;
+	}
+
+	return new ShimHandle{ fileDescriptor, TRUE, 0U };
+}
+
+BOOL GetFileSizeEx(HANDLE file, LARGE_INTEGER* fileSize) {
+	struct stat fileStatus;
+	if (file == INVALID_HANDLE_VALUE || file == nullptr || fstat(static_cast<ShimHandle*>(file)->fileDescriptor, &fileStatus) != 0) {
+		return FALSE;
+	}
+
+	fileSize->QuadPart = static_cast<LONGLONG>(fileStatus.st_size);
+	return TRUE;
+}
+
+BOOL WriteFile(HANDLE file, LPCVOID buffer, DWORD numberOfBytesToWrite, DWORD* numberOfBytesWritten, void* overlapped) {
+	UNREFERENCED_PARAMETER(overlapped);
+	if (file == INVALID_HANDLE_VALUE || file == nullptr) {
+		return FALSE;
+	}
+
+	// Write until everything is written, write may stop early.
+	const char* data = static_cast<const char*>(buffer);
+	size_t written = 0U;
+	while (written < numberOfBytesToWrite) {
+		const ssize_t result = write(static_cast<ShimHandle*>(file)->fileDescriptor, data + written, numberOfBytesToWrite - written);
+		if (result <= 0) {
+			break;
+		}
+		written += static_cast<size_t>(result);
+	}
+
+	if (numberOfBytesWritten != nullptr) {
+		*numberOfBytesWritten = static_cast<DWORD>(written);
+	}
+	return written == numberOfBytesToWrite;
+}
+
+BOOL CloseHandle(HANDLE object) {
+	if (object == INVALID_HANDLE_VALUE || object == nullptr) {
+		return FALSE;
+	}
+
+	ShimHandle* handle = static_cast<ShimHandle*>(object);
+	const bool closed = !handle->ownsFile || close(handle->fileDescriptor) == 0;
+	delete handle;
+
+	return closed;
+}
+
+HANDLE CreateFileMappingW(HANDLE file, SECURITY_ATTRIBUTES* fileMappingAttributes, DWORD protect, DWORD maximumSizeHigh, DWORD maximumSizeLow, LPCWSTR name) {
+	UNREFERENCED_PARAMETER(fileMappingAttributes);
+	UNREFERENCED_PARAMETER(protect);
+	UNREFERENCED_PARAMETER(maximumSizeHigh);
+	UNREFERENCED_PARAMETER(maximumSizeLow);
+	UNREFERENCED_PARAMETER(name);
+
+	// The whole file is mapped, an empty file can't be mapped.
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+		return nullptr;
+	}
+
+	return new ShimHandle{ static_cast<ShimHandle*>(file)->fileDescriptor, FALSE, static_cast<size_t>(fileSize.QuadPart) };
+}
+
+LPVOID MapViewOfFile(HANDLE fileMappingObject, DWORD desiredAccess, DWORD fileOffsetHigh, DWORD fileOffsetLow, SIZE_T numberOfBytesToMap) {
+	UNREFERENCED_PARAMETER(desiredAccess);
+	if (fileMappingObject == nullptr || fileOffsetHigh != 0UL || fileOffsetLow != 0UL) {
+		return nullptr;
+	}
+
+	const ShimHandle* mapping = static_cast<ShimHandle*>(fileMappingObject);
+	const size_t size = (numberOfBytesToMap == 0U) ? mapping->size : (std::min)(numberOfBytesToMap, mapping->size);
+
+	void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, mapping->fileDescriptor, 0);
+	if (view == MAP_FAILED) {
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(mappedViewsMutex);
+	mappedViews[view] = size;
+
+	return view;
+}
+
+BOOL UnmapViewOfFile(LPCVOID baseAddress) {
+	size_t size = 0U;
+	{
+		std::lock_guard<std::mutex> lock(mappedViewsMutex);
+		auto mappedView = mappedViews.find(baseAddress);
+		if (mappedView == mappedViews.end()) {
+			return FALSE;
+		}
+
+		size = mappedView->second;
+		mappedViews.erase(mappedView);
+	}
+
+	return munmap(const_cast<LPVOID>(baseAddress), size) == 0;
+}
+
+BOOL GetFileAttributesExW(LPCWSTR fileName, GET_FILEEX_INFO_LEVELS infoLevelId, LPVOID fileInformation) {
+	struct stat fileStatus;
+	if (infoLevelId != GetFileExInfoStandard || stat(ToPosixPath(fileName).c_str(), &fileStatus) != 0) {
+		return FALSE;
+	}
+
+	WIN32_FILE_ATTRIBUTE_DATA* fileData = static_cast<WIN32_FILE_ATTRIBUTE_DATA*>(fileInformation);
+	ZeroMemory(fileData, sizeof(WIN32_FILE_ATTRIBUTE_DATA));
+	fileData->dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+	fileData->ftCreationTime = ToFileTime(fileStatus.st_ctim);
+	fileData->ftLastAccessTime = ToFileTime(fileStatus.st_atim);
+	fileData->ftLastWriteTime = ToFileTime(fileStatus.st_mtim);
+	fileData->nFileSizeHigh = static_cast<DWORD>(static_cast<ULONGLONG>(fileStatus.st_size) >> 32);
+	fileData->nFileSizeLow = static_cast<DWORD>(static_cast<ULONGLONG>(fileStatus.st_size) & 0xFFFFFFFFULL);
+
+	return TRUE;
+}
+
+BOOL CreateDirectoryW(LPCWSTR pathName, SECURITY_ATTRIBUTES* securityAttributes) {
+	UNREFERENCED_PARAMETER(securityAttributes);
+	return mkdir(ToPosixPath(pathName).c_str(), 0755) == 0;
+}
+
+BOOL MoveFileExW(LPCWSTR existingFileName, LPCWSTR newFileName, DWORD flags) {
+	// rename always replaces the existing file.
+	UNREFERENCED_PARAMETER(flags);
+	return rename(ToPosixPath(existingFileName).c_str(), ToPosixPath(newFileName).c_str()) == 0;
+}
+
+BOOL DeleteFileW(LPCWSTR fileName) {
+	return unlink(ToPosixPath(fileName).c_str()) == 0;
+}
+
+
+// Input functions.
+BOOL GetCursorPos(POINT* point) {
+	point->x = 0L;
+	point->y = 0L;
+	return FALSE;
+}
+
+BOOL SetCursorPos(int x, int y) {
+	UNREFERENCED_PARAMETER(x);
+	UNREFERENCED_PARAMETER(y);
+	return FALSE;
+}
+
+UINT SendInput(UINT inputs, INPUT* input, int size) {
+	UNREFERENCED_PARAMETER(inputs);
+	UNREFERENCED_PARAMETER(input);
+	UNREFERENCED_PARAMETER(size);
+	return 0U;
+}
+
+
+// Process functions.
+HANDLE CreateToolhelp32Snapshot(DWORD flags, DWORD processId) {
+	UNREFERENCED_PARAMETER(flags);
+	UNREFERENCED_PARAMETER(processId);
+	return INVALID_HANDLE_VALUE;
+}
+
+BOOL Process32NextW(HANDLE snapshot, PROCESSENTRY32W* processEntry) {
+	UNREFERENCED_PARAMETER(snapshot);
+	UNREFERENCED_PARAMETER(processEntry);
+	return FALSE;
+}
+
+HANDLE OpenProcess(DWORD desiredAccess, BOOL inheritHandle, DWORD processId) {
+	UNREFERENCED_PARAMETER(desiredAccess);
+	UNREFERENCED_PARAMETER(inheritHandle);
+	UNREFERENCED_PARAMETER(processId);
+	return nullptr;
+}
+
+SIZE_T VirtualQueryEx(HANDLE process, LPCVOID address, MEMORY_BASIC_INFORMATION* buffer, SIZE_T lenght) {
+	UNREFERENCED_PARAMETER(process);
+	UNREFERENCED_PARAMETER(address);
+	ZeroMemory(buffer, lenght);
+	return 0U;
+}
+
+BOOL ReadProcessMemory(HANDLE process, LPCVOID baseAddress, LPVOID buffer, SIZE_T size, SIZE_T* numberOfBytesRead) {
+	UNREFERENCED_PARAMETER(process);
+	UNREFERENCED_PARAMETER(baseAddress);
+	UNREFERENCED_PARAMETER(buffer);
+	UNREFERENCED_PARAMETER(size);
+	if (numberOfBytesRead != nullptr) {
+		*numberOfBytesRead = 0U;
+	}
+	return FALSE;
+}
\ No newline at end of file
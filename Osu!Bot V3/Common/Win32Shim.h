@@ -0,0 +1,218 @@
+// Win32Shim.h : Declares the part of the Win32 API that the bot logic uses,
+// so the bot logic builds headless on platforms without Windows.h (the Linux build hosts).
+// Only the bot logic files are built against it, the app, window and drawing files need Windows.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cwchar>
+#include <cwctype>
+#include <cmath>
+#include <cfloat>
+#include <climits>
+#include <memory>
+
+// Resource.h declares M_PI and M_2PI as constants, the C runtime declares them as macros.
+#undef M_PI
+#undef M_2PI
+
+
+// Annotations (only read by the MSVC code analysis).
+#define _In_
+#define _In_opt_
+#define _Out_
+#define _Out_opt_
+#define _Inout_
+#define _Inout_opt_
+
+#define WINAPI
+
+
+// Basic types, with the same sizes as on Windows where it matters.
+typedef int					BOOL;
+typedef unsigned char		BYTE;
+typedef unsigned short		WORD;
+typedef unsigned long		DWORD;
+typedef int					INT;
+typedef unsigned int		UINT;
+typedef long				LONG;
+typedef long long			LONGLONG;
+typedef unsigned long long	ULONGLONG;
+typedef float				FLOAT;
+typedef double				DOUBLE;
+typedef size_t				SIZE_T;
+typedef uintptr_t			ULONG_PTR;
+typedef wchar_t				WCHAR;
+typedef const wchar_t*		LPCWSTR;
+typedef wchar_t*			LPWSTR;
+typedef void*				LPVOID;
+typedef const void*			LPCVOID;
+typedef void*				HANDLE;
+typedef void*				HWND;
+typedef void*				HINSTANCE;
+typedef long				HRESULT;
+
+#define TRUE	1
+#define FALSE	0
+
+#define FAILED(hr)		((HRESULT)(hr) < 0)
+#define SUCCEEDED(hr)	((HRESULT)(hr) >= 0)
+
+#define ZeroMemory(destination, lenght) memset((destination), 0, (lenght))
+#define UNREFERENCED_PARAMETER(parameter) (void)(parameter)
+
+#define ERROR_INVALID_DATA 13L
+#define MAX_PATH 260
+
+
+// Structures.
+struct POINT {
+	LONG x;
+	LONG y;
+};
+
+struct RECT {
+	LONG left;
+	LONG top;
+	LONG right;
+	LONG bottom;
+};
+
+union LARGE_INTEGER {
+	struct {
+		DWORD LowPart;
+		LONG HighPart;
+	} u;
+	LONGLONG QuadPart;
+};
+
+struct FILETIME {
+	DWORD dwLowDateTime;
+	DWORD dwHighDateTime;
+};
+
+struct SECURITY_ATTRIBUTES;
+
+
+// Debug output, written to stderr.
+void OutputDebugStringW(_In_opt_ LPCWSTR outputString);
+
+
+// Timer functions, the counter is in nanoseconds.
+BOOL QueryPerformanceFrequency(_Out_ LARGE_INTEGER* frequency);
+BOOL QueryPerformanceCounter(_Out_ LARGE_INTEGER* performanceCount);
+
+
+// String conversion functions, only CP_UTF8 is supported.
+#define CP_UTF8 65001U
+
+int MultiByteToWideChar(UINT codePage, DWORD flags, const char* multiByteStr, int multiByte, LPWSTR wideCharStr, int wideChar);
+int WideCharToMultiByte(UINT codePage, DWORD flags, LPCWSTR wideCharStr, int wideChar, char* multiByteStr, int multiByte, const char* defaultChar, BOOL* usedDefaultChar);
+
+
+// File functions, paths may use '\' as separator.
+#define INVALID_HANDLE_VALUE ((HANDLE)(intptr_t)-1)
+
+#define GENERIC_READ				0x80000000UL
+#define GENERIC_WRITE				0x40000000UL
+#define FILE_SHARE_READ				0x00000001UL
+#define FILE_SHARE_WRITE			0x00000002UL
+#define FILE_SHARE_DELETE			0x00000004UL
+#define CREATE_ALWAYS				2UL
+#define OPEN_EXISTING				3UL
+#define FILE_ATTRIBUTE_NORMAL		0x00000080UL
+#define FILE_FLAG_SEQUENTIAL_SCAN	0x08000000UL
+#define PAGE_READONLY				0x02UL
+#define FILE_MAP_READ				0x04UL
+#define MOVEFILE_REPLACE_EXISTING	0x01UL
+
+enum GET_FILEEX_INFO_LEVELS {
+	GetFileExInfoStandard
+};
+
+struct WIN32_FILE_ATTRIBUTE_DATA {
+	DWORD dwFileAttributes;
+	FILETIME ftCreationTime;
+	FILETIME ftLastAccessTime;
+	FILETIME ftLastWriteTime;
+	DWORD nFileSizeHigh;
+	DWORD nFileSizeLow;
+};
+
+HANDLE CreateFileW(LPCWSTR fileName, DWORD desiredAccess, DWORD shareMode, SECURITY_ATTRIBUTES* securityAttributes, DWORD creationDisposition, DWORD flagsAndAttributes, HANDLE templateFile);
+BOOL GetFileSizeEx(HANDLE file, LARGE_INTEGER* fileSize);
+BOOL WriteFile(HANDLE file, LPCVOID buffer, DWORD numberOfBytesToWrite, DWORD* numberOfBytesWritten, void* overlapped);
+BOOL CloseHandle(HANDLE object);
+HANDLE CreateFileMappingW(HANDLE file, SECURITY_ATTRIBUTES* fileMappingAttributes, DWORD protect, DWORD maximumSizeHigh, DWORD maximumSizeLow, LPCWSTR name);
+LPVOID MapViewOfFile(HANDLE fileMappingObject, DWORD desiredAccess, DWORD fileOffsetHigh, DWORD fileOffsetLow, SIZE_T numberOfBytesToMap);
+BOOL UnmapViewOfFile(LPCVOID baseAddress);
+BOOL GetFileAttributesExW(LPCWSTR fileName, GET_FILEEX_INFO_LEVELS infoLevelId, LPVOID fileInformation);
+BOOL CreateDirectoryW(LPCWSTR pathName, SECURITY_ATTRIBUTES* securityAttributes);
+BOOL MoveFileExW(LPCWSTR existingFileName, LPCWSTR newFileName, DWORD flags);
+BOOL DeleteFileW(LPCWSTR fileName);
+
+
+// Input functions.
+// There is no system cursor or mouse headless, they fail and the bot uses a registered output sink instead.
+#define INPUT_MOUSE				0UL
+#define MOUSEEVENTF_LEFTDOWN	0x0002UL
+#define MOUSEEVENTF_LEFTUP		0x0004UL
+
+struct MOUSEINPUT {
+	LONG dx;
+	LONG dy;
+	DWORD mouseData;
+	DWORD dwFlags;
+	DWORD time;
+	ULONG_PTR dwExtraInfo;
+};
+
+struct INPUT {
+	DWORD type;
+	MOUSEINPUT mi;
+};
+
+BOOL GetCursorPos(POINT* point);
+BOOL SetCursorPos(int x, int y);
+UINT SendInput(UINT inputs, INPUT* input, int size);
+
+
+// Process functions.
+// There is no game process headless, they fail and the bot uses a registered song clock instead.
+#define TH32CS_SNAPPROCESS			0x00000002UL
+#define TH32CS_SNAPMODULE			0x00000008UL
+#define PROCESS_VM_READ				0x0010UL
+#define PROCESS_QUERY_INFORMATION	0x0400UL
+#define MEM_COMMIT					0x00001000UL
+#define PAGE_EXECUTE_READWRITE		0x40UL
+
+struct PROCESSENTRY32W {
+	DWORD dwSize;
+	DWORD cntUsage;
+	DWORD th32ProcessID;
+	ULONG_PTR th32DefaultHeapID;
+	DWORD th32ModuleID;
+	DWORD cntThreads;
+	DWORD th32ParentProcessID;
+	LONG pcPriClassBase;
+	DWORD dwFlags;
+	WCHAR szExeFile[MAX_PATH];
+};
+
+struct MEMORY_BASIC_INFORMATION {
+	LPVOID BaseAddress;
+	LPVOID AllocationBase;
+	DWORD AllocationProtect;
+	SIZE_T RegionSize;
+	DWORD State;
+	DWORD Protect;
+	DWORD Type;
+};
+
+HANDLE CreateToolhelp32Snapshot(DWORD flags, DWORD processId);
+BOOL Process32NextW(HANDLE snapshot, PROCESSENTRY32W* processEntry);
+HANDLE OpenProcess(DWORD desiredAccess, BOOL inheritHandle, DWORD processId);
+SIZE_T VirtualQueryEx(HANDLE process, LPCVOID address, MEMORY_BASIC_INFORMATION* buffer, SIZE_T lenght);
+BOOL ReadProcessMemory(HANDLE process, LPCVOID baseAddress, LPVOID buffer, SIZE_T size, SIZE_T* numberOfBytesRead);
\ No newline at end of file
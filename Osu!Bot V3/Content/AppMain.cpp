@@ -18,6 +18,7 @@ AppMain::AppMain(const std::shared_ptr<DX::DeviceResources>& deviceResources) :
 	m_hInstance(NULL),
 	m_hudVisible(TRUE),
 	m_debugInfoVisible(FALSE),
+	m_beatmapQueueVersion(UINT_MAX),
 	m_quit(FALSE) {
 	// Assign the device resources.
 	m_deviceResources->RegisterDeviceNotify(this);
@@ -147,12 +148,16 @@ void AppMain::Update() {
 		}
 
 		m_beatmapQueueNamesRenderer->SetTranslation(DX::Size<FLOAT>(3.f, 80.f));
-		std::wstring names = L"Beatmap Queue (Insert to add)\n-----------------------------\n";
-		for (auto beatmap : m_osuBot->m_beatmapQueue) {
-			names += beatmap.GetTitle();
-			names += L"\n";
+		if (m_osuBot->m_beatmapQueue.GetVersion() != m_beatmapQueueVersion) {
+			// The queue changed, make the names again.
+			// The beatmaps are borrowed while the queue is locked, nothing is copied.
+			std::wstring names = L"Beatmap Queue (Insert to add)\n-----------------------------\n";
+			m_beatmapQueueVersion = m_osuBot->m_beatmapQueue.ForEach([&names](const BeatmapInfo::Beatmap& beatmap) {
+				names += Utf8ToWide(beatmap.GetTitle());
+				names += L"\n";
+			});
+			m_beatmapQueueNamesRenderer->Update(names);
 		}
-		m_beatmapQueueNamesRenderer->Update(names);
 
 
 		// Update debug information (normaly not used).
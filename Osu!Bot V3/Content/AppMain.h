@@ -69,6 +69,8 @@ namespace OsuBot
 		// TODO: place app content pointer here.
 		std::unique_ptr<UIElements::StaticText> m_songNameRenderer; 
 		std::unique_ptr<UIElements::StaticText> m_beatmapQueueNamesRenderer;
+		// The version of the beatmap queue the names were made from.
+		UINT m_beatmapQueueVersion;
 
 		std::unique_ptr<UIElements::StaticText> m_timeRenderer;
 		std::unique_ptr<UIElements::StaticText> m_fpsRenderer;
@@ -5,7 +5,11 @@
 
 #include <Content/OsuBot/MovementModes.h>
 #include <Content/OsuBot/Beatmap.h>
+#include <Content/OsuBot/BeatmapQueue.h>
 #include <Content/OsuBot/SigScan.h>
+#include <Content/OsuBot/BotEnvironment.h>
+
+#include <Common/Utf8String.h>
 
 
 namespace OsuBot
@@ -23,6 +27,19 @@ namespace OsuBot
 		void UpdateSongTime();
 		void AutoPlay();
 
+		// Bot logic functions, used by AutoPlay and by a headless driver.
+		void PlayHitObjects();
+		void StartSong(const UINT& beatmapIndex);
+
+		// Environment functions, the bot plays the game until a song clock or output sink is registered.
+		// Registering nullptr returns to the game.
+		void RegisterSongClock(ISongClock* songClock) { m_songClock = songClock ? songClock : &m_gameSongClock; }
+		void RegisterOutputSink(IOutputSink* outputSink) { m_outputSink = outputSink ? outputSink : &m_win32OutputSink; }
+		void SetWindowGeometry(const WindowGeometry& geometry);
+
+		// Beatmaps are queued with the beatmap cache, unless it is disabled (a headless run doesn't write files).
+		void SetBeatmapCacheEnabled(const bool& enabled) { m_beatmapCacheEnabled = enabled; }
+
 	private:
 		// Bot functions.
 		std::wstring GetOsuFolderPath();
@@ -31,16 +48,18 @@ namespace OsuBot
 		void CheckSongActive();
 		void GetCurrentSong();
 
-		void GetTimeAddress();
-
 	public:
 		// Bot accessor functions.
 		double GetSongTime() const { return m_songTime; }
 
 		DX::Size<INT> GetOffset() const { return m_offset; }
 		DX::Size<FLOAT> GetMultiplier() const { return m_multiplier; }
+		// The multiplier to convert into playfield space with, 1:1 until the window geometry is set.
+		DX::Size<FLOAT> GetPlayfieldMultiplier() const { return (m_multiplier.Width > 0.f && m_multiplier.Height > 0.f) ? m_multiplier : DX::Size<FLOAT>(1.f, 1.f); }
+
+		const BeatmapInfo::Beatmap* GetBeatmapAtIndex(const UINT& index) const { return m_beatmapQueue.GetBeatmapAtIndex(index); }
 
-		const BeatmapInfo::Beatmap* GetBeatmapAtIndex(const UINT& index) const { return &m_beatmapQueue.at(index); }
+		IOutputSink* GetOutputSink() const { return m_outputSink; }
 
 
 	public:
@@ -53,23 +72,22 @@ namespace OsuBot
 		UINT m_selectedBeatmapIndex;
 		UINT m_hitObjectIndex;
 		POINT m_cursorPosition;
-		std::vector<BeatmapInfo::Beatmap> m_beatmapQueue;
+		BeatmapInfo::BeatmapQueue m_beatmapQueue;
 
 
 	private:
 		// Bot variables.
-		HANDLE m_gameProcessHandle;
 		std::wstring m_gameTitle;
 		UINT m_timerFrameCount;
 		UINT m_targetFps;
 		RECT m_targetRect;
-		INPUT m_input;
 		double m_prevSongTime;
 		double m_songTime;
 		double m_songTimeOffset;
 		bool m_songStarted;
 		bool m_songPaused;
 		bool m_beatmapFinished;
+		bool m_beatmapCacheEnabled;
 
 		// Beatmap song variables.
 		std::wstring m_currentSongName;
@@ -83,9 +101,6 @@ namespace OsuBot
 		float m_movementAmplifier;
 		bool m_hardrock;
 
-		// Time variables.
-		std::unique_ptr<DWORD> m_timeAddress;
-
 
 	public:
 		// Bot logic loop timer.
@@ -93,7 +108,12 @@ namespace OsuBot
 
 	private:
 		// SigScanner for time address.
-		std::wstring m_timeAddressSignature;
 		SigScan::SigScanner m_sigScanner;
+
+		// The song clock and output of the game, and the registered ones.
+		GameSongClock m_gameSongClock;
+		Win32OutputSink m_win32OutputSink;
+		ISongClock* m_songClock;
+		IOutputSink* m_outputSink;
 	};
 }
\ No newline at end of file
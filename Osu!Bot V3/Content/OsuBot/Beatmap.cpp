@@ -3,31 +3,40 @@
 #include <Common/Pch.h>
 
 #include <Content/OsuBot/Beatmap.h>
+#include <Content/OsuBot/BeatmapCache.h>
+#include <Content/OsuBot/HitObjectGrid.h>
+#include <Content/OsuBot/SliderPathCache.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
 
 
 using namespace OsuBot::BeatmapInfo;
 
 
 // Timing point constructor.
-TimingPoint::TimingPoint(_In_ std::wstring timingString) {
+TimingPoint::TimingPoint(_In_ std::string_view timingString) :
+	m_time(0),
+	m_bpm(0.f),
+	m_beatLenght(0.f),
+	m_beatLenghtBase(0.f)
+{
 	// Split the timingString into tokens.
-	std::vector<std::wstring> tokens = SplitString(timingString, L",");
+	StringTokens<2U> tokens(timingString, ',');
 
 	// Get the time from the tokens at index [0].
-	m_time = std::stoi(tokens.at(0));
+	ParseNumber(tokens.at(0), m_time);
 
-	// Try to get the bpm value from the tokens at index [1].
-	try {
-		m_bpm = std::stof(tokens.at(1));
-	}
-	catch (...) {
-		// Could not convert from string to float with std::stof().
-		// This means that the value is either: 
+	// Get the bpm value from the tokens at index [1].
+	if (ParseNumber(tokens.at(1), m_bpm) == ParseError::OutOfRange) {
+		// The value doesn't fit in a float.
+		// This means that the value is either:
 		//		Greater than FLT_MAX.
-		//		Less than 0.
-		//		Almost one of the two.
+		//		Less than -FLT_MAX.
+		//		Almost 0.
 
-		if (tokens.at(1).find('-') != std::wstring::npos) {
+		if (tokens.at(1).find('-') != std::string_view::npos) {
 			// The string contains a negative value, set the bpm to 0.
 			m_bpm = 0.f;
 		}
@@ -38,46 +47,87 @@ TimingPoint::TimingPoint(_In_ std::wstring timingString) {
 	}
 }
 
+// This function resolves the beat lenght of the timing point.
+// The bpm value of an uninherited timing point is its beat lenght,
+// inherited (negative) timing points scale the beat lenght of the last uninherited timing point.
+void TimingPoint::ResolveBeatLenght(_In_ const float& beatLenghtBase) {
+	m_beatLenghtBase = beatLenghtBase;
 
+	if (m_bpm < 0.f) {
+		// Calculate the correct beat lenght.
+		m_beatLenght = m_beatLenghtBase * m_bpm / -100.f;
+	}
+	else {
+		m_beatLenght = m_bpm;
+	}
+}
+
+// The most threads that parse the hit objects, 0 is one thread per core.
+static std::atomic<UINT> parseThreadCount(0U);
+
+
+// This function returns the timing point that is active at the time.
+// The timing points are sorted by time, objects before the first timing point use the first one.
+static const TimingPoint& FindTimingPoint(_In_ const std::vector<TimingPoint>& timingPoints, _In_ const int& time) {
+	auto nextPoint = std::upper_bound(timingPoints.begin(), timingPoints.end(), time, [](const int& time, const TimingPoint& point) {
+		return time < point.GetTime();
+	});
+
+	if (nextPoint == timingPoints.begin()) {
+		// No timing point before the time, use the first.
+		return timingPoints.at(0);
+	}
+
+	return *(nextPoint - 1);
+}
 
-// Hit object constructor.
-HitObject::HitObject(
-	_In_ std::wstring hitString,
-	_In_ std::vector<TimingPoint>* timingPoints,
+
+
+// Parsed hit object constructor.
+ParsedHitObject::ParsedHitObject(
+	_In_ std::string_view hitString,
+	_In_ const std::vector<TimingPoint>* timingPoints,
 	_In_ float beatmapSliderMultiplier,
-	_In_ float beatmapSliderTickRate
+	_In_ float beatmapSliderTickRate,
+	_Inout_ SliderGeometry* sliderGeometry
 ) :
-	m_sliderCenter(0.f, 0.f),
 	m_startPosition(0.f, 0.f),
+	m_endPosition(0.f, 0.f),
 	m_startTime(0),
 	m_endTime(0),
 	m_sliderTime(0),
-	m_startAngle(0.f),
-	m_endAngle(0.f),
-	m_sliderRadius(0.f),
 	m_pixelLenght(0.f),
 	m_beatLenght(0.f),
 	m_beatLenghtBase(0.f),
 	m_sliderTickCount(0.f),
 	m_sliderRepeatCount(0U),
-	m_stackIndex(0U),
+	m_stackIndex(0),
 	m_objectType(0U),
-	m_sliderType(0x00)
+	m_sliderType(0x00),
+	m_firstPathPoint(0U),
+	m_pathPointCount(0U),
+	m_firstSliderEvent(0U),
+	m_sliderEventCount(0U)
 {
 	// Split the hitString into tokens.
-	std::vector<std::wstring> tokens = SplitString(hitString, L",");
+	HitObjectTokens tokens(hitString, ',');
 
 	// Get the start positions and time values of the object.
-	m_startPosition = vec2f(std::stof(tokens.at(0)), std::stof(tokens.at(1)));
-	m_startTime = std::stoi(tokens.at(2));
+	// Malformed values keep their default value.
+	ParseNumber(tokens.at(0), m_startPosition.X);
+	ParseNumber(tokens.at(1), m_startPosition.Y);
+	ParseNumber(tokens.at(2), m_startTime);
+
+	// Circles and spinners end where they start, sliders overwrite it with their tail.
+	m_endPosition = m_startPosition;
 
 	// Get the object type.
-	m_objectType = _wtoi(tokens.at(3).c_str());
+	ParseNumber(tokens.at(3), m_objectType);
 
 	if (GetObjectType() == HITOBJECT_SLIDER) {
 		// The object is a slider, get the required information from the hitString.
 		// and Calculate other required information.
-		GetSliderInfo(&tokens, timingPoints, beatmapSliderMultiplier, beatmapSliderTickRate);
+		GetSliderInfo(&tokens, timingPoints, beatmapSliderMultiplier, beatmapSliderTickRate, sliderGeometry);
 	}
 	else if (GetObjectType() == HITOBJECT_SPINNER) {
 		// The object is a spinner, get the end time from the hitString.
@@ -90,40 +140,24 @@ HitObject::HitObject(
 }
 
 // This function should only be called when the object is a slider.
-// The function gets all the required information and stores it in the HitObject class.
-void HitObject::GetSliderInfo(
-	_In_ std::vector<std::wstring>* tokens,
-	_In_ std::vector<TimingPoint>* timingPoints,
+// The function gets all the required information and stores it in the parsed hit object.
+void ParsedHitObject::GetSliderInfo(
+	_In_ const HitObjectTokens* tokens,
+	_In_ const std::vector<TimingPoint>* timingPoints,
 	_In_ float beatmapSliderMultiplier,
-	_In_ float beatmapSliderTickRate
+	_In_ float beatmapSliderTickRate,
+	_Inout_ SliderGeometry* sliderGeometry
 ) {
-	// Get the beat lenght base.
-	float bpm = m_beatLenghtBase = timingPoints->at(0).GetBpm();
-
 	// Get the repeat count.
-	m_sliderRepeatCount = (UINT)std::stoi(tokens->at(6));
+	ParseNumber(tokens->at(6), m_sliderRepeatCount);
 
 	// Get the pixel lenght.
-	m_pixelLenght = std::stof(tokens->at(7));
-
-	for (TimingPoint point : *timingPoints) {
-		// Check if the timing point is valid.
-		if (point.GetTime() <= m_startTime) {
-			if (point.GetBpm() >= 0.f) {
-				// Valid timimg point, set the beat lenght base to the bpm.
-				m_beatLenghtBase = point.GetBpm();
-			}
-			// Always set bpm to the timing points bpm.
-			bpm = point.GetBpm();
-		}
-	}
+	ParseNumber(tokens->at(7), m_pixelLenght);
 
-	if (bpm < 0.f) {
-		// Calculate the correct bpm.
-		bpm = m_beatLenghtBase * bpm / -100.f;
-	}
-	// Set the beat lenght.
-	m_beatLenght = bpm;
+	// Get the beat lenghts from the timing point at the start of the slider.
+	const TimingPoint& timingPoint = FindTimingPoint(*timingPoints, m_startTime);
+	m_beatLenghtBase = timingPoint.GetBeatLenghtBase();
+	m_beatLenght = timingPoint.GetBeatLenght();
 
 
 	// Calculate the slider end time and slider time (duration).
@@ -132,105 +166,139 @@ void HitObject::GetSliderInfo(
 
 	// Calculate the slider tick count and limit the minimum value to 1.0f.
 	m_sliderTickCount = m_pixelLenght / (((100.f * beatmapSliderMultiplier) / beatmapSliderTickRate) / (m_beatLenght / m_beatLenghtBase));
-	m_sliderTickCount = max(m_sliderTickCount, 1.f);
+	m_sliderTickCount = (std::max)(m_sliderTickCount, 1.f);
 
 
-	// Push the start position to the slider points vector.
-	std::vector<vec2f> sliderPoints;
+	// Push the start position to the control points.
+	// The control points are collected in the slider geometry, which reuses them for every slider.
+	std::vector<vec2f>& sliderPoints = sliderGeometry->m_controlPoints;
+	sliderPoints.clear();
 	sliderPoints.push_back(m_startPosition);
 
 	// Split the tokens at index [5] into tokens that hold the slider points.
-	std::vector<std::wstring> sliderTokens = SplitString(tokens->at(5), L"|");
-	// Start at index 1 to skip the slider type byte.
-	for (UINT i = 1U; i < (UINT)sliderTokens.size(); i++) {
+	StringTokenizer sliderTokens(tokens->at(5), '|');
+
+	// The first token holds the slider type byte.
+	std::string_view sliderToken;
+	sliderTokens.Next(sliderToken);
+	std::string_view sliderTypeToken = sliderToken;
+
+	while (sliderTokens.Next(sliderToken)) {
 		// Split the point string into tokens that hold the point x and y values.
-		std::vector<std::wstring> pointTokens = SplitString(sliderTokens.at(i), L":");
+		StringTokens<2U> pointTokens(sliderToken, ':');
 
 		// Create a vec2f point from the point tokens.
-		vec2f point(std::stof(pointTokens.at(0)), std::stof(pointTokens.at(1)));
+		vec2f point;
+		ParseNumber(pointTokens.at(0), point.X);
+		ParseNumber(pointTokens.at(1), point.Y);
 
-		// Push the point the slider points vector.
+		// Push the point the slider points.
 		sliderPoints.push_back(point);
 	}
 
 	// Remove the last point back, if it is the same as the second to last one.
-	if (sliderPoints.at(sliderPoints.size() - 1U) == sliderPoints.at(sliderPoints.size() - 2U)) {
+	if (sliderPoints.size() > 1U && sliderPoints.at(sliderPoints.size() - 1U) == sliderPoints.at(sliderPoints.size() - 2U)) {
 		sliderPoints.pop_back();
 	}
 
 
 	// Get the slider type from the slider tokens.
-	m_sliderType = (BYTE)sliderTokens.at(0).front();
+	m_sliderType = (BYTE)sliderTypeToken.front();
+
+	// Use the path of an identical slider, if it was flattened before.
+	SliderPathCache& sliderPathCache = SliderPathCache::GetInstance();
+	SliderKey sliderKey(m_sliderType, sliderPoints.data(), (UINT)sliderPoints.size(), m_pixelLenght);
 
+	std::shared_ptr<const CachedSliderPath> cachedPath = sliderPathCache.Find(sliderKey);
+
+	if (cachedPath) {
+		m_sliderType = cachedPath->GetPathType();
+		m_firstPathPoint = sliderGeometry->AddPath(cachedPath->GetPath());
+		m_pathPointCount = cachedPath->GetPath().GetPointCount();
+	}
 	// Do the calculations for the correct slider type.
-	if (m_sliderType == 0x4C || m_sliderType == 0x43) {
-		// Slider is of type L'L' (0x4C) or L'C' (0x43).
+	// Every slider type is flattened into the same kind of slider path.
+	else if (m_sliderType == 0x4C) {
+		// Slider is of type L'L' (0x4C).
 		// This means the slider has only linear segments.
-		GetLinearSliderInfo(&sliderPoints);
+		GetLinearSliderInfo(sliderGeometry);
+	}
+	else if (m_sliderType == 0x43) {
+		// Slider is of type L'C' (0x43).
+		// This means the slider is a catmull-rom spline through the slider points.
+		GetCatmullSliderInfo(sliderGeometry);
 	}
-	else if (m_sliderType == 0x50 && sliderPoints.size() == 3U) {
-		// Slider is of type L'P' (0x50) and has exactly 3 points.
+	else if (m_sliderType == 0x50 && sliderPoints.size() == 3U && !IsCollinear(sliderPoints[0], sliderPoints[1], sliderPoints[2])) {
+		// Slider is of type L'P' (0x50) and has exactly 3 points that are not on one line.
 		// This means the slider has a circluar body.
-		GetCircularSliderInfo(&sliderPoints);
+		GetCircularSliderInfo(sliderGeometry);
 	}
 	else {
 		m_sliderType = 0x42;
 		// Slider type does not require specific calculations.
 		// And is set to L'B' (0x42).
 		// This means the slider body can be calculated using bezier curves.
-		GetBezierSliderInfo(&sliderPoints);
+		GetBezierSliderInfo(sliderGeometry);
 	}
+
+	if (!cachedPath) {
+		// Keep the path for identical sliders in other beatmaps.
+		sliderPathCache.Insert(sliderKey, m_sliderType, sliderGeometry->GetPath(m_firstPathPoint, m_pathPointCount));
+	}
+
+	// Add the head, ticks, repeats and tail of the slider to its timeline.
+	GetSliderTimeline(sliderGeometry);
 }
 
 // This function should only be called when the slider has only linear segements.
-// The function gets the segment points and stores it in the m_sliderSegemnts vector.
-void HitObject::GetLinearSliderInfo(_In_ std::vector<vec2f>* sliderPoints) {
-	for (UINT i = 1; i < (UINT)sliderPoints->size(); i++) {
-		// Create a segment with the slider points.
-		Segment seg({ sliderPoints->at(i - 1U), sliderPoints->at(i) });
+// The function stores the slider points as the slider path in the slider geometry.
+void ParsedHitObject::GetLinearSliderInfo(_Inout_ SliderGeometry* sliderGeometry) {
+	m_firstPathPoint = sliderGeometry->BeginPath();
 
-		// Push the segment to the slider segments vector.
-		m_sliderSegments.push_back(seg);
+	for (const vec2f& point : sliderGeometry->m_controlPoints) {
+		// Every slider point is a corner of the path.
+		sliderGeometry->AddPathPoint(point);
 	}
+
+	m_pathPointCount = sliderGeometry->EndPath(m_pixelLenght);
 }
 
 // This function should only be called when the slider has only circular segments.
-// The function calculates:
-//		Slider center				stores into m_sliderCenter.
-//		Slider starting angle		stores into m_startAngle.
-//		Slider ending angle			stores into m_endAngle.
-//		Slider radius				stores into m_sliderRadius.
-void HitObject::GetCircularSliderInfo(_In_ std::vector<vec2f>* sliderPoints) {
+// The function calculates the slider center, starting angle, ending angle and radius,
+// then flattens the arc into the slider path in the slider geometry.
+void ParsedHitObject::GetCircularSliderInfo(_Inout_ SliderGeometry* sliderGeometry) {
+	const vec2f* sliderPoints = sliderGeometry->m_controlPoints.data();
+
 	// Calculate slider center.
-	vec2f midA = sliderPoints->at(0).MidPoint(sliderPoints->at(1));
-	vec2f midB = sliderPoints->at(2).MidPoint(sliderPoints->at(1));
-	vec2f norA = sliderPoints->at(1).Copy().Sub(sliderPoints->at(0)).Nor();
-	vec2f norB = sliderPoints->at(1).Copy().Sub(sliderPoints->at(2)).Nor();
+	vec2f midA = sliderPoints[0].MidPoint(sliderPoints[1]);
+	vec2f midB = sliderPoints[2].MidPoint(sliderPoints[1]);
+	vec2f norA = sliderPoints[1].Copy().Sub(sliderPoints[0]).Nor();
+	vec2f norB = sliderPoints[1].Copy().Sub(sliderPoints[2]).Nor();
 
-	m_sliderCenter = Intersect(midA, norA, midB, norB);
+	vec2f sliderCenter = Intersect(midA, norA, midB, norB);
 
 	// Calculate the slider angles.
-	vec2f startAnglePoint = sliderPoints->at(0).Copy().Sub(m_sliderCenter);
-	vec2f midAnglePoint = sliderPoints->at(1).Copy().Sub(m_sliderCenter);
-	vec2f endAnglePoint = sliderPoints->at(2).Copy().Sub(m_sliderCenter);
+	vec2f startAnglePoint = sliderPoints[0].Copy().Sub(sliderCenter);
+	vec2f midAnglePoint = sliderPoints[1].Copy().Sub(sliderCenter);
+	vec2f endAnglePoint = sliderPoints[2].Copy().Sub(sliderCenter);
 
-	m_startAngle = atan2f(startAnglePoint.Y, startAnglePoint.X);
+	float startAngle = atan2f(startAnglePoint.Y, startAnglePoint.X);
 	float midAngle = atan2f(midAnglePoint.Y, midAnglePoint.X);
-	m_endAngle = atan2f(endAnglePoint.Y, endAnglePoint.X);
+	float endAngle = atan2f(endAnglePoint.Y, endAnglePoint.X);
 
 	// Correct the angles.
-	if (!IsInside(m_startAngle, midAngle, m_endAngle)) {
-		if (fabsf(m_startAngle + M_2PI - m_endAngle) < M_2PI && IsInside(m_startAngle + M_2PI, midAngle, m_endAngle)) {
-			m_startAngle += M_2PI;
+	if (!IsInside(startAngle, midAngle, endAngle)) {
+		if (fabsf(startAngle + M_2PI - endAngle) < M_2PI && IsInside(startAngle + M_2PI, midAngle, endAngle)) {
+			startAngle += M_2PI;
 		}
-		else if (fabsf(m_startAngle - (m_endAngle + M_2PI)) < M_2PI && IsInside(m_startAngle, midAngle, m_endAngle + M_2PI)) {
-			m_endAngle += M_2PI;
+		else if (fabsf(startAngle - (endAngle + M_2PI)) < M_2PI && IsInside(startAngle, midAngle, endAngle + M_2PI)) {
+			endAngle += M_2PI;
 		}
-		else if (fabsf(m_startAngle - M_2PI - m_endAngle) < M_2PI && IsInside(m_startAngle - M_2PI, midAngle, m_endAngle)) {
-			m_startAngle -= M_2PI;
+		else if (fabsf(startAngle - M_2PI - endAngle) < M_2PI && IsInside(startAngle - M_2PI, midAngle, endAngle)) {
+			startAngle -= M_2PI;
 		}
-		else if (fabsf(m_startAngle - (m_endAngle - M_2PI)) < M_2PI && IsInside(m_startAngle, midAngle, m_endAngle - M_2PI)) {
-			m_endAngle -= M_2PI;
+		else if (fabsf(startAngle - (endAngle - M_2PI)) < M_2PI && IsInside(startAngle, midAngle, endAngle - M_2PI)) {
+			endAngle -= M_2PI;
 		}
 		else {
 			// Something when wrong with correcting the angles.
@@ -240,113 +308,228 @@ void HitObject::GetCircularSliderInfo(_In_ std::vector<vec2f>* sliderPoints) {
 		}
 	}
 	// Last correction with the arcing angle.
-	if (m_endAngle > m_startAngle) {
-		m_endAngle = m_startAngle + (m_pixelLenght / startAnglePoint.Length());
+	if (endAngle > startAngle) {
+		endAngle = startAngle + (m_pixelLenght / startAnglePoint.Length());
 	}
 	else {
-		m_endAngle = m_startAngle - (m_pixelLenght / startAnglePoint.Length());
+		endAngle = startAngle - (m_pixelLenght / startAnglePoint.Length());
 	}
 
-	// Get the slider radius.
-	m_sliderRadius = startAnglePoint.Length();
+	// Flatten the arc into the slider path.
+	m_firstPathPoint = sliderGeometry->BeginPath();
+	sliderGeometry->AddArcSegment(sliderCenter, startAnglePoint.Length(), startAngle, endAngle);
+	m_pathPointCount = sliderGeometry->EndPath(m_pixelLenght);
 }
 
 // This function should be called when the slider has neither only linear or circular segments.
-// The function calculates the curves and stores the segments in the m_sliderSegments vector.
-void HitObject::GetBezierSliderInfo(_In_ std::vector<vec2f>* sliderPoints) {
-	std::vector<std::vector<vec2f>> curveList;
-	std::vector<vec2f> curve;
-
-	for (vec2f point : *sliderPoints) {
-		// Store the points in the curve.
-		if ((UINT)curve.size() > 1U) {
-			if (point == curve.at(curve.size() - 1U)) {
-				// Point is the last point in the curve.
-				// Store the curve in the curveList.
-				curveList.push_back(curve);
-				curve.clear();
-			}
+// The function splits the slider points into curves and flattens them into the slider path in the slider geometry.
+void ParsedHitObject::GetBezierSliderInfo(_Inout_ SliderGeometry* sliderGeometry) {
+	const vec2f* sliderPoints = sliderGeometry->m_controlPoints.data();
+	const UINT pointCount = (UINT)sliderGeometry->m_controlPoints.size();
+	UINT curveStart = 0U;
+
+	m_firstPathPoint = sliderGeometry->BeginPath();
+
+	for (UINT i = 0U; i < pointCount; i++) {
+		// A repeated point ends the curve, the point also starts the next curve.
+		if (i - curveStart > 1U && sliderPoints[i] == sliderPoints[i - 1U]) {
+			sliderGeometry->AddBezierSegment(Segment(sliderPoints + curveStart, i - curveStart));
+			curveStart = i;
 		}
-		curve.push_back(point);
 	}
-	// Store the remaining part of the curve in the curveList.
-	curveList.push_back(curve);
-	curve.clear();
+	// Flatten the remaining part of the curve.
+	sliderGeometry->AddBezierSegment(Segment(sliderPoints + curveStart, pointCount - curveStart));
+
+	m_pathPointCount = sliderGeometry->EndPath(m_pixelLenght);
+}
 
-	// Store the curves from the curveList in the slider segments.
-	for (Segment seg : curveList) {
-		m_sliderSegments.push_back(seg);
+
+// This function should only be called when the slider is a catmull-rom spline.
+// The function flattens the spline through the slider points into the slider path in the slider geometry.
+void ParsedHitObject::GetCatmullSliderInfo(_Inout_ SliderGeometry* sliderGeometry) {
+	m_firstPathPoint = sliderGeometry->BeginPath();
+	sliderGeometry->AddCatmullSegment(Segment(sliderGeometry->m_controlPoints.data(), (UINT)sliderGeometry->m_controlPoints.size()));
+	m_pathPointCount = sliderGeometry->EndPath(m_pixelLenght);
+}
+
+
+// This function should only be called when the slider path is made.
+// The function adds the events of the slider to its timeline in the slider geometry, in order of time.
+// Every span (repeat) goes along the path in the other direction, the ticks are on the same points of the
+// path in every span. So a reversed span meets them in the opposite order, mirrored in time.
+void ParsedHitObject::GetSliderTimeline(_Inout_ SliderGeometry* sliderGeometry) {
+	const SliderPath sliderPath = sliderGeometry->GetPath(m_firstPathPoint, m_pathPointCount);
+	std::vector<SliderEvent>& sliderEvents = sliderGeometry->m_sliderEvents;
+	const UINT spanCount = (std::max)(m_sliderRepeatCount, 1U);
+
+	// The ticks are at the same times (0.0 - 1.0) along the path in every span, a tick (almost) on the end of the path is not a tick.
+	std::vector<double>& tickTimes = sliderGeometry->m_tickTimes;
+	tickTimes.clear();
+	for (UINT tick = 1U; static_cast<float>(tick) < m_sliderTickCount - m_tickEndMargin; tick++) {
+		tickTimes.push_back(static_cast<double>(tick) / static_cast<double>(m_sliderTickCount));
 	}
+	const UINT tickCount = (UINT)tickTimes.size();
+
+	// Find the points of the ticks once, sorted from the start to the end of the path.
+	std::vector<vec2f>& tickPoints = sliderGeometry->m_tickPoints;
+	tickPoints.resize(tickCount);
+	sliderPath.GetPointsByT(tickTimes.data(), tickCount, tickPoints.data());
+
+	m_firstSliderEvent = (UINT)sliderEvents.size();
+	sliderEvents.push_back(SliderEvent(SliderEvent::Head, m_startTime, sliderPath.GetPointByT(0.0)));
+
+	for (UINT span = 0U; span < spanCount; span++) {
+		const bool reversed = span % 2U == 1U;
+		const int spanStartTime = m_startTime + m_sliderTime * (INT)span;
+
+		for (UINT tick = 0U; tick < tickCount; tick++) {
+			// A reversed span starts at the end of the path, at the last tick.
+			const UINT pathTick = reversed ? tickCount - 1U - tick : tick;
+			const double spanTime = reversed ? 1.0 - tickTimes[pathTick] : tickTimes[pathTick];
+			int time = spanStartTime + (INT)round(spanTime * static_cast<double>(m_sliderTime));
+
+			sliderEvents.push_back(SliderEvent(SliderEvent::Tick, time, tickPoints[pathTick]));
+		}
+
+		// The end of the span.
+		const bool lastSpan = span == spanCount - 1U;
+		sliderEvents.push_back(SliderEvent(
+			lastSpan ? SliderEvent::Tail : SliderEvent::Repeat,
+			lastSpan ? m_endTime : spanStartTime + m_sliderTime,
+			sliderPath.GetPointByT(reversed ? 0.0 : 1.0)
+		));
+	}
+
+	m_sliderEventCount = (UINT)sliderEvents.size() - m_firstSliderEvent;
+	m_endPosition = sliderEvents.back().m_position;
 }
 
 
 // This function should only be called when the object is a spinner.
-// The function gets the end time of the spinner and stores it in the HitObject class.
-void HitObject::GetSpinnerInfo(_In_ std::vector<std::wstring>* tokens) {
+// The function gets the end time of the spinner and stores it in the parsed hit object.
+void ParsedHitObject::GetSpinnerInfo(_In_ const HitObjectTokens* tokens) {
 	// Get the spinner end time.
-	m_endTime = _wtoi(tokens->at(5).c_str());
+	ParseNumber(tokens->at(5), m_endTime);
 }
 
 
-// This function is used to get the point on a slider at a specified time.
-vec2f HitObject::GetPointByT(_In_ const double& time) const {
-	double pointTime = time; //static_cast<int>(floor(time)) % 2 == 0 ? time - floor(time) : floor(time) + 1.0 - time;
+// This function reserves room in every array for the hit objects.
+void HitObjectTable::Reserve(_In_ const size_t& hitObjectCount) {
+	m_startTimes.reserve(hitObjectCount);
+	m_endTimes.reserve(hitObjectCount);
+	m_objectTypes.reserve(hitObjectCount);
+	m_startPositions.reserve(hitObjectCount);
+	m_stackIndices.reserve(hitObjectCount);
+	m_sliderDetails.reserve(hitObjectCount);
+}
+
+// This function adds the parsed hit object to the end of the table.
+// Its slider path and timeline should be in the slider geometry of the table.
+void HitObjectTable::Add(_In_ const ParsedHitObject& hitObject) {
+	m_startTimes.push_back(hitObject.m_startTime);
+	m_endTimes.push_back(hitObject.GetEndTime());
+	m_objectTypes.push_back(static_cast<BYTE>(hitObject.GetObjectType()));
+	m_startPositions.push_back(hitObject.m_startPosition);
+	m_stackIndices.push_back(hitObject.m_stackIndex);
+
+	SliderDetails sliderDetails;
+	sliderDetails.m_endPosition = hitObject.m_endPosition;
+	sliderDetails.m_sliderTime = hitObject.m_sliderTime;
+	sliderDetails.m_sliderTickCount = hitObject.m_sliderTickCount;
+	sliderDetails.m_sliderRepeatCount = hitObject.m_sliderRepeatCount;
+	sliderDetails.m_firstPathPoint = hitObject.m_firstPathPoint;
+	sliderDetails.m_pathPointCount = hitObject.m_pathPointCount;
+	sliderDetails.m_firstSliderEvent = hitObject.m_firstSliderEvent;
+	sliderDetails.m_sliderEventCount = hitObject.m_sliderEventCount;
+	m_sliderDetails.push_back(sliderDetails);
+}
 
-	if (m_sliderType == 0x50) {
-		// Slider has a circluar body.
-		// Construct a point using unit circle calculus.
-		float angle = m_startAngle * static_cast<float>(1.0 - pointTime) + m_endAngle * static_cast<float>(pointTime);
-		return vec2f(m_sliderCenter.X + m_sliderRadius * cosf(angle), m_sliderCenter.Y + m_sliderRadius * sinf(angle));
+// This function appends the hit objects and slider geometry of the other table to the end of this table.
+// The path lenghts are relative to the start of each path, only the path and event indices move.
+void HitObjectTable::Append(_In_ const HitObjectTable& hitObjects) {
+	const UINT firstPathPoint = (UINT)m_sliderGeometry.m_pathPoints.size();
+	const UINT firstSliderEvent = (UINT)m_sliderGeometry.m_sliderEvents.size();
+
+	m_startTimes.insert(m_startTimes.end(), hitObjects.m_startTimes.begin(), hitObjects.m_startTimes.end());
+	m_endTimes.insert(m_endTimes.end(), hitObjects.m_endTimes.begin(), hitObjects.m_endTimes.end());
+	m_objectTypes.insert(m_objectTypes.end(), hitObjects.m_objectTypes.begin(), hitObjects.m_objectTypes.end());
+	m_startPositions.insert(m_startPositions.end(), hitObjects.m_startPositions.begin(), hitObjects.m_startPositions.end());
+	m_stackIndices.insert(m_stackIndices.end(), hitObjects.m_stackIndices.begin(), hitObjects.m_stackIndices.end());
+
+	for (SliderDetails sliderDetails : hitObjects.m_sliderDetails) {
+		// Point the hit object to its path and timeline in this geometry.
+		sliderDetails.m_firstPathPoint += firstPathPoint;
+		sliderDetails.m_firstSliderEvent += firstSliderEvent;
+		m_sliderDetails.push_back(sliderDetails);
 	}
 
-	// For other slider types do:
+	const SliderGeometry& sliderGeometry = hitObjects.m_sliderGeometry;
+	m_sliderGeometry.m_pathPoints.insert(m_sliderGeometry.m_pathPoints.end(), sliderGeometry.m_pathPoints.begin(), sliderGeometry.m_pathPoints.end());
+	m_sliderGeometry.m_pathLenghts.insert(m_sliderGeometry.m_pathLenghts.end(), sliderGeometry.m_pathLenghts.begin(), sliderGeometry.m_pathLenghts.end());
+	m_sliderGeometry.m_sliderEvents.insert(m_sliderGeometry.m_sliderEvents.end(), sliderGeometry.m_sliderEvents.begin(), sliderGeometry.m_sliderEvents.end());
+}
 
-	// Check if m_sliderSegments is valid.
-	vec2f oldPoint;
-	try {
-		oldPoint = m_sliderSegments.at(0).m_points.at(0);
-	}
-	catch (...) {
-		// Something went wrong with accessing the first point in the slider segment vector.
+
+// This function is used to get the point on a slider at a specified time.
+// The time (0.0 - 1.0) is clamped, earlier times return the start and later times the end of the slider.
+// Every slider type is flattened into a slider path, so all types take the same path lookup.
+vec2f HitObject::GetPointByT(_In_ const double& time) const {
+	double pointTime = CLAMP(0.0, time, 1.0);
+
+	// Check if the slider path is valid.
+	if (GetSliderDetails().m_pathPointCount == 0U) {
+		// The object has no slider path.
 		// TODO: Thow error if needed.
-		OutputDebugStringW(L"ERROR: oldPoint (sliderSegments) failed!\n");
+		OutputDebugStringW(L"ERROR: GetPointByT (sliderPath) failed!\n");
 
 		// Return from the function with a pre-determined point.
 		return GetStartPosition();
 	}
 
-	double currentDistance = 0.0;
-	double pointPixelLength = (DOUBLE)m_pixelLenght * pointTime;
+	// Find the point on the flattened slider path.
+	return GetSliderPath().GetPointByT(pointTime);
+}
 
-	for (auto seg : m_sliderSegments) {
-		if (seg == m_sliderSegments.back()) {
-			double currentTime = 0.0;
-			while (currentDistance < m_pixelLenght) {
-				vec2f p = GetPointOnBezier(seg.m_points, currentTime);
-				currentDistance += (oldPoint - p).Length();
+// This function finds the points on the slider at the times (0.0 - 1.0) in one sweep along the slider path.
+// The times should be sorted from low to high, times outside of 0.0 - 1.0 give the start and end of the path.
+void HitObject::GetPointsByT(_In_ const double* times, _In_ const UINT& timeCount, _Out_ vec2f* points) const {
+	// Check if the slider path is valid.
+	if (GetSliderDetails().m_pathPointCount == 0U) {
+		// The object has no slider path.
+		// TODO: Thow error if needed.
+		OutputDebugStringW(L"ERROR: GetPointsByT (sliderPath) failed!\n");
 
-				if (currentDistance > pointPixelLength) {
-					return oldPoint;
-				}
+		// Return from the function with pre-determined points.
+		std::fill(points, points + timeCount, GetStartPosition());
+		return;
+	}
 
-				oldPoint = p;
-				currentTime += 1.0 / static_cast<double>(seg.m_points.size() * 50U - 1U);
-			}
-		}
+	GetSliderPath().GetPointsByT(times, timeCount, points);
+}
 
-		for (double currentTime = 0.0; currentTime < 1.0 + (1.0 / static_cast<double>(seg.m_points.size() * 50U - 1U)); currentTime += (1.0 / static_cast<double>(seg.m_points.size() * 50U - 1U))) {
-			vec2f p = GetPointOnBezier(seg.m_points, currentTime);
 
-			currentDistance += (oldPoint - p).Length();
-			if (currentDistance > pointPixelLength) {
-				return oldPoint;
-			}
+// This function starts following the slider from its head.
+void SliderFollower::Follow(_In_ const HitObject& slider) {
+	m_slider = slider;
+	m_cursor = SliderPathCursor(slider.GetSliderPath());
+	m_pathLenght = slider.GetSliderPath().GetLenght();
+}
 
-			oldPoint = p;
-		}
+// This function returns the point on the slider at the song time.
+// The repeats go back and forth along the slider path, the point stays on the tail after the slider ends.
+vec2f SliderFollower::GetPointAtTime(_In_ const double& songTime) {
+	// A slider shorter than a millisecond has no time to move along, stay on its head.
+	if (m_slider.GetSliderTime() <= 0) {
+		return m_slider.GetStartPosition();
 	}
 
-	return oldPoint;
+	// Calculate the time (0.0 - 1.0), slider repeats are handled after.
+	double time = (songTime - m_slider.GetStartTime()) / m_slider.GetSliderTime();
+	time = CLAMP(0.0, time, (DOUBLE)m_slider.GetSliderRepeatCount());
+	time = static_cast<int>(floor(time)) % 2 == 0 ? time - floor(time) : floor(time) + 1.0 - time;
+	time = CLAMP(0.0, time, 1.0);
+
+	return m_cursor.GetPointAtLenght(static_cast<float>(time) * m_pathLenght);
 }
 
 
@@ -355,7 +538,7 @@ vec2f HitObject::GetPointByT(_In_ const double& time) const {
 //		HITOBJECT_CIRCLE	with value 1
 //		HITOBJECT_SLIDER	with value 2
 //		HITOBJECT_SPINNER	with value 8
-int HitObject::GetObjectType() const {
+int ParsedHitObject::GetObjectType() const {
 	if ((m_objectType & 2) > 0) {
 		// The object is a slider.
 		return HITOBJECT_SLIDER;
@@ -370,21 +553,10 @@ int HitObject::GetObjectType() const {
 	}
 }
 
-// This function is used to get the end position of the object.
-// If the object type is NOT a slider, return the start position instead.
-vec2f HitObject::GetEndPosition() const {
-	if (GetObjectType() == HITOBJECT_SLIDER) {
-		// Object is a slider, return the slider end position.
-		return GetPointByT(static_cast<const float>(GetSliderRepeatCount()));
-	}
-	// Object is not a slider, return the start position of the object.
-	return GetStartPosition();
-}
-
 // This function is used to get the end time of the object.
 // If the object type is a circle, return the start time instead.
 // NOTE: circles don't have an end time specified.
-int HitObject::GetEndTime() const {
+int ParsedHitObject::GetEndTime() const {
 	if (GetObjectType() != HITOBJECT_CIRCLE) {
 		// Object is a slider, return the slider end time.
 		return m_endTime;
@@ -396,284 +568,488 @@ int HitObject::GetEndTime() const {
 
 // This function should be called to parse the beatmap information
 // then optionaly pushing the beatmap to a queue.
-bool Beatmap::ParseBeatmap() {
-	// Create a index for the headers.
-	UINT headerIndex = 0U;
-
-	if (m_beatmapFile != nullptr) {
-		// Open success, start reading.
-		while (TRUE) {
-			if (feof(m_beatmapFile)) {
-				// End of file.
-				// TODO: Send a notifier if needed.
-
-				// Return early from the function.
-				break;
-			}
-			else {
-				// Find the headers.
-				if (FindHeader(headerIndex)) {
-					// Read the keys under the header.
-					ReadKeysUnderHeader(headerIndex);
-
-					// Set index for the next header.
-					headerIndex++;
-
-					// Reset all header flags.
-					m_headerGeneral = FALSE;
-					m_headerEditor = FALSE;
-					m_headerMetadata = FALSE;
-					m_headerDifficulty = FALSE;
-					m_headerTimingPoints = FALSE;
-					m_headerColours = FALSE;
-					m_headerHitObjects = FALSE;
-				}
-			}
-		}
+// The file is mapped into memory and read once from top to bottom, every header
+// switches the section that the following lines are dispatched to.
+// A beatmap that was parsed before is loaded from the beatmap cache instead,
+// without the beatmap cache the compiled beatmap is neither read nor written.
+bool Beatmap::ParseBeatmap(_In_opt_ const bool& useBeatmapCache) {
+	// Load the compiled beatmap, if the beatmap file didn't change since it was parsed.
+	BeatmapCache beatmapCache(m_filePath);
+	if (useBeatmapCache && beatmapCache.LoadBeatmap(this)) {
+		return TRUE;
 	}
-	else {
-		// Couldn't open file, reset the FILE.
+
+	// Map the beatmap file, the UTF-8 content is parsed in place.
+	MappedFile beatmapFile(m_filePath);
+	if (!beatmapFile.IsOpen()) {
+		// Couldn't open file, return.
 		return FALSE;
 	}
 
-	// After parsing, there needs to be some calculations done for the stacking of the HitObjects.
-	// TODO: Make a correctly working one this time :stuck_out_tongue_winking_eye:
+	std::string_view content = beatmapFile.GetView();
+	std::string_view readLine;
 
-	// (The calculations in V2 didn't seem to be correctly working.)
-	// This shouldn't have a too large impact on the autoplaying.
+	// Skip the UTF-8 byte order mark.
+	if (content.compare(0U, 3U, "\xEF\xBB\xBF") == 0) {
+		content.remove_prefix(3U);
+	}
 
+	// Hit objects need the timing points and the difficulty values,
+	// their lines are collected and parsed after the file is read.
+	std::vector<std::string_view> hitObjectLines;
 
-	// Calculate the stacking offset with the circle size.
-	m_stackOffset = ((512.0f / 16.0f) * (1.0f - 0.7f * (m_circleSize - 5.0f) / 5.0f) / 10.0f) / m_circleSize;
+	// Lines before the first header (the file format version) are skipped.
+	UINT headerIndex = beatmapHeaders::count;
 
-	return TRUE;
-}
-
-// This function is used to find a header in a opened beatmap.
-bool Beatmap::FindHeader(_In_ const UINT& headerIndex) {
-	// Create a buffer to assign.
-	std::wstring readLine;
-	LPWSTR lpReadLine = new wchar_t[MAX_READSTRING];
+	while (ReadBeatmapLine(content, readLine)) {
+		if (readLine.empty()) {
+			// Empty line, read next line.
+			continue;
+		}
 
-	// Reset the cursor position.
-	fpos_t fpos = 0U;
-	fsetpos(m_beatmapFile, &fpos);
+		if (readLine.front() == '[') {
+			// A new header starts.
+			// Unknown headers (Events) return count, so their lines are skipped.
+			headerIndex = FindHeader(readLine);
+			continue;
+		}
 
+		// Read the line under the current header.
+		switch (headerIndex) {
+		case beatmapHeaders::General:
+		case beatmapHeaders::Editor:
+		case beatmapHeaders::Metadata:
+		case beatmapHeaders::Difficulty:
+			ReadKeyValue(headerIndex, readLine);
+			break;
 
-	// Find the header at the array with the index.
-	while (readLine.find(headerStrings[headerIndex]) == std::wstring::npos) {
-		if (feof(m_beatmapFile)) {
-			// End of file, return false.
+		case beatmapHeaders::TimingPoints:
+			if (readLine.find(',') != std::string_view::npos) {
+				m_timingPoints.push_back(TimingPoint(readLine));
+			}
+			break;
 
-			delete lpReadLine;
-			return FALSE;
-		}
-		else {
-			// Read a new line.
-			auto debugstr = fgetws(lpReadLine, MAX_READSTRING, m_beatmapFile);
-			readLine.assign(lpReadLine);
+		case beatmapHeaders::HitObjects:
+			if (readLine.find(',') != std::string_view::npos) {
+				hitObjectLines.push_back(readLine);
+			}
+			break;
 		}
 	}
 
-	// Header found, flag the header.
-	switch (headerIndex) {
-	case beatmapHeaders::General:
-		m_headerGeneral = TRUE;
-		break;
-
-	case beatmapHeaders::Editor:
-		m_headerEditor = TRUE;
-		break;
+	// Sort the timing points and resolve their beat lenghts, before the sliders use them.
+	ResolveTimingPoints();
 
-	case beatmapHeaders::Metadata:
-		m_headerMetadata = TRUE;
-		break;
+	// Parse the hit objects.
+	ParseHitObjects(hitObjectLines);
 
-	case beatmapHeaders::Difficulty:
-		m_headerDifficulty = TRUE;
-		break;
+	// Stack the hit objects that are (almost) on the same position close in time.
+	CalculateStacking();
 
-	case beatmapHeaders::TimingPoints:
-		m_headerTimingPoints = TRUE;
-		break;
+	// Calculate the stacking offset (in osu!pixels per stack index) with the circle size.
+	m_stackOffset = (512.0f / 16.0f) * (1.0f - 0.7f * (m_circleSize - 5.0f) / 5.0f) / 10.0f;
 
-	case beatmapHeaders::Colours:
-		m_headerColours = TRUE;
-		break;
-
-	case beatmapHeaders::HitObjects:
-		m_headerHitObjects = TRUE;
-		break;
+	// Store the parsed beatmap, failing to do so only means it is parsed again next time.
+	beatmapFile.Close();
+	if (useBeatmapCache) {
+		beatmapCache.SaveBeatmap(this);
 	}
 
-	delete lpReadLine;
 	return TRUE;
 }
 
-// This function reads the values under the specified header from the beatmap.
-void Beatmap::ReadKeysUnderHeader(_In_ UINT& headerIndex) {
-	// Create a buffer to assign.
-	LPWSTR lpReadLine = new wchar_t[MAX_READSTRING];
-	std::wstring readLine;
+// This function sets the most threads that parse the hit objects of every beatmap.
+void Beatmap::SetParseThreadCount(_In_ const UINT& threadCount) {
+	parseThreadCount = threadCount;
+}
+
+// This function sorts the timing points by time and resolves their beat lenghts.
+// Timing points at the same time keep their order in the file.
+void Beatmap::ResolveTimingPoints() {
+	std::stable_sort(m_timingPoints.begin(), m_timingPoints.end(), [](const TimingPoint& lhs, const TimingPoint& rhs) {
+		return lhs.GetTime() < rhs.GetTime();
+	});
 
-	// Calculate next header index (don't if next index out of range).
-	UINT nextIndex = headerIndex;
-	if (headerIndex + 1U != beatmapHeaders::count) {
-		nextIndex = headerIndex + 1U;
+	if (m_timingPoints.empty()) {
+		return;
 	}
 
-	// Read until the next header.
-	while (readLine.find(headerStrings[nextIndex]) == std::wstring::npos) {
-		if (feof(m_beatmapFile)) {
-			// End of file, return.
-			return;
+	// Until the first uninherited timing point, the first timing point is used as base.
+	float beatLenghtBase = m_timingPoints.front().GetBpm();
+	for (TimingPoint& timingPoint : m_timingPoints) {
+		if (timingPoint.GetBpm() >= 0.f) {
+			// Uninherited timing point, it is the base of the following timing points.
+			beatLenghtBase = timingPoint.GetBpm();
 		}
-		else {
-			// Read a new line.
-			auto debugstr = fgetws(lpReadLine, MAX_READSTRING, m_beatmapFile);
-			readLine.assign(lpReadLine);
+		timingPoint.ResolveBeatLenght(beatLenghtBase);
+	}
+}
+
+// This function parses the hit object lines into the hit objects, in order.
+// Large sections are split into line-aligned chunks that are parsed on their own thread,
+// every chunk gets its own hit object table which is appended to the beatmap table afterwards.
+// The result is the same as parsing the lines one after another.
+void Beatmap::ParseHitObjects(_In_ const std::vector<std::string_view>& hitObjectLines) {
+	// Use one thread for every minHitObjectsPerThread lines, up to one thread per core.
+	const UINT maxThreadCount = parseThreadCount ? parseThreadCount.load() : std::thread::hardware_concurrency();
+	const UINT threadCount = (std::min)(maxThreadCount, (UINT)hitObjectLines.size() / minHitObjectsPerThread);
+
+	HitObjectTable* hitObjects = m_hitObjects.get();
+	hitObjects->Reserve(hitObjects->GetCount() + hitObjectLines.size());
+
+	if (threadCount <= 1U) {
+		// Parse the lines on this thread.
+		for (std::string_view hitString : hitObjectLines) {
+			hitObjects->Add(ParsedHitObject(hitString, &m_timingPoints, m_sliderMultiplier, m_sliderTickRate, &hitObjects->m_sliderGeometry));
 		}
+		return;
+	}
 
-		// Read the keys under the current header, if the header was found.
-		switch (headerIndex) {
-		case beatmapHeaders::General:
-			if (m_headerGeneral) {
-				if (readLine.find(L"StackLeniency") != std::wstring::npos) {
-					m_stackLeniency = std::stof(GetValueString(&readLine));
-				}
-				else if (readLine.find(L"Mode") != std::wstring::npos) {
-					m_gameMode = std::stoi(GetValueString(&readLine));
-				}
+	// The hit objects and exception (if any) of a chunk.
+	struct HitObjectChunk {
+		HitObjectTable hitObjects;
+		std::exception_ptr exception;
+	};
+	std::vector<HitObjectChunk> chunks(threadCount);
+
+	auto parseChunk = [&](UINT chunkIndex) {
+		HitObjectChunk& chunk = chunks[chunkIndex];
+		const size_t firstLine = hitObjectLines.size() * chunkIndex / threadCount;
+		const size_t lastLine = hitObjectLines.size() * (chunkIndex + 1U) / threadCount;
+
+		try {
+			chunk.hitObjects.Reserve(lastLine - firstLine);
+			for (size_t i = firstLine; i < lastLine; i++) {
+				chunk.hitObjects.Add(ParsedHitObject(hitObjectLines[i], &m_timingPoints, m_sliderMultiplier, m_sliderTickRate, &chunk.hitObjects.m_sliderGeometry));
 			}
-			break;
+		}
+		catch (...) {
+			// Pass the exception to the calling thread.
+			chunk.exception = std::current_exception();
+		}
+	};
 
-		case beatmapHeaders::Editor:
-			if (m_headerEditor) {
-				if (readLine.find(L"BeatDivisor") != std::wstring::npos) {
-					m_beatDivisor = std::stof(GetValueString(&readLine));
-				}
-			}
-			break;
+	// Parse the first chunk on this thread, while the others are parsed on their own thread.
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1U);
+	for (UINT i = 1U; i < threadCount; i++) {
+		threads.emplace_back(parseChunk, i);
+	}
+	parseChunk(0U);
 
-		case beatmapHeaders::Metadata:
-			if (m_headerMetadata) {
-				if (readLine.find(L"Title") != std::wstring::npos) {
-					if (readLine.find(L"Unicode") == std::wstring::npos) {
-						m_title = GetValueString(&readLine);
-					}
-				}
-				else if (readLine.find(L"Artist") != std::wstring::npos) {
-					if (readLine.find(L"Unicode") == std::wstring::npos) {
-						m_artist = GetValueString(&readLine);
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	// Merge the chunks in order.
+	for (HitObjectChunk& chunk : chunks) {
+		if (chunk.exception) {
+			// Parsing failed, throw the first exception like parsing on one thread would.
+			std::rethrow_exception(chunk.exception);
+		}
+
+		hitObjects->Append(chunk.hitObjects);
+	}
+}
+
+// This function calculates the stack index of every hit object, like osu! does.
+// Going back from the last hit object, the hit objects before it (within the stack leniency
+// part of the approach time) at the same position are stacked on it. osu! compares every
+// hit object with every hit object in that time window, here the hit objects at the same
+// position in a long time window are found in a grid, so a dense map takes about the same time per hit object.
+// This is the stacking of file format v6 and newer, the hit objects should be in order of start time.
+void Beatmap::CalculateStacking() {
+	HitObjectTable* hitObjects = m_hitObjects.get();
+	const UINT hitObjectCount = hitObjects->GetCount();
+	const int* startTimes = hitObjects->m_startTimes.data();
+	const int* endTimes = hitObjects->m_endTimes.data();
+	const BYTE* objectTypes = hitObjects->m_objectTypes.data();
+	const vec2f* startPositions = hitObjects->m_startPositions.data();
+	int* stackIndices = hitObjects->m_stackIndices.data();
+	std::fill(hitObjects->m_stackIndices.begin(), hitObjects->m_stackIndices.end(), 0);
+
+	// The approach (preempt) time of the approach rate and the stack time window.
+	const double preemptTime = m_approachRate > 5.f ? 1200.0 - 750.0 * (m_approachRate - 5.f) / 5.0 : 1200.0 + 600.0 * (5.f - m_approachRate) / 5.0;
+	const double stackThreshold = preemptTime * m_stackLeniency;
+
+	// The start positions of all hit objects, and the end positions of the sliders.
+	HitObjectGrid startGrid(hitObjects, FALSE, stackDistance);
+	HitObjectGrid sliderEndGrid(hitObjects, TRUE, stackDistance);
+
+	auto isNotSpinner = [objectTypes](UINT index) { return objectTypes[index] != HITOBJECT_SPINNER; };
+	auto isCircle = [objectTypes](UINT index) { return objectTypes[index] == HITOBJECT_CIRCLE; };
+	auto anyHitObject = [](UINT) { return TRUE; };
+
+	// Returns the first hit object before last that doesn't start more than the stack threshold before the time.
+	// The search goes down from last in growing steps, the time window is usually a few hit objects.
+	auto findWindowStart = [&](const int& time, const UINT& last) {
+		auto isBefore = [&](const int& startTime) { return time - startTime > stackThreshold; };
+		UINT end = last;
+		UINT step = 1U;
+		while (end > step && !isBefore(startTimes[end - step])) {
+			end -= step;
+			step *= 2U;
+		}
+		const UINT begin = (end > step) ? end - step : 0U;
+		return (UINT)(std::partition_point(startTimes + begin, startTimes + end, isBefore) - startTimes);
+	};
+
+	for (UINT i = hitObjectCount - 1U; i > 0U && i < hitObjectCount; i--) {
+		if (stackIndices[i] != 0 || objectTypes[i] == HITOBJECT_SPINNER) {
+			// Already stacked on a later hit object, or a spinner.
+			continue;
+		}
+
+		// The hit object that is stacked on, the hit objects before last are searched.
+		UINT stackTop = i;
+		UINT last = i;
+
+		if (objectTypes[i] == HITOBJECT_CIRCLE) {
+			while (last > 0U) {
+				// osu! stops at the first hit object (not a spinner) that ends more than the stack threshold before the stack top.
+				// Only hit objects that start that long before it can, most of them also end before it.
+				UINT first = 0U;
+				for (UINT n = (std::min)(findWindowStart(startTimes[stackTop], last), last); n > 0U; n--) {
+					if (objectTypes[n - 1U] != HITOBJECT_SPINNER && startTimes[stackTop] - endTimes[n - 1U] > stackThreshold) {
+						first = n;
+						break;
 					}
 				}
-				else if (readLine.find(L"Creator") != std::wstring::npos) {
-					m_creator = GetValueString(&readLine);
-				}
-				else if (readLine.find(L"Version") != std::wstring::npos) {
-					m_version = GetValueString(&readLine);
-				}
-				else if (readLine.find(L"BeatmapID") != std::wstring::npos) {
-					m_beatmapID = (UINT)std::stoi(GetValueString(&readLine));
-				}
-			}
-			break;
 
-		case beatmapHeaders::Difficulty:
-			if (m_headerDifficulty) {
-				if (readLine.find(L"CircleSize") != std::wstring::npos) {
-					m_circleSize = std::stof(GetValueString(&readLine));
-				}
-				else if (readLine.find(L"OverallDifficulty") != std::wstring::npos) {
-					m_overallDifficulty = std::stof(GetValueString(&readLine));
-				}
-				else if (readLine.find(L"ApproachRate") != std::wstring::npos) {
-					m_approachRate = std::stof(GetValueString(&readLine));
+				// The last hit object that starts on the stack top, and a slider that ends on it (not before that hit object).
+				const UINT stackIndex = startGrid.FindLast(startPositions[stackTop], stackDistance, first, last, isNotSpinner);
+				const UINT sliderIndex = sliderEndGrid.FindLast(startPositions[stackTop], stackDistance, (stackIndex == HitObjectGrid::noHitObject) ? first : stackIndex, last, anyHitObject);
+
+				if (sliderIndex != HitObjectGrid::noHitObject) {
+					// The stack is on the slider tail, move the hit objects on the tail the other way.
+					const int offset = stackIndices[stackTop] - stackIndices[sliderIndex] + 1;
+					startGrid.ForEach(hitObjects->m_sliderDetails[sliderIndex].m_endPosition, stackDistance, sliderIndex + 1U, i + 1U, [&](UINT index) {
+						stackIndices[index] -= offset;
+					});
+					break;
 				}
-				else if (readLine.find(L"SliderMultiplier") != std::wstring::npos) {
-					m_sliderMultiplier = std::stof(GetValueString(&readLine));
+				else if (stackIndex == HitObjectGrid::noHitObject) {
+					// Nothing is stacked on the stack top.
+					break;
 				}
-				else if (readLine.find(L"SliderTickRate") != std::wstring::npos) {
-					m_sliderTickRate = std::stof(GetValueString(&readLine));
-				}
-			}
-			break;
 
-		case beatmapHeaders::TimingPoints:
-			if (m_headerTimingPoints) {
-				if (readLine.find(L',') != std::wstring::npos) {
-					m_timingPoints.push_back(TimingPoint(readLine));
-				}
+				stackIndices[stackIndex] = stackIndices[stackTop] + 1;
+				stackTop = stackIndex;
+				last = stackIndex;
 			}
-			break;
-
-		case beatmapHeaders::HitObjects:
-			if (m_headerHitObjects) {
-				if (readLine.find(L',') != std::wstring::npos) {
-					m_hitObjects.push_back(HitObject(readLine, &m_timingPoints, m_sliderMultiplier, m_sliderTickRate));
+		}
+		else if (objectTypes[i] == HITOBJECT_SLIDER) {
+			while (last > 0U) {
+				// osu! stops at the first hit object that starts more than the stack threshold before the stack top.
+				const UINT first = findWindowStart(startTimes[stackTop], last);
+
+				// The last hit object that ends on the stack top, circles end where they start.
+				const UINT circleIndex = startGrid.FindLast(startPositions[stackTop], stackDistance, first, last, isCircle);
+				const UINT sliderIndex = sliderEndGrid.FindLast(startPositions[stackTop], stackDistance, (circleIndex == HitObjectGrid::noHitObject) ? first : circleIndex, last, anyHitObject);
+				const UINT stackIndex = (sliderIndex == HitObjectGrid::noHitObject) ? circleIndex : sliderIndex;
+
+				if (stackIndex == HitObjectGrid::noHitObject) {
+					// Nothing is stacked on the stack top.
+					break;
 				}
+
+				stackIndices[stackIndex] = stackIndices[stackTop] + 1;
+				stackTop = stackIndex;
+				last = stackIndex;
 			}
-			break;
 		}
 	}
-	delete lpReadLine;
 }
 
-// Returns a string of the value from a key-value string (the immediate string from a beatmap).
-std::wstring Beatmap::GetValueString(_In_ const std::wstring* readLine) const {
-	auto str = readLine->substr(readLine->find(L":") + 1U);
+// This function takes the next line from the content into readLine.
+// The line ending is removed, readLine points into the content.
+// Returns FALSE when there are no more lines to read.
+bool Beatmap::ReadBeatmapLine(_Inout_ std::string_view& content, _Out_ std::string_view& readLine) {
+	if (content.empty()) {
+		// End of file.
+		return FALSE;
+	}
 
-	// Pop back the endline character.
-	if (str.back() == L'\n') {
-		str.pop_back();
+	// Split the content at the line ending.
+	size_t lineEnd = content.find('\n');
+	if (lineEnd == std::string_view::npos) {
+		// The last line of the file has no line ending.
+		readLine = content;
+		content = std::string_view();
+	}
+	else {
+		readLine = content.substr(0U, lineEnd);
+		content.remove_prefix(lineEnd + 1U);
+	}
+
+	// Pop back the carriage return.
+	if (!readLine.empty() && readLine.back() == '\r') {
+		readLine.remove_suffix(1U);
 	}
 
-	return str;
+	return TRUE;
 }
 
+// This function returns the index of the header on the line.
+// Returns beatmapHeaders::count if the line is not a known header.
+UINT Beatmap::FindHeader(_In_ std::string_view readLine) const {
+	for (UINT i = 0U; i < beatmapHeaders::count; i++) {
+		if (readLine.compare(0U, headerStrings[i].size(), headerStrings[i]) == 0) {
+			// Header found.
+			return i;
+		}
+	}
+
+	// Not a header the bot uses.
+	return beatmapHeaders::count;
+}
 
-// This function should be used to get a pointer to the hit object at specified time.
-const HitObject* Beatmap::FindHitObjectAtT(_In_ const double& songTime) const {
-	for (auto object = m_hitObjects.begin(); object != m_hitObjects.end(); ++object) {
-		if (object->GetStartTime() >= songTime && object->GetObjectType() == HITOBJECT_CIRCLE) {
+// This function reads a key-value line (the immediate string from a beatmap)
+// under the specified header and stores the value.
+void Beatmap::ReadKeyValue(_In_ const UINT& headerIndex, _In_ std::string_view readLine) {
+	size_t delimiter = readLine.find(':');
+	if (delimiter == std::string_view::npos) {
+		// Not a key-value line.
+		return;
+	}
+
+	// Split the line into the key and the value.
+	std::string_view key = readLine.substr(0U, delimiter);
+	std::string_view value = readLine.substr(delimiter + 1U);
+
+	while (!key.empty() && key.back() == ' ') {
+		key.remove_suffix(1U);
+	}
+	while (!value.empty() && value.front() == ' ') {
+		value.remove_prefix(1U);
+	}
+
+	if (value.empty()) {
+		// No value to store.
+		return;
+	}
+
+	switch (headerIndex) {
+	case beatmapHeaders::General:
+		if (key == "StackLeniency") {
+			ParseNumber(value, m_stackLeniency);
+		}
+		else if (key == "Mode") {
+			ParseNumber(value, m_gameMode);
+		}
+		break;
+
+	case beatmapHeaders::Editor:
+		if (key == "BeatDivisor") {
+			ParseNumber(value, m_beatDivisor);
+		}
+		break;
+
+	case beatmapHeaders::Metadata:
+		if (key == "Title") {
+			m_title = AddMetadataString(value);
+		}
+		else if (key == "Artist") {
+			m_artist = AddMetadataString(value);
+		}
+		else if (key == "Creator") {
+			m_creator = AddMetadataString(value);
+		}
+		else if (key == "Version") {
+			m_version = AddMetadataString(value);
+		}
+		else if (key == "BeatmapID") {
+			ParseNumber(value, m_beatmapID);
+		}
+		break;
+
+	case beatmapHeaders::Difficulty:
+		if (key == "CircleSize") {
+			ParseNumber(value, m_circleSize);
+		}
+		else if (key == "OverallDifficulty") {
+			ParseNumber(value, m_overallDifficulty);
+		}
+		else if (key == "ApproachRate") {
+			ParseNumber(value, m_approachRate);
+		}
+		else if (key == "SliderMultiplier") {
+			ParseNumber(value, m_sliderMultiplier);
+		}
+		else if (key == "SliderTickRate") {
+			ParseNumber(value, m_sliderTickRate);
+		}
+		break;
+	}
+}
+
+// This function copies a metadata string into the metadata arena.
+// Returns the location of the string in the arena.
+Beatmap::MetadataString Beatmap::AddMetadataString(_In_ std::string_view str) {
+	MetadataString result = { (UINT)m_metadata.size(), (UINT)str.size() };
+	m_metadata.append(str);
+
+	return result;
+}
+
+
+// This function checks if the song name (from the game title) is this beatmap.
+// Song name has format "{artistName} - {songTitle}" (without the parentheses).
+bool Beatmap::MatchesSongName(_In_ std::string_view songName) const {
+	std::string_view artist = GetArtist();
+	std::string_view title = GetTitle();
+
+	// Compare the parts in place, without building the full name.
+	return songName.size() == artist.size() + 3U + title.size()
+		&& songName.compare(0U, artist.size(), artist) == 0
+		&& songName.compare(artist.size(), 3U, " - ") == 0
+		&& songName.compare(artist.size() + 3U, title.size(), title) == 0;
+}
+
+
+// This function should be used to get the index of the hit object at specified time.
+UINT Beatmap::FindHitObjectAtT(_In_ const double& songTime) const {
+	// Only the time and type arrays are read.
+	const HitObjectTable* hitObjects = m_hitObjects.get();
+	const UINT hitObjectCount = hitObjects->GetCount();
+	const int* startTimes = hitObjects->m_startTimes.data();
+	const int* endTimes = hitObjects->m_endTimes.data();
+	const BYTE* objectTypes = hitObjects->m_objectTypes.data();
+
+	for (UINT i = 0U; i < hitObjectCount; i++) {
+		if (startTimes[i] >= songTime && objectTypes[i] == HITOBJECT_CIRCLE) {
 			// The object is a circle and song time is smaller than the start time.
-			return &(*object);
+			return i;
 		}
-		else if (object->GetEndTime() > songTime) {
+		else if (endTimes[i] > songTime) {
 			// Continue if the object end time is greater than the song time.
 			continue;
 		}
 
 		// Check if the object is not a circle and the end time smaller than the song time.
-		if (object->GetEndTime() <= songTime && object->GetObjectType() != HITOBJECT_CIRCLE) {
-			// Object found, return a pointer to it.
-			return &(*object);
+		if (endTimes[i] <= songTime && objectTypes[i] != HITOBJECT_CIRCLE) {
+			// Object found, return its index.
+			return i;
 		}
-		else if (*object == m_hitObjects.back()) {
+		else if (i == hitObjectCount - 1U) {
 			// The object is the last in the list (most likely already passed).
-			return &(*object);
+			return i;
 		}
 	}
 
-	// No object found, return a nullptr.
-	return nullptr;
+	// No object found, return the hit object count.
+	return hitObjectCount;
 }
 
-// This function retrives a pointer to a hitObject at a given index.
-const HitObject* Beatmap::GetHitObjectAtIndex(_In_ const UINT& index) const {
-	if (m_hitObjects.size() > 0U) {
-		if (index < 0U) {
-			// Index is smaller than 0U, return the first object.
-			return &m_hitObjects.front();
-		}
-		else if (index >= m_hitObjects.size()) {
-			// Index is greater than the size, return the last object.
-			return &m_hitObjects.back();
-		}
-
-		// Return the object at index.
-		return &m_hitObjects.at(index);
+// This function retrives a view of the hitObject at a given index.
+// Indices past the end give the last object, the beatmap should have hit objects.
+HitObject Beatmap::GetHitObjectAtIndex(_In_ const UINT& index) const {
+	const UINT hitObjectCount = m_hitObjects->GetCount();
+	if (index >= hitObjectCount && hitObjectCount > 0U) {
+		// Index is greater than the size, return the last object.
+		return HitObject(m_hitObjects.get(), hitObjectCount - 1U);
 	}
-	// No hitObjects in the vector, return a nullptr.
-	return nullptr;
+
+	// Return the object at index.
+	return HitObject(m_hitObjects.get(), index);
 }
\ No newline at end of file
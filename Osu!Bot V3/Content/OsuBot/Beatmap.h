@@ -5,106 +5,231 @@
 
 #include <Common/Vec2f.h>
 #include <Common/SplitString.h>
+#include <Common/MappedFile.h>
+#include <Common/ParseNumber.h>
+#include <Content/OsuBot/SliderPath.h>
+#include <Content/OsuBot/Bezier.h>
+#include <Content/OsuBot/MovementPlan.h>
 
-#include <fstream>
+#include <string_view>
 
 
 namespace OsuBot
 {
 	namespace BeatmapInfo
 	{
-		// A class that holds the points of a slider segment.
-		class Segment {
-		public:
-			// Constructor.
-			Segment(std::vector<vec2f> points) : m_points(points) {};
-
-			// Member variables.
-			std::vector<vec2f> m_points;
-		};
-		
 		// A class that holds information about a timing point for a hit object.
 		class TimingPoint {
 		public:
 			// Constructor.
-			explicit TimingPoint(_In_ std::wstring timingString);
+			explicit TimingPoint(_In_ std::string_view timingString);
+
+			// Member functions.
+			void ResolveBeatLenght(_In_ const float& beatLenghtBase);
 
 			// Accessor functions.
-			int		GetTime() const		{ return m_time; }
-			float	GetBpm() const		{ return m_bpm; }
+			int		GetTime() const				{ return m_time; }
+			float	GetBpm() const				{ return m_bpm; }
+			float	GetBeatLenght() const		{ return m_beatLenght; }
+			float	GetBeatLenghtBase() const	{ return m_beatLenghtBase; }
+			float	GetSliderVelocity() const	{ return m_beatLenghtBase / m_beatLenght; }
 			
 
 		private:
 			// Member variables.
 			int m_time;
 			float m_bpm;
+
+			// Resolved when all timing points are read.
+			float m_beatLenght;
+			float m_beatLenghtBase;
 		};
 
-		// A class that holds information about a hit object from a beatmap.
-		class HitObject {
+		// A class that parses a hit object line of a beatmap.
+		// It is only used while parsing, the beatmap keeps the values in its hit object table.
+		class ParsedHitObject {
 		public:
 			// Constructor.
-			HitObject(
-				_In_ std::wstring hitString,
-				_In_ std::vector<TimingPoint>* timingPoints,
+			ParsedHitObject(
+				_In_ std::string_view hitString,
+				_In_ const std::vector<TimingPoint>* timingPoints,
 				_In_ float beatmapSliderMultiplier,
-				_In_ float beatmapSliderTickRate
+				_In_ float beatmapSliderTickRate,
+				_Inout_ SliderGeometry* sliderGeometry
 			);
 
 		private:
+			// The hit object table stores the parsed values.
+			friend class HitObjectTable;
+
+			// A hit object line has at most 11 comma separated values.
+			using HitObjectTokens = StringTokens<11U>;
+
+			// Ticks closer to the end of a span than this part of a tick are left out.
+			constexpr static float m_tickEndMargin = 0.01f;
+
 			// Internal functions.
 			// Slider info functions.
 			void GetSliderInfo(
-				_In_ std::vector<std::wstring>* tokens,
-				_In_ std::vector<TimingPoint>* timingPoints,
+				_In_ const HitObjectTokens* tokens,
+				_In_ const std::vector<TimingPoint>* timingPoints,
 				_In_ float beatmapSliderMultiplier,
-				_In_ float beatmapSliderTickRate
+				_In_ float beatmapSliderTickRate,
+				_Inout_ SliderGeometry* sliderGeometry
 			);
-			void GetLinearSliderInfo(_In_ std::vector<vec2f>* sliderPoints);
-			void GetCircularSliderInfo(_In_ std::vector<vec2f>* sliderPoints);
-			void GetBezierSliderInfo(_In_ std::vector<vec2f>* sliderPoints);
+			void GetLinearSliderInfo(_Inout_ SliderGeometry* sliderGeometry);
+			void GetCircularSliderInfo(_Inout_ SliderGeometry* sliderGeometry);
+			void GetBezierSliderInfo(_Inout_ SliderGeometry* sliderGeometry);
+			void GetCatmullSliderInfo(_Inout_ SliderGeometry* sliderGeometry);
+			void GetSliderTimeline(_Inout_ SliderGeometry* sliderGeometry);
 
 			// Spinner info function.
-			void GetSpinnerInfo(_In_ std::vector<std::wstring>* tokens);
-
-
-		public:
-			// Get point on slider by time.
-			vec2f GetPointByT(_In_ const double& time) const;
+			void GetSpinnerInfo(_In_ const HitObjectTokens* tokens);
 
 			// Accessor functions.
-			int			GetObjectType() const;
-
-			vec2f		GetStartPosition() const			{ return m_startPosition; }
-			vec2f		GetEndPosition() const;
-
-			int			GetStartTime() const				{ return m_startTime; }
-			int			GetEndTime() const;
-			int			GetSliderTime() const				{ return m_sliderTime; }
-			float		GetSliderTickCount() const			{ return m_sliderTickCount; }
-			UINT		GetSliderRepeatCount() const		{ return m_sliderRepeatCount;}
-			UINT		GetStackIndex() const				{ return m_stackIndex; }
+			int GetObjectType() const;
+			int GetEndTime() const;
 
 
 		private:
 			// Member variables.
-			vec2f m_sliderCenter;
 			vec2f m_startPosition;
+			vec2f m_endPosition;
 			int m_startTime;
 			int m_endTime;
 			int m_sliderTime;
-			float m_startAngle;
-			float m_endAngle;
-			float m_sliderRadius;
 			float m_pixelLenght;
 			float m_beatLenght;
 			float m_beatLenghtBase;
 			float m_sliderTickCount;
 			UINT m_sliderRepeatCount;
-			UINT m_stackIndex;
+			int m_stackIndex;
 			UINT m_objectType;
 			BYTE m_sliderType;
-			std::vector<Segment> m_sliderSegments;
+
+			// The slider path and timeline in the slider geometry.
+			UINT m_firstPathPoint;
+			UINT m_pathPointCount;
+			UINT m_firstSliderEvent;
+			UINT m_sliderEventCount;
+		};
+
+		// A class that holds the values of a hit object that are only read while the bot is on it.
+		// Circles and spinners keep the default values.
+		class SliderDetails {
+		public:
+			// Member variables.
+			vec2f m_endPosition;
+			int m_sliderTime;
+			float m_sliderTickCount;
+			UINT m_sliderRepeatCount;
+
+			// The slider path and timeline in the slider geometry.
+			UINT m_firstPathPoint;
+			UINT m_pathPointCount;
+			UINT m_firstSliderEvent;
+			UINT m_sliderEventCount;
+		};
+
+		// A class that holds the hit objects of a beatmap as a struct of arrays.
+		// The values that every scan over the hit objects reads have their own arrays, so a scan
+		// only reads those. The slider values and geometry are only read for the current hit object.
+		class HitObjectTable {
+		public:
+			// Member functions.
+			void Reserve(_In_ const size_t& hitObjectCount);
+			void Add(_In_ const ParsedHitObject& hitObject);
+			void Append(_In_ const HitObjectTable& hitObjects);
+
+			// Accessor functions.
+			UINT GetCount() const { return (UINT)m_startTimes.size(); }
+
+			// Member variables.
+			// The hot arrays, one value for every hit object.
+			std::vector<int> m_startTimes;
+			// Circles end at their start time.
+			std::vector<int> m_endTimes;
+			// HITOBJECT_CIRCLE, HITOBJECT_SLIDER or HITOBJECT_SPINNER.
+			std::vector<BYTE> m_objectTypes;
+			std::vector<vec2f> m_startPositions;
+			// Stacked hit objects are moved up and left, hit objects stacked on a slider tail down and right.
+			std::vector<int> m_stackIndices;
+
+			// The cold values, one for every hit object.
+			std::vector<SliderDetails> m_sliderDetails;
+
+			// The slider paths and timelines of all sliders.
+			SliderGeometry m_sliderGeometry;
+		};
+
+		// A class that views a hit object in the hit object table of a beatmap.
+		// It is two values, so it is passed by value. It is valid as long as the beatmap is.
+		class HitObject {
+		public:
+			// Constructor.
+			HitObject(_In_ const HitObjectTable* hitObjects, _In_ const UINT& index) : m_hitObjects(hitObjects), m_index(index) {}
+
+			// Get point on slider by time.
+			vec2f GetPointByT(_In_ const double& time) const;
+			void GetPointsByT(_In_ const double* times, _In_ const UINT& timeCount, _Out_ vec2f* points) const;
+			SliderPath GetSliderPath() const { return m_hitObjects->m_sliderGeometry.GetPath(GetSliderDetails().m_firstPathPoint, GetSliderDetails().m_pathPointCount); }
+
+			// Accessor functions.
+			int			GetObjectType() const				{ return m_hitObjects->m_objectTypes[m_index]; }
+
+			vec2f		GetStartPosition() const			{ return m_hitObjects->m_startPositions[m_index]; }
+			vec2f		GetEndPosition() const				{ return GetSliderDetails().m_endPosition; }
+
+			int			GetStartTime() const				{ return m_hitObjects->m_startTimes[m_index]; }
+			int			GetEndTime() const					{ return m_hitObjects->m_endTimes[m_index]; }
+			int			GetSliderTime() const				{ return GetSliderDetails().m_sliderTime; }
+			float		GetSliderTickCount() const			{ return GetSliderDetails().m_sliderTickCount; }
+			UINT		GetSliderRepeatCount() const		{ return GetSliderDetails().m_sliderRepeatCount; }
+			int			GetStackIndex() const				{ return m_hitObjects->m_stackIndices[m_index]; }
+
+			// The slider timeline, from the head to the tail.
+			UINT				GetSliderEventCount() const					{ return GetSliderDetails().m_sliderEventCount; }
+			const SliderEvent&	GetSliderEvent(_In_ const UINT& index) const	{ return m_hitObjects->m_sliderGeometry.m_sliderEvents[GetSliderDetails().m_firstSliderEvent + index]; }
+
+			// The table and index of the hit object.
+			const HitObjectTable*	GetHitObjectTable() const	{ return m_hitObjects; }
+			UINT					GetIndex() const			{ return m_index; }
+
+
+		private:
+			// Internal functions.
+			const SliderDetails& GetSliderDetails() const { return m_hitObjects->m_sliderDetails[m_index]; }
+
+		private:
+			// Member variables.
+			const HitObjectTable* m_hitObjects;
+			UINT m_index;
+		};
+
+		// A class that follows the point on a slider by song time, over all its repeats.
+		// The point is found from the point of the last song time, so following a slider costs
+		// the same for every point however long the slider is.
+		// The song time may go back a little, the time read from the game jitters.
+		class SliderFollower {
+		public:
+			// Constructor.
+			SliderFollower() : m_slider(nullptr, 0U), m_cursor(SliderPath(nullptr, nullptr, 0U)), m_pathLenght(0.f) {}
+
+			// Member functions.
+			void Follow(_In_ const HitObject& slider);
+			vec2f GetPointAtTime(_In_ const double& songTime);
+
+			// Accessor functions.
+			bool IsFollowing(_In_ const HitObject& slider) const {
+				return m_slider.GetHitObjectTable() == slider.GetHitObjectTable() && m_slider.GetIndex() == slider.GetIndex();
+			}
+
+
+		private:
+			// Member variables.
+			HitObject m_slider;
+			SliderPathCursor m_cursor;
+			float m_pathLenght;
 		};
 		
 		// A class that holds all usefull information about a beatmap for the bot.
@@ -112,46 +237,90 @@ namespace OsuBot
 		public:
 			// Constructor and destructor.
 			Beatmap(const wchar_t* path) :
-				m_filePath(path)
-			{
-				m_beatmapFile = _wfsopen(m_filePath, L"r", _SH_DENYNO);
-			}
-			~Beatmap() {
-				if (m_beatmapFile) {
-					fclose(m_beatmapFile);
-				}
-			}
+				m_filePath(path),
+				m_stackOffset(0.f),
+				m_stackLeniency(0.7f),
+				m_gameMode(0U),
+				m_beatDivisor(4.f),
+				m_title({ 0U, 0U }),
+				m_artist({ 0U, 0U }),
+				m_creator({ 0U, 0U }),
+				m_version({ 0U, 0U }),
+				m_beatmapID(0U),
+				m_circleSize(5.f),
+				m_overallDifficulty(5.f),
+				m_approachRate(5.f),
+				m_sliderMultiplier(1.4f),
+				m_sliderTickRate(1.f),
+				m_hitObjects(std::make_unique<HitObjectTable>())
+			{}
+
+			// A beatmap is only moved, the queue holds every beatmap once.
+			Beatmap(const Beatmap&) = delete;
+			Beatmap& operator=(const Beatmap&) = delete;
+			Beatmap(Beatmap&&) = default;
+			Beatmap& operator=(Beatmap&&) = default;
 
 			// Member functions.
-			bool ParseBeatmap();
+			bool ParseBeatmap(_In_opt_ const bool& useBeatmapCache = TRUE);
+			void SetMovementPlan(_In_ MovementPlan movementPlan) { m_movementPlan = std::move(movementPlan); }
+			// Calculates the stack indices of the parsed hit objects again, ParseBeatmap calculates them.
+			void CalculateStacking();
+
+			// Sets the most threads that parse the hit objects of a beatmap, 0 uses one thread per core.
+			// Every thread still parses at least minHitObjectsPerThread lines.
+			static void SetParseThreadCount(_In_ const UINT& threadCount);
 
 
 		public:
 			// Accessor functions.
-			const HitObject* FindHitObjectAtT(_In_ const double& songTime) const;
-			const HitObject* GetHitObjectAtIndex(_In_ const UINT& index) const;
+			// Returns the hit object count when no hit object is found.
+			UINT FindHitObjectAtT(_In_ const double& songTime) const;
+			HitObject GetHitObjectAtIndex(_In_ const UINT& index) const;
 			
-			UINT GetHitObjectsCount() const { return (UINT)m_hitObjects.size(); }
+			UINT GetHitObjectsCount() const { return m_hitObjects->GetCount(); }
+
+			// The moves to the hit objects, compiled when the beatmap is queued.
+			const MovementPlan& GetMovementPlan() const { return m_movementPlan; }
 
 			float GetStackOffset() const { return m_stackOffset; }
 			float GetCircleSize() const { return m_circleSize; }
 
-			std::wstring		GetTitle() const				{ return m_title; }
-			std::wstring		GetArtist() const				{ return m_artist; }
-			std::wstring		GetCreator() const				{ return m_creator; }
-			std::wstring		GetVersion() const				{ return m_version; }
+			// Metadata is UTF-8, convert with Utf8ToWide() where it is shown.
+			std::string_view	GetTitle() const				{ return GetMetadataString(m_title); }
+			std::string_view	GetArtist() const				{ return GetMetadataString(m_artist); }
+			std::string_view	GetCreator() const				{ return GetMetadataString(m_creator); }
+			std::string_view	GetVersion() const				{ return GetMetadataString(m_version); }
 			UINT				GetBeatmapID() const			{ return m_beatmapID; }
+
+			bool MatchesSongName(_In_ std::string_view songName) const;
 		
 		private:
-			// Internal function.
-			bool FindHeader(_In_ const UINT& headerIndex);
-			void ReadKeysUnderHeader(_In_ UINT& headerIndex);
-			std::wstring GetValueString(_In_ const std::wstring* readLine) const;
+			// The beatmap cache reads and writes all members in bulk.
+			friend class BeatmapCache;
+
+			// A string stored in the metadata arena.
+			struct MetadataString {
+				UINT offset;
+				UINT lenght;
+			};
+
+			// Internal functions.
+			static bool ReadBeatmapLine(_Inout_ std::string_view& content, _Out_ std::string_view& readLine);
+			UINT FindHeader(_In_ std::string_view readLine) const;
+			void ReadKeyValue(_In_ const UINT& headerIndex, _In_ std::string_view readLine);
+			void ResolveTimingPoints();
+			void ParseHitObjects(_In_ const std::vector<std::string_view>& hitObjectLines);
+
+			MetadataString AddMetadataString(_In_ std::string_view str);
+			std::string_view GetMetadataString(_In_ const MetadataString& str) const {
+				return std::string_view(m_metadata.data() + str.offset, str.lenght);
+			}
 
 
 		private:
 			// Header enum and wstring array.
-			const enum beatmapHeaders : UINT {
+			enum beatmapHeaders : UINT {
 				General,
 				Editor,
 				Metadata,
@@ -162,32 +331,28 @@ namespace OsuBot
 				count
 			};
 
-			constexpr static const wchar_t* headerStrings[beatmapHeaders::count] = {
-				L"[General]",
-				L"[Editor]",
-				L"[Metadata]",
-				L"[Difficulty]",
-				L"[TimingPoints]",
-				L"[Colours]",
-				L"[HitObjects]"
+			// Hit object lines per parsing thread.
+			constexpr static UINT minHitObjectsPerThread = 1024U;
+
+			// Hit objects closer than this (in osu!pixels) are stacked.
+			constexpr static float stackDistance = 3.f;
+
+			constexpr static std::string_view headerStrings[beatmapHeaders::count] = {
+				"[General]",
+				"[Editor]",
+				"[Metadata]",
+				"[Difficulty]",
+				"[TimingPoints]",
+				"[Colours]",
+				"[HitObjects]"
 			};
 
 		public:
 			// Member variables.
-			FILE* m_beatmapFile;
-			LPCWSTR m_filePath;
+			std::wstring m_filePath;
 			float m_stackOffset;
 
 		private:
-			// Beatmap headers.
-			bool m_headerGeneral;
-			bool m_headerEditor;
-			bool m_headerMetadata;
-			bool m_headerDifficulty;
-			bool m_headerTimingPoints;
-			bool m_headerColours;
-			bool m_headerHitObjects;
-
 			// General header.
 			float m_stackLeniency;
 			UINT m_gameMode;
@@ -196,10 +361,12 @@ namespace OsuBot
 			float m_beatDivisor;
 
 			// Metadata header.
-			std::wstring m_title;
-			std::wstring m_artist;
-			std::wstring m_creator;
-			std::wstring m_version;
+			// All metadata strings are stored in one arena.
+			std::string m_metadata;
+			MetadataString m_title;
+			MetadataString m_artist;
+			MetadataString m_creator;
+			MetadataString m_version;
 			UINT m_beatmapID;
 
 			// Difficulty header.
@@ -210,57 +377,20 @@ namespace OsuBot
 			float m_sliderTickRate;
 
 			// Timingpoints header.
+			// Sorted by time, with the beat lenghts resolved.
 			std::vector<TimingPoint> m_timingPoints;
 
 			// HitObjects header.
-			std::vector<HitObject> m_hitObjects;
+			// The table is allocated once, so the hit objects that view into it stay valid when the beatmap is moved.
+			std::unique_ptr<HitObjectTable> m_hitObjects;
+
+			// The moves of the cursor, they depend on the movement modes so they are not cached.
+			MovementPlan m_movementPlan;
 		};
 
 
 		// Usefull functions with vec2f objects.
 
-		// calculates the binomial coefficient.
-		inline double BinomialCoefficient(const UINT& n, const UINT& i) {
-			if (i < 0U || i > n) {
-				return 0.0;
-			}
-			else if (i == 0U || i == n) {
-				return 1.0;
-			}
-
-			double c = 1.0;
-			for (UINT u = 0U; u < min(i, n - i); u++) {
-				c = c * static_cast<double>(n - u) / static_cast<double>(u + 1U);
-			}
-
-			return c;
-		}
-
-		// Calculates the Bernstein using a binomial coefficient.
-		inline double Bernstein(const UINT& i, const UINT& n, const double& t) {
-			return BinomialCoefficient(n, i) * pow(t, static_cast<double>(i)) * pow(1.0 - t, static_cast<double>(n) - static_cast<double>(i));
-		}
-
-		// Returns the point on a bezier curve
-		// with time 0 - 1.
-		inline vec2f GetPointOnBezier(
-			_In_ const std::vector<vec2f>& bezier,
-			_In_ const double& time,
-			_In_opt_ const UINT& repeatCount = 0U
-		) {
-			vec2f point(0.f, 0.f);
-			UINT pointsSize = (UINT)bezier.size() - 1U;
-
-			// Calculate the point using a berstein calculation.
-			for (UINT i = 0U; i <= pointsSize; i++) {
-				// Translate the point for each segment.
-				double b = Bernstein(i, pointsSize, time);
-				point.Add(bezier.at(i + (repeatCount * pointsSize)).Copy().Mult(static_cast<FLOAT>(b)));
-			}
-
-			return point;
-		}
-
 		// Returns the point on a circle
 		// with angle in radians.
 		inline vec2f GetPointOnCircle(
@@ -301,6 +431,16 @@ namespace OsuBot
 			return vec3.Copy().Add(vec4.Copy().Mult(u));
 		}
 
+		// Check if the three points are (almost) on one line.
+		// A circle can't be drawn through them, the slider is a bezier instead.
+		inline bool IsCollinear(
+			_In_ const vec2f& vec1,
+			_In_ const vec2f& vec2,
+			_In_ const vec2f& vec3
+		) {
+			return fabsf((vec2.Y - vec1.Y) * (vec3.X - vec1.X) - (vec2.X - vec1.X) * (vec3.Y - vec1.Y)) < 0.001f;
+		}
+
 		// Check if the mid angle is inside the start and end angles.
 		inline bool IsInside(
 			_In_ const float& startAngle,
@@ -309,45 +449,5 @@ namespace OsuBot
 		) {
 			return (midAngle > startAngle && midAngle < endAngle) || (midAngle < startAngle && midAngle > endAngle);
 		}
-
-		// Check if both segments (points at same index) are exactly equal.
-		inline bool operator== (const Segment& lhs, const Segment& rhs) {
-			if (lhs.m_points.size() != rhs.m_points.size()) {
-				// The segments have different sizes.
-				return FALSE;
-			}
-			for (UINT i = 0U; i < lhs.m_points.size(); i++) {
-				if (lhs.m_points.at(i) != rhs.m_points.at(i)) {
-					// The points in the segment are not equal.
-					return FALSE;
-				}
-			}
-			
-			// All points (at same index) in the segments are equal.
-			return TRUE;
-		}
-
-		// Check if both hitObjects are the exact same.
-		inline bool operator== (const HitObject& lhs, const HitObject& rhs) {
-			// If any important data mismatches, return FALSE.
-			if (lhs.GetEndTime() != rhs.GetEndTime()) {
-				return FALSE;
-			}
-			if (lhs.GetEndPosition() != rhs.GetEndPosition()) {
-				return FALSE;
-			}
-			if (lhs.GetObjectType() != rhs.GetObjectType()) {
-				return FALSE;
-			}
-			if (lhs.GetStartPosition() != rhs.GetStartPosition()) {
-				return FALSE;
-			}
-			if (lhs.GetStartTime() != rhs.GetStartTime()) {
-				return FALSE;
-			}
-
-			// If no data mismatched, return TRUE.
-			return TRUE;
-		}
 	}
 }
\ No newline at end of file
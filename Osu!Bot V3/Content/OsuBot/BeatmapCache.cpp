@@ -0,0 +1,300 @@
+// BeatmapCache.cpp : Defines the content in BeatmapCache.h
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot/BeatmapCache.h>
+
+#include <type_traits>
+
+
+using namespace OsuBot::BeatmapInfo;
+
+
+// The sections are copied as raw bytes.
+static_assert(std::is_trivially_copyable<TimingPoint>::value, "TimingPoint must be trivially copyable.");
+static_assert(std::is_trivially_copyable<SliderDetails>::value, "SliderDetails must be trivially copyable.");
+static_assert(std::is_trivially_copyable<vec2f>::value, "vec2f must be trivially copyable.");
+static_assert(std::is_trivially_copyable<SliderEvent>::value, "SliderEvent must be trivially copyable.");
+static_assert(alignof(SliderDetails) <= 8U, "SliderDetails needs a larger section alignment.");
+
+
+namespace
+{
+	// The folder (next to Config.ini) that holds the compiled beatmaps.
+	const wchar_t cacheFolder[] = L"BeatmapCache";
+
+	// Returns the size rounded up to the section alignment.
+	inline size_t AlignSection(_In_ const size_t& size, _In_ const size_t& alignment) {
+		return (size + alignment - 1U) & ~(alignment - 1U);
+	}
+
+	// Appends a section to the buffer, followed by padding up to the alignment.
+	inline void WriteSection(_Inout_ std::string& buffer, _In_ const void* data, _In_ const size_t& size, _In_ const size_t& alignment) {
+		buffer.append(static_cast<const char*>(data), size);
+		buffer.resize(AlignSection(buffer.size(), alignment), '\0');
+	}
+
+	// Copies the section into the vector.
+	template <typename T>
+	inline void CopySection(_Out_ std::vector<T>& destination, _In_ const char* section, _In_ const UINT& count) {
+		const T* first = reinterpret_cast<const T*>(section);
+		destination.assign(first, first + count);
+	}
+
+	// Returns TRUE if the range of count elements from first is in an array of size elements.
+	inline bool IsRangeInArray(_In_ const UINT& first, _In_ const UINT& count, _In_ const size_t& size) {
+		return first <= size && count <= size - first;
+	}
+
+	// Returns a pointer to the section at offset and moves the offset past it.
+	// Returns a nullptr if the section doesn't fit in the file.
+	inline const char* ReadSection(_In_ const MappedFile& file, _Inout_ size_t& offset, _In_ const size_t& size, _In_ const size_t& alignment) {
+		if (size > file.GetSize() - offset) {
+			// The file is too small.
+			return nullptr;
+		}
+
+		const char* section = file.GetData() + offset;
+		offset = (std::min)(AlignSection(offset + size, alignment), file.GetSize());
+
+		return section;
+	}
+}
+
+
+// Beatmap cache constructor.
+BeatmapCache::BeatmapCache(_In_ const std::wstring& beatmapPath) :
+	m_beatmapPath(beatmapPath),
+	m_beatmapSize(0U),
+	m_beatmapWriteTime(0U),
+	m_beatmapFound(FALSE)
+{
+	// Get the size and last write time of the beatmap, a changed beatmap is parsed again.
+	WIN32_FILE_ATTRIBUTE_DATA beatmapInfo;
+	if (!GetFileAttributesExW(m_beatmapPath.c_str(), GetFileExInfoStandard, &beatmapInfo)) {
+		// Beatmap not found, there is nothing to cache.
+		return;
+	}
+
+	m_beatmapSize = (static_cast<ULONGLONG>(beatmapInfo.nFileSizeHigh) << 32) | beatmapInfo.nFileSizeLow;
+	m_beatmapWriteTime = (static_cast<ULONGLONG>(beatmapInfo.ftLastWriteTime.dwHighDateTime) << 32) | beatmapInfo.ftLastWriteTime.dwLowDateTime;
+	m_beatmapFound = TRUE;
+
+	// The compiled beatmap is named after a (FNV-1a) hash of the beatmap path.
+	ULONGLONG pathHash = 14695981039346656037ULL;
+	for (wchar_t pathChar : m_beatmapPath) {
+		pathHash ^= static_cast<ULONGLONG>(towlower(pathChar));
+		pathHash *= 1099511628211ULL;
+	}
+
+	const wchar_t hexDigits[] = L"0123456789abcdef";
+	m_cachePath = cacheFolder;
+	m_cachePath += L'\\';
+	for (int shift = 60; shift >= 0; shift -= 4) {
+		m_cachePath += hexDigits[(pathHash >> shift) & 0xF];
+	}
+	m_cachePath += L".obc";
+}
+
+
+// This function loads the compiled beatmap into the beatmap.
+// The compiled beatmap is mapped into memory and every section is copied in bulk.
+// Returns FALSE when there is no valid compiled beatmap for the beatmap file.
+bool BeatmapCache::LoadBeatmap(_Inout_ Beatmap* beatmap) const {
+	if (!m_beatmapFound) {
+		return FALSE;
+	}
+
+	MappedFile cacheFile(m_cachePath);
+	if (!cacheFile.IsOpen() || cacheFile.GetSize() < sizeof(FileHeader)) {
+		// No compiled beatmap.
+		return FALSE;
+	}
+
+	FileHeader header;
+	memcpy(&header, cacheFile.GetData(), sizeof(FileHeader));
+
+	// Check if the compiled beatmap is made by this build, from this beatmap file.
+	if (header.magic != m_magic || header.version != m_version ||
+		header.timingPointSize != sizeof(TimingPoint) || header.sliderDetailsSize != sizeof(SliderDetails) ||
+		header.beatmapSize != m_beatmapSize || header.beatmapWriteTime != m_beatmapWriteTime) {
+		return FALSE;
+	}
+
+	// Get the sections.
+	size_t offset = AlignSection(sizeof(FileHeader), m_sectionAlignment);
+	const char* path = ReadSection(cacheFile, offset, header.pathLenght * sizeof(wchar_t), m_sectionAlignment);
+	const char* metadata = ReadSection(cacheFile, offset, header.metadataSize, m_sectionAlignment);
+	const char* timingPoints = ReadSection(cacheFile, offset, header.timingPointCount * sizeof(TimingPoint), m_sectionAlignment);
+	const char* startTimes = ReadSection(cacheFile, offset, header.hitObjectCount * sizeof(int), m_sectionAlignment);
+	const char* endTimes = ReadSection(cacheFile, offset, header.hitObjectCount * sizeof(int), m_sectionAlignment);
+	const char* objectTypes = ReadSection(cacheFile, offset, header.hitObjectCount * sizeof(BYTE), m_sectionAlignment);
+	const char* startPositions = ReadSection(cacheFile, offset, header.hitObjectCount * sizeof(vec2f), m_sectionAlignment);
+	const char* stackIndices = ReadSection(cacheFile, offset, header.hitObjectCount * sizeof(int), m_sectionAlignment);
+	const char* sliderDetails = ReadSection(cacheFile, offset, header.hitObjectCount * sizeof(SliderDetails), m_sectionAlignment);
+	const char* pathPoints = ReadSection(cacheFile, offset, header.pathPointCount * sizeof(vec2f), m_sectionAlignment);
+	const char* pathLenghts = ReadSection(cacheFile, offset, header.pathPointCount * sizeof(float), m_sectionAlignment);
+	const char* sliderEvents = ReadSection(cacheFile, offset, header.sliderEventCount * sizeof(SliderEvent), m_sectionAlignment);
+
+	if (path == nullptr || metadata == nullptr || timingPoints == nullptr ||
+		startTimes == nullptr || endTimes == nullptr || objectTypes == nullptr || startPositions == nullptr || stackIndices == nullptr || sliderDetails == nullptr ||
+		pathPoints == nullptr || pathLenghts == nullptr || sliderEvents == nullptr) {
+		// The compiled beatmap is incomplete.
+		return FALSE;
+	}
+
+	// Check the full path, in case another beatmap has the same path hash.
+	if (std::wstring_view(reinterpret_cast<const wchar_t*>(path), header.pathLenght) != m_beatmapPath) {
+		return FALSE;
+	}
+
+	// Check that the metadata strings are in the metadata.
+	for (const Beatmap::MetadataString& str : { header.titleString, header.artistString, header.creatorString, header.versionString }) {
+		if (!IsRangeInArray(str.offset, str.lenght, header.metadataSize)) {
+			return FALSE;
+		}
+	}
+
+	// Check that the path and timeline of every slider are in the slider geometry,
+	// a damaged compiled beatmap would make the bot read past them.
+	const SliderDetails* sliderDetailsArray = reinterpret_cast<const SliderDetails*>(sliderDetails);
+	for (UINT i = 0U; i < header.hitObjectCount; i++) {
+		SliderDetails details;
+		memcpy(&details, sliderDetailsArray + i, sizeof(SliderDetails));
+
+		if (!IsRangeInArray(details.m_firstPathPoint, details.m_pathPointCount, header.pathPointCount) ||
+			!IsRangeInArray(details.m_firstSliderEvent, details.m_sliderEventCount, header.sliderEventCount)) {
+			return FALSE;
+		}
+	}
+
+	// Copy the beatmap values.
+	beatmap->m_stackOffset = header.stackOffset;
+	beatmap->m_stackLeniency = header.stackLeniency;
+	beatmap->m_gameMode = header.gameMode;
+	beatmap->m_beatDivisor = header.beatDivisor;
+	beatmap->m_metadata.assign(metadata, header.metadataSize);
+	beatmap->m_title = header.titleString;
+	beatmap->m_artist = header.artistString;
+	beatmap->m_creator = header.creatorString;
+	beatmap->m_version = header.versionString;
+	beatmap->m_beatmapID = header.beatmapID;
+	beatmap->m_circleSize = header.circleSize;
+	beatmap->m_overallDifficulty = header.overallDifficulty;
+	beatmap->m_approachRate = header.approachRate;
+	beatmap->m_sliderMultiplier = header.sliderMultiplier;
+	beatmap->m_sliderTickRate = header.sliderTickRate;
+
+	// Copy the hit object arrays and slider geometry.
+	std::unique_ptr<HitObjectTable> hitObjects = std::make_unique<HitObjectTable>();
+	CopySection(hitObjects->m_startTimes, startTimes, header.hitObjectCount);
+	CopySection(hitObjects->m_endTimes, endTimes, header.hitObjectCount);
+	CopySection(hitObjects->m_objectTypes, objectTypes, header.hitObjectCount);
+	CopySection(hitObjects->m_startPositions, startPositions, header.hitObjectCount);
+	CopySection(hitObjects->m_stackIndices, stackIndices, header.hitObjectCount);
+	CopySection(hitObjects->m_sliderDetails, sliderDetails, header.hitObjectCount);
+
+	SliderGeometry& sliderGeometry = hitObjects->m_sliderGeometry;
+	CopySection(sliderGeometry.m_pathPoints, pathPoints, header.pathPointCount);
+	CopySection(sliderGeometry.m_pathLenghts, pathLenghts, header.pathPointCount);
+	CopySection(sliderGeometry.m_sliderEvents, sliderEvents, header.sliderEventCount);
+
+	// Copy the timing points.
+	CopySection(beatmap->m_timingPoints, timingPoints, header.timingPointCount);
+	beatmap->m_hitObjects = std::move(hitObjects);
+
+	return TRUE;
+}
+
+// This function writes the parsed beatmap to its compiled beatmap file.
+// The file is written next to the old one and then replaces it,
+// so a failed write never leaves a half written compiled beatmap.
+bool BeatmapCache::SaveBeatmap(_In_ const Beatmap* beatmap) const {
+	if (!m_beatmapFound) {
+		return FALSE;
+	}
+
+	const HitObjectTable* hitObjects = beatmap->m_hitObjects.get();
+	const SliderGeometry* sliderGeometry = &hitObjects->m_sliderGeometry;
+
+	// Fill in the header.
+	FileHeader header = {};
+	header.magic = m_magic;
+	header.version = m_version;
+	header.timingPointSize = sizeof(TimingPoint);
+	header.sliderDetailsSize = sizeof(SliderDetails);
+	header.beatmapSize = m_beatmapSize;
+	header.beatmapWriteTime = m_beatmapWriteTime;
+	header.stackOffset = beatmap->m_stackOffset;
+	header.stackLeniency = beatmap->m_stackLeniency;
+	header.gameMode = beatmap->m_gameMode;
+	header.beatDivisor = beatmap->m_beatDivisor;
+	header.titleString = beatmap->m_title;
+	header.artistString = beatmap->m_artist;
+	header.creatorString = beatmap->m_creator;
+	header.versionString = beatmap->m_version;
+	header.beatmapID = beatmap->m_beatmapID;
+	header.circleSize = beatmap->m_circleSize;
+	header.overallDifficulty = beatmap->m_overallDifficulty;
+	header.approachRate = beatmap->m_approachRate;
+	header.sliderMultiplier = beatmap->m_sliderMultiplier;
+	header.sliderTickRate = beatmap->m_sliderTickRate;
+	header.pathLenght = (UINT)m_beatmapPath.size();
+	header.metadataSize = (UINT)beatmap->m_metadata.size();
+	header.timingPointCount = (UINT)beatmap->m_timingPoints.size();
+	header.hitObjectCount = hitObjects->GetCount();
+	header.pathPointCount = (UINT)sliderGeometry->m_pathPoints.size();
+	header.sliderEventCount = (UINT)sliderGeometry->m_sliderEvents.size();
+
+	// Write the header and sections into one buffer.
+	std::string buffer;
+	buffer.reserve(AlignSection(sizeof(FileHeader), m_sectionAlignment)
+		+ AlignSection(header.pathLenght * sizeof(wchar_t), m_sectionAlignment)
+		+ AlignSection(header.metadataSize, m_sectionAlignment)
+		+ AlignSection(header.timingPointCount * sizeof(TimingPoint), m_sectionAlignment)
+		+ AlignSection(header.hitObjectCount * sizeof(int), m_sectionAlignment) * 2U
+		+ AlignSection(header.hitObjectCount * sizeof(BYTE), m_sectionAlignment)
+		+ AlignSection(header.hitObjectCount * sizeof(vec2f), m_sectionAlignment)
+		+ AlignSection(header.hitObjectCount * sizeof(int), m_sectionAlignment)
+		+ AlignSection(header.hitObjectCount * sizeof(SliderDetails), m_sectionAlignment)
+		+ AlignSection(header.pathPointCount * sizeof(vec2f), m_sectionAlignment)
+		+ AlignSection(header.pathPointCount * sizeof(float), m_sectionAlignment)
+		+ AlignSection(header.sliderEventCount * sizeof(SliderEvent), m_sectionAlignment));
+
+	WriteSection(buffer, &header, sizeof(FileHeader), m_sectionAlignment);
+	WriteSection(buffer, m_beatmapPath.data(), header.pathLenght * sizeof(wchar_t), m_sectionAlignment);
+	WriteSection(buffer, beatmap->m_metadata.data(), header.metadataSize, m_sectionAlignment);
+	WriteSection(buffer, beatmap->m_timingPoints.data(), header.timingPointCount * sizeof(TimingPoint), m_sectionAlignment);
+	WriteSection(buffer, hitObjects->m_startTimes.data(), header.hitObjectCount * sizeof(int), m_sectionAlignment);
+	WriteSection(buffer, hitObjects->m_endTimes.data(), header.hitObjectCount * sizeof(int), m_sectionAlignment);
+	WriteSection(buffer, hitObjects->m_objectTypes.data(), header.hitObjectCount * sizeof(BYTE), m_sectionAlignment);
+	WriteSection(buffer, hitObjects->m_startPositions.data(), header.hitObjectCount * sizeof(vec2f), m_sectionAlignment);
+	WriteSection(buffer, hitObjects->m_stackIndices.data(), header.hitObjectCount * sizeof(int), m_sectionAlignment);
+	WriteSection(buffer, hitObjects->m_sliderDetails.data(), header.hitObjectCount * sizeof(SliderDetails), m_sectionAlignment);
+	WriteSection(buffer, sliderGeometry->m_pathPoints.data(), header.pathPointCount * sizeof(vec2f), m_sectionAlignment);
+	WriteSection(buffer, sliderGeometry->m_pathLenghts.data(), header.pathPointCount * sizeof(float), m_sectionAlignment);
+	WriteSection(buffer, sliderGeometry->m_sliderEvents.data(), header.sliderEventCount * sizeof(SliderEvent), m_sectionAlignment);
+
+	// Create the cache folder, it already exists after the first beatmap.
+	CreateDirectoryW(cacheFolder, nullptr);
+
+	// Write the buffer to a temporary file.
+	std::wstring tempPath = m_cachePath + L".tmp";
+	HANDLE tempFile = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0UL, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (tempFile == INVALID_HANDLE_VALUE) {
+		// Couldn't create the file, the beatmap is parsed again next time.
+		return FALSE;
+	}
+
+	DWORD bytesWritten = 0UL;
+	bool written = WriteFile(tempFile, buffer.data(), (DWORD)buffer.size(), &bytesWritten, nullptr) && bytesWritten == (DWORD)buffer.size();
+	CloseHandle(tempFile);
+
+	// Replace the old compiled beatmap.
+	if (!written || !MoveFileExW(tempPath.c_str(), m_cachePath.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+		DeleteFileW(tempPath.c_str());
+		return FALSE;
+	}
+
+	return TRUE;
+}
\ No newline at end of file
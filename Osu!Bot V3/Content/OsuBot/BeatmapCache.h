@@ -0,0 +1,91 @@
+// BeatmapCache.h : Declares the class that stores parsed beatmaps in a binary
+// cache file, so queueing the same beatmap again skips the parsing.
+
+#pragma once
+
+#include <Content/OsuBot/Beatmap.h>
+
+
+namespace OsuBot
+{
+	namespace BeatmapInfo
+	{
+		// A class that reads and writes the compiled beatmap of a beatmap file.
+		// The compiled beatmap is identified by the beatmap path, size and last write time.
+		class BeatmapCache {
+		public:
+			// Constructor.
+			explicit BeatmapCache(_In_ const std::wstring& beatmapPath);
+
+			// Member functions.
+			bool LoadBeatmap(_Inout_ Beatmap* beatmap) const;
+			bool SaveBeatmap(_In_ const Beatmap* beatmap) const;
+
+
+		private:
+			// The header at the start of a compiled beatmap file.
+			// The sections follow the header in order, each aligned to 8 bytes:
+			//		Beatmap path			pathLenght wchar_t.
+			//		Metadata				metadataSize char.
+			//		Timing points			timingPointCount TimingPoint.
+			//		Hit object start times	hitObjectCount int.
+			//		Hit object end times	hitObjectCount int.
+			//		Hit object types		hitObjectCount BYTE.
+			//		Hit object positions	hitObjectCount vec2f.
+			//		Hit object stack indices	hitObjectCount int.
+			//		Slider details			hitObjectCount SliderDetails.
+			//		Slider path points		pathPointCount vec2f.
+			//		Slider path lenghts		pathPointCount float.
+			//		Slider events			sliderEventCount SliderEvent.
+			struct FileHeader {
+				// Format checks, a file from another version or build is not used.
+				UINT magic;
+				UINT version;
+				UINT timingPointSize;
+				UINT sliderDetailsSize;
+
+				// The beatmap file the compiled beatmap was made from.
+				ULONGLONG beatmapSize;
+				ULONGLONG beatmapWriteTime;
+
+				// Beatmap values.
+				float stackOffset;
+				float stackLeniency;
+				UINT gameMode;
+				float beatDivisor;
+				Beatmap::MetadataString titleString;
+				Beatmap::MetadataString artistString;
+				Beatmap::MetadataString creatorString;
+				Beatmap::MetadataString versionString;
+				UINT beatmapID;
+				float circleSize;
+				float overallDifficulty;
+				float approachRate;
+				float sliderMultiplier;
+				float sliderTickRate;
+
+				// Section sizes.
+				UINT pathLenght;
+				UINT metadataSize;
+				UINT timingPointCount;
+				UINT hitObjectCount;
+				UINT pathPointCount;
+				UINT sliderEventCount;
+			};
+
+			// Compiled beatmap constants.
+			static const UINT m_magic = 0x4342424F;	// "OBBC"
+			static const UINT m_version = 8U;
+			static const size_t m_sectionAlignment = 8U;
+
+
+		private:
+			// Member variables.
+			std::wstring m_beatmapPath;
+			std::wstring m_cachePath;
+			ULONGLONG m_beatmapSize;
+			ULONGLONG m_beatmapWriteTime;
+			bool m_beatmapFound;
+		};
+	}
+}
\ No newline at end of file
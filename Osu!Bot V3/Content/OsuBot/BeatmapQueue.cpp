@@ -0,0 +1,61 @@
+// BeatmapQueue.cpp : Defines the content in BeatmapQueue.h
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot/BeatmapQueue.h>
+
+
+using namespace OsuBot::BeatmapInfo;
+
+
+// This function adds the parsed beatmap to the end of the queue.
+void BeatmapQueue::Push(_In_ std::unique_ptr<Beatmap> beatmap) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_beatmaps.push_back(std::move(beatmap));
+	m_version++;
+}
+
+// This function removes the beatmap at index from the queue.
+// Pointers to the beatmap can't be used after this.
+void BeatmapQueue::Erase(_In_ const UINT& index) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_beatmaps.erase(m_beatmaps.begin() + index);
+	m_version++;
+}
+
+// This function returns the index of the first beatmap that matches the UTF-8 song name.
+// Returns UINT_MAX when no queued beatmap matches.
+UINT BeatmapQueue::FindSongName(_In_ std::string_view songName) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (UINT i = 0U; i < m_beatmaps.size(); i++) {
+		if (m_beatmaps[i]->MatchesSongName(songName)) {
+			return i;
+		}
+	}
+
+	return UINT_MAX;
+}
+
+// This function returns the beatmap at index, it throws std::out_of_range if there is none.
+const Beatmap* BeatmapQueue::GetBeatmapAtIndex(_In_ const UINT& index) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_beatmaps.at(index).get();
+}
+
+// This function returns the number of queued beatmaps.
+UINT BeatmapQueue::GetCount() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return (UINT)m_beatmaps.size();
+}
+
+// This function returns the version of the queue.
+UINT BeatmapQueue::GetVersion() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_version;
+}
\ No newline at end of file
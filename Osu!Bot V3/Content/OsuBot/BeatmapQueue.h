@@ -0,0 +1,57 @@
+// BeatmapQueue.h : Declares the class that holds the queued beatmaps,
+// shared by the window, bot and HUD threads.
+
+#pragma once
+
+#include <Content/OsuBot/Beatmap.h>
+
+#include <memory>
+#include <mutex>
+
+
+namespace OsuBot
+{
+	namespace BeatmapInfo
+	{
+		// A class that holds the queued beatmaps, every function is thread safe.
+		// Every beatmap is allocated once and never moves, the threads borrow pointers
+		// and references to it instead of copying it.
+		// Only the bot thread removes beatmaps, so the bot can keep its pointers between calls.
+		class BeatmapQueue {
+		public:
+			// Constructor.
+			BeatmapQueue() : m_version(0U) {}
+
+			// Member functions.
+			void Push(_In_ std::unique_ptr<Beatmap> beatmap);
+			void Erase(_In_ const UINT& index);
+			UINT FindSongName(_In_ std::string_view songName) const;
+
+			// Calls the function with every queued beatmap, in order, and returns the version of the queue.
+			// The queue is locked meanwhile, so the beatmaps can't be removed.
+			template <typename Function>
+			UINT ForEach(_In_ Function function) const {
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				for (const std::unique_ptr<Beatmap>& beatmap : m_beatmaps) {
+					function(*beatmap);
+				}
+				return m_version;
+			}
+
+			// Accessor functions.
+			const Beatmap* GetBeatmapAtIndex(_In_ const UINT& index) const;
+			UINT GetCount() const;
+			bool IsEmpty() const { return GetCount() == 0U; }
+			// The version changes every time a beatmap is added or removed.
+			UINT GetVersion() const;
+
+
+		private:
+			// Member variables.
+			mutable std::mutex m_mutex;
+			std::vector<std::unique_ptr<Beatmap>> m_beatmaps;
+			UINT m_version;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+// Bezier.cpp : Defines the functions in Bezier.h
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot/Bezier.h>
+
+#include <algorithm>
+#include <vector>
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <intrin.h>
+#include <immintrin.h>
+#define BEZIER_X86
+#define BEZIER_TARGET_AVX
+#elif defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define BEZIER_X86
+// GCC and clang only compile the AVX kernel for AVX, the rest of the file stays SSE2.
+#define BEZIER_TARGET_AVX __attribute__((target("avx")))
+#endif
+
+
+using namespace OsuBot::BeatmapInfo;
+
+
+namespace
+{
+	// The kernels evaluate the bernstein sum in horner form:
+	//		((P0 * s + C1 * t * P1) * s + C2 * t^2 * P2) * s ... + t^n * Pn, with s = 1 - t.
+	// This needs one multiply per point for s, instead of a pow for every bernstein.
+
+	// Evaluates the curve at one time.
+	vec2f EvaluateScalar(_In_ const vec2f* bezier, _In_ const UINT& degree, _In_ const float* binomials, _In_ const float& time) {
+		float s = 1.f - time;
+		float tPower = 1.f;
+		float x = bezier[0].X * s;
+		float y = bezier[0].Y * s;
+
+		for (UINT i = 1U; i < degree; i++) {
+			tPower = tPower * time;
+			float b = binomials[i] * tPower;
+			x = (x + bezier[i].X * b) * s;
+			y = (y + bezier[i].Y * b) * s;
+		}
+
+		tPower = tPower * time;
+		x = x + bezier[degree].X * tPower;
+		y = y + bezier[degree].Y * tPower;
+
+		return vec2f(x, y);
+	}
+
+	// Evaluates a curve of any degree at one time, in double precision.
+	// De casteljau's algorithm only interpolates between points, so it needs no binomial coefficients.
+	vec2f EvaluateDeCasteljau(_In_ const vec2f* bezier, _In_ const UINT& pointCount, _In_ const double& time, _Inout_ std::vector<double>& coordinates) {
+		coordinates.resize(pointCount * 2U);
+		for (UINT i = 0U; i < pointCount; i++) {
+			coordinates[i * 2U] = bezier[i].X;
+			coordinates[i * 2U + 1U] = bezier[i].Y;
+		}
+
+		// Every pass replaces the points with the points between them, one less each time.
+		for (UINT count = pointCount - 1U; count > 0U; count--) {
+			for (UINT i = 0U; i < count; i++) {
+				coordinates[i * 2U] += (coordinates[i * 2U + 2U] - coordinates[i * 2U]) * time;
+				coordinates[i * 2U + 1U] += (coordinates[i * 2U + 3U] - coordinates[i * 2U + 1U]) * time;
+			}
+		}
+
+		return vec2f(static_cast<float>(coordinates[0]), static_cast<float>(coordinates[1]));
+	}
+
+#ifdef BEZIER_X86
+	// Evaluates the curve at four times.
+	void EvaluateSse2(_In_ const vec2f* bezier, _In_ const UINT& degree, _In_ const float* binomials, _In_ const float* times, _Out_ vec2f* points) {
+		__m128 t = _mm_loadu_ps(times);
+		__m128 s = _mm_sub_ps(_mm_set1_ps(1.f), t);
+		__m128 tPower = _mm_set1_ps(1.f);
+		__m128 x = _mm_mul_ps(_mm_set1_ps(bezier[0].X), s);
+		__m128 y = _mm_mul_ps(_mm_set1_ps(bezier[0].Y), s);
+
+		for (UINT i = 1U; i < degree; i++) {
+			tPower = _mm_mul_ps(tPower, t);
+			__m128 b = _mm_mul_ps(_mm_set1_ps(binomials[i]), tPower);
+			x = _mm_mul_ps(_mm_add_ps(x, _mm_mul_ps(_mm_set1_ps(bezier[i].X), b)), s);
+			y = _mm_mul_ps(_mm_add_ps(y, _mm_mul_ps(_mm_set1_ps(bezier[i].Y), b)), s);
+		}
+
+		tPower = _mm_mul_ps(tPower, t);
+		x = _mm_add_ps(x, _mm_mul_ps(_mm_set1_ps(bezier[degree].X), tPower));
+		y = _mm_add_ps(y, _mm_mul_ps(_mm_set1_ps(bezier[degree].Y), tPower));
+
+		// Interleave the coordinates into points.
+		float* result = reinterpret_cast<float*>(points);
+		_mm_storeu_ps(result, _mm_unpacklo_ps(x, y));
+		_mm_storeu_ps(result + 4, _mm_unpackhi_ps(x, y));
+	}
+
+	// Evaluates the curve at eight times.
+	BEZIER_TARGET_AVX void EvaluateAvx(_In_ const vec2f* bezier, _In_ const UINT& degree, _In_ const float* binomials, _In_ const float* times, _Out_ vec2f* points) {
+		__m256 t = _mm256_loadu_ps(times);
+		__m256 s = _mm256_sub_ps(_mm256_set1_ps(1.f), t);
+		__m256 tPower = _mm256_set1_ps(1.f);
+		__m256 x = _mm256_mul_ps(_mm256_set1_ps(bezier[0].X), s);
+		__m256 y = _mm256_mul_ps(_mm256_set1_ps(bezier[0].Y), s);
+
+		for (UINT i = 1U; i < degree; i++) {
+			tPower = _mm256_mul_ps(tPower, t);
+			__m256 b = _mm256_mul_ps(_mm256_set1_ps(binomials[i]), tPower);
+			x = _mm256_mul_ps(_mm256_add_ps(x, _mm256_mul_ps(_mm256_set1_ps(bezier[i].X), b)), s);
+			y = _mm256_mul_ps(_mm256_add_ps(y, _mm256_mul_ps(_mm256_set1_ps(bezier[i].Y), b)), s);
+		}
+
+		tPower = _mm256_mul_ps(tPower, t);
+		x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_set1_ps(bezier[degree].X), tPower));
+		y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_set1_ps(bezier[degree].Y), tPower));
+
+		// Interleave the coordinates into points, the unpacks work on each 128 bit half.
+		__m256 low = _mm256_unpacklo_ps(x, y);
+		__m256 high = _mm256_unpackhi_ps(x, y);
+
+		float* result = reinterpret_cast<float*>(points);
+		_mm256_storeu_ps(result, _mm256_permute2f128_ps(low, high, 0x20));
+		_mm256_storeu_ps(result + 8, _mm256_permute2f128_ps(low, high, 0x31));
+
+		_mm256_zeroupper();
+	}
+
+	// Returns the state components the operating system saves (XCR0).
+	unsigned long long GetEnabledStates() {
+#ifdef _MSC_VER
+		return _xgetbv(0);
+#else
+		UINT eax, edx;
+		__asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+	}
+
+	// Check if the processor and the operating system support AVX.
+	// SSE2 is always supported by the x86 and x64 builds.
+	bool HasAvx() {
+		UINT ecx;
+#ifdef _MSC_VER
+		int cpuInfo[4];
+		__cpuid(cpuInfo, 1);
+		ecx = static_cast<UINT>(cpuInfo[2]);
+#else
+		UINT eax, ebx, edx;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+			return FALSE;
+		}
+#endif
+
+		// The processor supports AVX (leaf 1, ECX bit 28) and XGETBV (OSXSAVE, ECX bit 27).
+		if ((ecx & (1U << 28)) == 0U || (ecx & (1U << 27)) == 0U) {
+			return FALSE;
+		}
+
+		// The operating system saves the SSE and AVX registers (XCR0 bits 1 and 2).
+		return (GetEnabledStates() & 6U) == 6U;
+	}
+#endif
+}
+
+
+void OsuBot::BeatmapInfo::GetPointsOnBezier(
+	_In_ const vec2f* bezier,
+	_In_ const UINT& pointCount,
+	_In_ const float* times,
+	_In_ const UINT& timeCount,
+	_Out_ vec2f* points
+) {
+	if (pointCount == 0U) {
+		// No curve, no points.
+		return;
+	}
+	else if (pointCount == 1U) {
+		// Every time is on the only point.
+		std::fill(points, points + timeCount, bezier[0]);
+		return;
+	}
+
+	const UINT degree = pointCount - 1U;
+
+	if (degree > maxBatchBezierDegree) {
+		// Curves with too many points are evaluated in double precision.
+		std::vector<double> coordinates;
+		for (UINT i = 0U; i < timeCount; i++) {
+			points[i] = EvaluateDeCasteljau(bezier, pointCount, static_cast<double>(times[i]), coordinates);
+		}
+		return;
+	}
+
+	const float* binomials = pascalTriangle.m_rows[degree];
+
+	UINT i = 0U;
+
+#ifdef BEZIER_X86
+	// The processor is checked once.
+	static const bool hasAvx = HasAvx();
+
+	if (hasAvx) {
+		for (; i + 8U <= timeCount; i += 8U) {
+			EvaluateAvx(bezier, degree, binomials, times + i, points + i);
+		}
+	}
+	for (; i + 4U <= timeCount; i += 4U) {
+		EvaluateSse2(bezier, degree, binomials, times + i, points + i);
+	}
+#endif
+
+	// The remaining times.
+	for (; i < timeCount; i++) {
+		points[i] = EvaluateScalar(bezier, degree, binomials, times[i]);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+// Bezier.h : Declares the functions that evaluate a bezier curve at many times
+// at once, with SSE2 or AVX when the processor supports it.
+// And evaluators for curves with a degree known at compile time.
+
+#pragma once
+
+#include <Common/Vec2f.h>
+
+
+namespace OsuBot
+{
+	namespace BeatmapInfo
+	{
+		// The highest degree that is evaluated in batches.
+		// The binomial coefficients of higher degrees lose too much precision as floats.
+		constexpr UINT maxBatchBezierDegree = 64U;
+
+		// The binomial coefficients of every degree up to maxBatchBezierDegree,
+		// m_rows[n][i] is n choose i.
+		struct PascalTriangle {
+			float m_rows[maxBatchBezierDegree + 1U][maxBatchBezierDegree + 1U];
+		};
+
+		// Builds pascal's triangle, every coefficient is the sum of the two above it.
+		constexpr PascalTriangle MakePascalTriangle() {
+			double rows[maxBatchBezierDegree + 1U][maxBatchBezierDegree + 1U] = {};
+			PascalTriangle triangle = {};
+
+			for (UINT n = 0U; n <= maxBatchBezierDegree; n++) {
+				rows[n][0] = 1.0;
+				rows[n][n] = 1.0;
+				for (UINT i = 1U; i < n; i++) {
+					rows[n][i] = rows[n - 1U][i - 1U] + rows[n - 1U][i];
+				}
+				for (UINT i = 0U; i <= n; i++) {
+					triangle.m_rows[n][i] = static_cast<float>(rows[n][i]);
+				}
+			}
+
+			return triangle;
+		}
+
+		inline constexpr PascalTriangle pascalTriangle = MakePascalTriangle();
+
+		// Returns the point on a bezier curve of degree + 1 points with time 0 - 1.
+		// The degree is known at compile time, so the loop is unrolled.
+		// Degrees 1 - 3 are written out, higher degrees use the coefficients of pascal's triangle.
+		template <UINT degree>
+		inline vec2f GetPointOnBezier(
+			_In_ const vec2f* bezier,
+			_In_ const float& time
+		) {
+			static_assert(degree >= 1U && degree <= maxBatchBezierDegree, "GetPointOnBezier: unsupported degree");
+
+			// The bernstein sum in horner form, as in GetPointsOnBezier.
+			constexpr const float* binomials = pascalTriangle.m_rows[degree];
+			float s = 1.f - time;
+			float tPower = 1.f;
+			float x = bezier[0].X * s;
+			float y = bezier[0].Y * s;
+
+			for (UINT i = 1U; i < degree; i++) {
+				tPower = tPower * time;
+				float b = binomials[i] * tPower;
+				x = (x + bezier[i].X * b) * s;
+				y = (y + bezier[i].Y * b) * s;
+			}
+
+			tPower = tPower * time;
+			return vec2f(x + bezier[degree].X * tPower, y + bezier[degree].Y * tPower);
+		}
+
+		// A line.
+		template <>
+		inline vec2f GetPointOnBezier<1U>(
+			_In_ const vec2f* bezier,
+			_In_ const float& time
+		) {
+			float s = 1.f - time;
+
+			return vec2f(
+				bezier[0].X * s + bezier[1].X * time,
+				bezier[0].Y * s + bezier[1].Y * time
+			);
+		}
+
+		// A quadratic curve.
+		template <>
+		inline vec2f GetPointOnBezier<2U>(
+			_In_ const vec2f* bezier,
+			_In_ const float& time
+		) {
+			float s = 1.f - time;
+			float b0 = s * s;
+			float b1 = 2.f * s * time;
+			float b2 = time * time;
+
+			return vec2f(
+				bezier[0].X * b0 + bezier[1].X * b1 + bezier[2].X * b2,
+				bezier[0].Y * b0 + bezier[1].Y * b1 + bezier[2].Y * b2
+			);
+		}
+
+		// A cubic curve.
+		template <>
+		inline vec2f GetPointOnBezier<3U>(
+			_In_ const vec2f* bezier,
+			_In_ const float& time
+		) {
+			float s = 1.f - time;
+			float s2 = s * s;
+			float t2 = time * time;
+			float b0 = s2 * s;
+			float b1 = 3.f * s2 * time;
+			float b2 = 3.f * s * t2;
+			float b3 = t2 * time;
+
+			return vec2f(
+				bezier[0].X * b0 + bezier[1].X * b1 + bezier[2].X * b2 + bezier[3].X * b3,
+				bezier[0].Y * b0 + bezier[1].Y * b1 + bezier[2].Y * b2 + bezier[3].Y * b3
+			);
+		}
+
+		// Evaluates the bezier curve at every time (0.0 - 1.0) in times,
+		// the points are written to points in the same order.
+		// Every processor gives the same points, the SIMD and scalar code do the same float operations.
+		void GetPointsOnBezier(
+			_In_ const vec2f* bezier,
+			_In_ const UINT& pointCount,
+			_In_ const float* times,
+			_In_ const UINT& timeCount,
+			_Out_ vec2f* points
+		);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+// BotEnvironment.cpp : Defines the content in BotEnvironment.h
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot/BotEnvironment.h>
+
+
+using namespace OsuBot;
+
+
+// This function returns the playfield geometry of a game window.
+// The playfield is scaled to the height of a 4:3 area centered in the client area.
+WindowGeometry OsuBot::GetWindowGeometry(_In_ const POINT& clientOrigin, _In_ const int& clientWidth, _In_ const int& clientHeight) {
+	WindowGeometry geometry;
+
+	// Get x,y multipliers for the movement calculations.
+	int sWidth = clientWidth;
+	int sHeight = clientHeight;
+
+	if (sWidth * 3 > sHeight * 4) {
+		sWidth = sHeight * 4 / 3;
+	}
+	else {
+		sHeight = sWidth * 3 / 4;
+	}
+
+	geometry.m_multiplier.Width = sWidth / 640.f;
+	geometry.m_multiplier.Height = sHeight / 480.f;
+
+	// Get the x,y offsets for the movement calculations.
+	int xOffset = (INT)floorf(clientWidth - 512.f * geometry.m_multiplier.Width) / 2;
+	int yOffset = (INT)floorf(clientHeight - 384.f * geometry.m_multiplier.Height) / 2;
+
+	geometry.m_offset.Width = clientOrigin.x + xOffset;
+	geometry.m_offset.Height = clientOrigin.y + yOffset;
+
+	return geometry;
+}
+
+
+// This function reads the song time from the game memory.
+// The last song time is returned while the time address is not found.
+double GameSongClock::GetSongTime() {
+	// Check if time address is set.
+	if (!m_timeAddress) {
+		// Find the time address.
+		GetTimeAddress();
+	}
+
+	if (m_timeAddress) {
+		// Read the new song time from memory to m_songTime.
+		ReadProcessMemory(m_gameProcessHandle, reinterpret_cast<LPVOID>(*m_timeAddress.get()), &m_songTime, sizeof(DOUBLE), nullptr);
+	}
+
+	return m_songTime;
+}
+
+// This function is used to get the time address of the game.
+void GameSongClock::GetTimeAddress() {
+	// First find the process.
+	if (m_sigScanner.GetProcess(L"osu!.exe")) {
+		// Then set store the process handle in m_gameProcessHandle.
+		m_gameProcessHandle = m_sigScanner.GetTargetProcessHandle();
+
+		// Now find the signature in the process memory space.
+		m_sigScanner.FindSignature(&m_timeAddressSignature);
+
+		// Continue if the signature was found.
+		if (m_sigScanner.SigFound()) {
+			DWORD sigAddress = m_sigScanner.GetResultAddress();
+
+			// Offset the sig to the timeAddress.
+			sigAddress -= 0xA;
+
+			// Get the time address from the result.
+			DWORD resultAddress;
+			ReadProcessMemory(m_gameProcessHandle, reinterpret_cast<LPCVOID>(sigAddress), &resultAddress, 4UL, nullptr);
+
+			// Store the resulting address in m_timeAddress.
+			m_timeAddress = std::make_unique<DWORD>(resultAddress);
+		}
+	}
+}
+
+
+// Constructor.
+Win32OutputSink::Win32OutputSink() {
+	// Initialize the input.
+	ZeroMemory(&m_input, sizeof(m_input));
+	m_input.type = INPUT_MOUSE;
+}
+
+// This function returns the position of the system cursor.
+POINT Win32OutputSink::GetCursorPosition() {
+	POINT cursorPosition = { 0, 0 };
+	GetCursorPos(&cursorPosition);
+
+	return cursorPosition;
+}
+
+// This function moves the system cursor.
+void Win32OutputSink::SetCursorPosition(_In_ const int& x, _In_ const int& y) {
+	SetCursorPos(x, y);
+}
+
+// This function presses the left mouse button.
+void Win32OutputSink::Press() {
+	m_input.mi.dwFlags = MOUSEEVENTF_LEFTDOWN;
+	SendInput(1U, &m_input, sizeof(m_input));
+}
+
+// This function releases the left mouse button.
+void Win32OutputSink::Release() {
+	m_input.mi.dwFlags = MOUSEEVENTF_LEFTUP;
+	SendInput(1U, &m_input, sizeof(m_input));
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+// BotEnvironment.h : Declares the interfaces the bot uses to read the song time and to
+// move the cursor and click, and their implementations for the game.
+
+#pragma once
+
+#include <Content/OsuBot/SigScan.h>
+
+
+namespace OsuBot
+{
+	// Provides an interface for the bot to read the song time.
+	class ISongClock {
+	public:
+		virtual ~ISongClock() = default;
+
+		// Returns the song time in milliseconds.
+		virtual double GetSongTime() = 0;
+	};
+
+	// Provides an interface for the bot to move the cursor and click.
+	// The positions are in screen pixels.
+	class IOutputSink {
+	public:
+		virtual ~IOutputSink() = default;
+
+		virtual POINT GetCursorPosition() = 0;
+		virtual void SetCursorPosition(_In_ const int& x, _In_ const int& y) = 0;
+		virtual void Press() = 0;
+		virtual void Release() = 0;
+	};
+
+	// The playfield (512x384 osu!pixels) in the game window.
+	struct WindowGeometry {
+		// The screen position of the playfield.
+		DX::Size<INT> m_offset;
+		// Screen pixels per osu!pixel.
+		DX::Size<FLOAT> m_multiplier;
+	};
+
+	// Returns the playfield geometry of a game window, from the screen position and size of its client area.
+	WindowGeometry GetWindowGeometry(_In_ const POINT& clientOrigin, _In_ const int& clientWidth, _In_ const int& clientHeight);
+
+
+	// Reads the song time from the memory of the game.
+	// The time address is found with the signature the first time the song time is read.
+	class GameSongClock : public ISongClock {
+	public:
+		// Constructor.
+		GameSongClock(_In_ SigScan::SigScanner& sigScanner, _In_ const std::wstring& timeAddressSignature) :
+			m_sigScanner(sigScanner),
+			m_timeAddressSignature(timeAddressSignature),
+			m_gameProcessHandle(nullptr),
+			m_timeAddress(nullptr),
+			m_songTime(0.0)
+		{}
+
+		double GetSongTime() override;
+
+		// Forgets the time address, it is found again when the game is started again.
+		void Reset() { m_timeAddress.reset(); }
+
+		// Accessor functions.
+		bool IsSignatureFound() const { return m_timeAddress != nullptr; }
+
+
+	private:
+		// Internal functions.
+		void GetTimeAddress();
+
+	private:
+		// Member variables.
+		SigScan::SigScanner& m_sigScanner;
+		std::wstring m_timeAddressSignature;
+		HANDLE m_gameProcessHandle;
+		std::unique_ptr<DWORD> m_timeAddress;
+		double m_songTime;
+	};
+
+	// Moves the cursor and clicks with the left mouse button of the system.
+	class Win32OutputSink : public IOutputSink {
+	public:
+		// Constructor.
+		Win32OutputSink();
+
+		POINT GetCursorPosition() override;
+		void SetCursorPosition(_In_ const int& x, _In_ const int& y) override;
+		void Press() override;
+		void Release() override;
+
+
+	private:
+		// Member variables.
+		INPUT m_input;
+	};
+}
\ No newline at end of file
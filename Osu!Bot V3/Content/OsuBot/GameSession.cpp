@@ -0,0 +1,178 @@
+// GameSession.cpp : Defines the Bot functions that follow the game,
+// its window, the song it plays, and the autoplay loop that plays it.
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot.h>
+#include <Content/AppMain.h>
+
+
+using namespace OsuBot;
+
+
+// This function should only be used to check if the game is running or not.
+// When the game is active (running) it updates the screen metrics if the 
+// target rect changed. And sets m_targetHwnd to a valid HWND.
+void Bot::CheckGameActive(const LPVOID& main) {
+	if (m_targetHwnd == NULL) {
+		// Get the HWND if not yet set.
+		m_targetHwnd = FindWindowW(NULL, L"osu!");
+	}
+	else if (m_logicTimer.GetFrameCount() == m_timerFrameCount) {
+		// Only continue the function if the logic timer has made a tick.
+		return;
+	}
+	else {
+		// Update the elapsed frame count.
+		m_timerFrameCount = m_logicTimer.GetFrameCount();
+
+		WCHAR buffer[MAX_LOADSTRING];
+
+		// Check if the game is still running.
+		GetWindowTextW(m_targetHwnd, buffer, MAX_LOADSTRING);
+		m_gameTitle.assign(buffer);
+		if (m_gameTitle == L"" && !m_songStarted) {
+			m_targetHwnd = FindWindowW(NULL, L"osu!");
+			if (m_targetHwnd == NULL) {
+				// The game has exited.
+				m_targetHwnd = NULL;
+				m_sigFound = FALSE;
+				m_gameSongClock.Reset();
+			}
+		}
+		else {
+			if ((*reinterpret_cast<const std::shared_ptr<OsuBot::AppMain>*>(main))->m_deviceResources->m_drawing == FALSE) {
+				(*reinterpret_cast<const std::shared_ptr<OsuBot::AppMain>*>(main))->m_deviceResources->m_resizeing = TRUE;
+
+				// Get the current working rect.
+				(*reinterpret_cast<const std::shared_ptr<OsuBot::AppMain>*>(main))->GetWorkingRect();
+
+				(*reinterpret_cast<const std::shared_ptr<OsuBot::AppMain>*>(main))->m_deviceResources->m_resizeing = FALSE;
+			}
+
+			RECT rect;
+			CopyRect(&rect, &((*reinterpret_cast<const std::shared_ptr<OsuBot::AppMain>*>(main))->m_rect));
+
+			// Check if the working rect changed.
+			if (!EqualRect(&rect, &m_targetRect)) {
+				// Get the new screen metrics.
+				RECT clientRect;
+				POINT w = { 0, 6 };
+				GetClientRect(m_targetHwnd, &clientRect);
+				ClientToScreen(m_targetHwnd, &w);
+
+				int x = min(clientRect.right, GetSystemMetrics(SM_CXSCREEN));
+				int	y = min(clientRect.bottom, GetSystemMetrics(SM_CXSCREEN));
+
+				SetWindowGeometry(GetWindowGeometry(w, x, y));
+
+				CopyRect(&m_targetRect, &rect);
+			}
+		}
+	}
+}
+
+// This function should be called every time the bot logic updates.
+// To check whether the song is playing, paused, or stopped.
+void Bot::CheckSongActive() {
+	// Check if the songs folder has been assigned.
+	if (m_songsFolderPath != L"") {
+		if (m_gameTitle != L"osu!" && m_gameTitle != L"") {
+			// Check if the song has been paused.
+			if (m_songStarted && GetSongTime() == m_prevSongTime) {
+				m_songPaused = TRUE;
+
+				ClipCursor(nullptr);
+			}
+			else {
+				m_songPaused = FALSE;
+
+				ClipCursor(&m_targetRect);
+			}
+
+			// Get the current beatmap name and difficulty.
+			GetCurrentSong();
+
+			if (m_beatmapAuto) {
+				// Find the beatmap set with the beatmap name.
+				// TODO: Implement auto beatmap search function.
+			}
+			else {
+				// Check for beatmaps in the queue.
+				if (m_beatmapQueue.IsEmpty()) {
+					// No beatmaps queued don't start the autoplay.
+					m_songStarted = FALSE;
+
+					// Send notification to user that no beatmaps were queued.
+					static bool warning = FALSE;
+					if (!warning) {
+						OutputDebugStringW(L"WARNING : No beatmaps queued to select the currently playing song from.\n");
+						warning = TRUE;
+					}
+				}
+				else {
+					// Check any queued map matches current selected map.
+					// The beatmap metadata is UTF-8, compare with the song name converted once.
+					std::string currentSongName = WideToUtf8(m_currentSongName);
+					std::wstring songName = L"Idle";
+
+					UINT beatmapIndex = m_beatmapQueue.FindSongName(currentSongName);
+					if (beatmapIndex != UINT_MAX) {
+						songName = m_currentSongName;
+						m_songStarted = TRUE;
+						m_selectedBeatmapIndex = beatmapIndex;
+
+						ClipCursor(&m_targetRect);
+					}
+					m_songName = songName;
+				}
+			}
+		}
+		else if (m_songStarted && m_songName != L"Idle") {
+			// Not playing a beatmap anymore. Reset the current state.
+			m_songStarted = FALSE;
+			m_songPaused = FALSE;
+			m_beatmapFinished = TRUE;
+
+			m_hitObjectIndex = 0U;
+			m_hasCursorSegment = FALSE;
+			m_recompiledPlanBeatmap = nullptr;
+			m_songName = L"Idle";
+
+			ClipCursor(nullptr);
+		}
+		else if (!m_beatmapQueue.IsEmpty() && m_beatmapFinished && m_selectedBeatmapIndex != UINT_MAX) {
+			try {
+				// Remove the beatmap from the queue.
+				m_beatmapQueue.Erase(m_selectedBeatmapIndex);
+
+				m_beatmapFinished = FALSE;
+			}
+			catch (...) {
+				// Oops something when wrong while trying to delete a beatmap from the queue.
+				// TODO: Throw error if needed.
+
+			}
+			m_selectedBeatmapIndex = UINT_MAX;
+		}
+	}
+	else {
+		// The songs folder was not assigned, get the folder from the osu!.exe.
+		GetSongsFolderPath();
+	}
+}
+
+// This function handles the autoplay feature of OsuBot.
+void Bot::AutoPlay() {
+	// Don't make unnecessary updates.
+	m_logicTimer.Tick([&]() {
+		// Update the song time.
+		UpdateSongTime();
+
+		// Check if the song is playing.
+		CheckSongActive();
+
+		// Play the hit objects at the song time.
+		PlayHitObjects();
+	});
+}
\ No newline at end of file
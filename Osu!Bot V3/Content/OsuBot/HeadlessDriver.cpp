@@ -0,0 +1,88 @@
+// HeadlessDriver.cpp : Defines the content in HeadlessDriver.h
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot/HeadlessDriver.h>
+
+#include <chrono>
+
+
+using namespace OsuBot;
+
+
+// This function records a move of the cursor.
+void RecordingOutputSink::SetCursorPosition(_In_ const int& x, _In_ const int& y) {
+	m_cursorPosition = { x, y };
+	m_events.push_back({ m_songClock.GetSongTime(), m_cursorPosition, OutputEvent::Move });
+}
+
+// This function records a press of the button.
+void RecordingOutputSink::Press() {
+	m_events.push_back({ m_songClock.GetSongTime(), m_cursorPosition, OutputEvent::Press });
+}
+
+// This function records a release of the button.
+void RecordingOutputSink::Release() {
+	m_events.push_back({ m_songClock.GetSongTime(), m_cursorPosition, OutputEvent::Release });
+}
+
+
+// Constructor.
+HeadlessDriver::HeadlessDriver(_In_ const DX::Size<INT>& windowSize, _In_ const UINT& updatesPerSecond, _In_opt_ const bool& useBeatmapCache) :
+	m_windowSize(windowSize),
+	m_updatesPerSecond((std::max)(updatesPerSecond, 1U)),
+	m_useBeatmapCache(useBeatmapCache),
+	m_tickCount(0U),
+	m_elapsedSeconds(0.0)
+{}
+
+// This function plays the beatmap, the events and tick statistics are kept until the next song.
+bool HeadlessDriver::Play(_In_ const std::wstring& beatmapPath) {
+	// The cursor starts in the center of the window.
+	const POINT windowOrigin = { 0, 0 };
+	m_outputSink = std::make_unique<RecordingOutputSink>(m_songClock, POINT{ m_windowSize.Width / 2, m_windowSize.Height / 2 });
+	m_tickCount = 0U;
+	m_elapsedSeconds = 0.0;
+
+	// The bot plays with the synthetic song clock and records its output, without a song time offset.
+	Bot bot(m_updatesPerSecond, 0.0, L"");
+	bot.RegisterSongClock(&m_songClock);
+	bot.RegisterOutputSink(m_outputSink.get());
+	bot.SetBeatmapCacheEnabled(m_useBeatmapCache);
+
+	// Set the window geometry first, the moves are compiled with it when the beatmap is queued.
+	bot.SetWindowGeometry(GetWindowGeometry(windowOrigin, m_windowSize.Width, m_windowSize.Height));
+	bot.AddBeatmapToQueue(beatmapPath);
+	if (bot.m_beatmapQueue.IsEmpty()) {
+		return FALSE;
+	}
+
+	const BeatmapInfo::Beatmap* beatmap = bot.GetBeatmapAtIndex(0U);
+	const UINT hitObjectCount = beatmap->GetHitObjectsCount();
+	if (hitObjectCount == 0U) {
+		return TRUE;
+	}
+
+	// The song time of every tick is calculated from the tick index, so it does not drift.
+	const double beginTime = beatmap->GetHitObjectAtIndex(0U).GetStartTime() - 1000.0;
+	const double endTime = beatmap->GetHitObjectAtIndex(hitObjectCount - 1U).GetEndTime() + 1000.0;
+	const UINT tickCount = static_cast<UINT>((endTime - beginTime) * m_updatesPerSecond / 1000.0) + 1U;
+
+	m_songClock.SetSongTime(beginTime);
+	bot.StartSong(0U);
+
+	const auto startTime = std::chrono::steady_clock::now();
+	for (UINT tick = 0U; tick < tickCount; tick++) {
+		// Multiply before dividing, so the ticks of different update rates at the same time are equal.
+		m_songClock.SetSongTime(beginTime + tick * 1000.0 / m_updatesPerSecond);
+
+		bot.UpdateSongTime();
+		bot.PlayHitObjects();
+	}
+	const auto stopTime = std::chrono::steady_clock::now();
+
+	m_tickCount = tickCount;
+	m_elapsedSeconds = std::chrono::duration<double>(stopTime - startTime).count();
+
+	return TRUE;
+}
\ No newline at end of file
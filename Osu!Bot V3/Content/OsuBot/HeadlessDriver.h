@@ -0,0 +1,107 @@
+// HeadlessDriver.h : Declares a driver that plays a beatmap with the bot logic
+// against a synthetic song clock, without the game, and records everything the bot outputs.
+
+#pragma once
+
+#include <Content/OsuBot.h>
+
+#include <memory>
+#include <vector>
+
+
+namespace OsuBot
+{
+	// A song clock that is set by the driver.
+	class SyntheticSongClock : public ISongClock {
+	public:
+		// Constructor.
+		SyntheticSongClock() :
+			m_songTime(0.0)
+		{}
+
+		double GetSongTime() override { return m_songTime; }
+		void SetSongTime(_In_ const double& songTime) { m_songTime = songTime; }
+
+
+	private:
+		// Member variables.
+		double m_songTime;
+	};
+
+	// A cursor position or click of the bot, at the song time of the tick.
+	struct OutputEvent {
+		// The kinds of output events.
+		enum outputEventTypes : BYTE {
+			Move,
+			Press,
+			Release
+		};
+
+		double m_songTime;
+		POINT m_position;
+		BYTE m_type;
+	};
+
+	// An output sink that records the events instead of moving the cursor.
+	class RecordingOutputSink : public IOutputSink {
+	public:
+		// Constructor.
+		// The cursor starts at the position, the song time of the events is read from the song clock.
+		RecordingOutputSink(_In_ SyntheticSongClock& songClock, _In_ const POINT& cursorPosition) :
+			m_songClock(songClock),
+			m_cursorPosition(cursorPosition)
+		{}
+
+		POINT GetCursorPosition() override { return m_cursorPosition; }
+		void SetCursorPosition(_In_ const int& x, _In_ const int& y) override;
+		void Press() override;
+		void Release() override;
+
+		// Accessor functions.
+		const std::vector<OutputEvent>& GetEvents() const { return m_events; }
+
+
+	private:
+		// Member variables.
+		SyntheticSongClock& m_songClock;
+		POINT m_cursorPosition;
+		std::vector<OutputEvent> m_events;
+	};
+
+	// A class that plays a beatmap with a fixed number of updates per second of song time.
+	// The bot only sees the synthetic song clock, the window geometry and the recording output sink,
+	// so the same beatmap, window size and update rate always give the same events.
+	class HeadlessDriver {
+	public:
+		// Constructor.
+		// The game window is at the origin of the screen, with a client area of the window size (in pixels).
+		// The beatmap cache is not used by default, so playing a beatmap doesn't read or write compiled beatmaps.
+		HeadlessDriver(_In_ const DX::Size<INT>& windowSize, _In_ const UINT& updatesPerSecond, _In_opt_ const bool& useBeatmapCache = FALSE);
+
+		// Member functions.
+		// Plays the beatmap from a second before its first hit object until a second after its last one.
+		// Returns FALSE if the beatmap could not be queued.
+		bool Play(_In_ const std::wstring& beatmapPath);
+
+		// Accessor functions.
+		const std::vector<OutputEvent>& GetEvents() const { return m_outputSink->GetEvents(); }
+		UINT GetTickCount() const { return m_tickCount; }
+		double GetElapsedSeconds() const { return m_elapsedSeconds; }
+		double GetTicksPerSecond() const { return (m_elapsedSeconds > 0.0) ? m_tickCount / m_elapsedSeconds : 0.0; }
+		double GetNanosecondsPerTick() const { return (m_tickCount > 0U) ? m_elapsedSeconds * 1000000000.0 / m_tickCount : 0.0; }
+
+
+	private:
+		// Member variables.
+		DX::Size<INT> m_windowSize;
+		UINT m_updatesPerSecond;
+		bool m_useBeatmapCache;
+
+		SyntheticSongClock m_songClock;
+		std::unique_ptr<RecordingOutputSink> m_outputSink;
+
+		// The ticks of the last song, and the wall time they took (not including queueing the beatmap).
+		UINT m_tickCount;
+		double m_elapsedSeconds;
+	};
+}
\ No newline at end of file
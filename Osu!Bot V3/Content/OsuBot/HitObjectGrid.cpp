@@ -0,0 +1,85 @@
+// HitObjectGrid.cpp : Defines the content in HitObjectGrid.h
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot/HitObjectGrid.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+using namespace OsuBot::BeatmapInfo;
+
+
+// This function sorts the positions into the buckets, in order of index.
+void HitObjectGrid::Build() {
+	const UINT hitObjectCount = m_hitObjects->GetCount();
+	m_isBuilt = TRUE;
+
+	// A power of two buckets, at least one for every hit object.
+	UINT bucketCount = 1U;
+	while (bucketCount < hitObjectCount) {
+		bucketCount *= 2U;
+	}
+	m_bucketMask = bucketCount - 1U;
+
+	// Count the positions of every bucket, then place them (a counting sort).
+	m_bucketStarts.assign(bucketCount + 1U, 0U);
+	for (UINT index = 0U; index < hitObjectCount; index++) {
+		if (Contains(index)) {
+			const vec2f position = GetPosition(index);
+			m_bucketStarts[GetBucket(GetCell(position.X), GetCell(position.Y)) + 1U]++;
+		}
+	}
+	for (UINT bucket = 1U; bucket <= bucketCount; bucket++) {
+		m_bucketStarts[bucket] += m_bucketStarts[bucket - 1U];
+	}
+
+	std::vector<UINT> bucketEnds(m_bucketStarts.begin(), m_bucketStarts.end() - 1);
+	m_sortedEntries.resize(m_bucketStarts.back());
+	for (UINT index = 0U; index < hitObjectCount; index++) {
+		if (Contains(index)) {
+			const vec2f position = GetPosition(index);
+			m_sortedEntries[bucketEnds[GetBucket(GetCell(position.X), GetCell(position.Y))]++] = { index, position };
+		}
+	}
+}
+
+// This function returns the cell of a coordinate.
+// Coordinates far outside of the playfield are clamped, they only share the outer cells.
+int HitObjectGrid::GetCell(_In_ const float& coordinate) const {
+	return static_cast<int>(std::floor(CLAMP(-1000000.f, coordinate / m_cellSize, 1000000.f)));
+}
+
+// This function returns the bucket of a cell.
+UINT HitObjectGrid::GetBucket(_In_ const int& cellX, _In_ const int& cellY) const {
+	return ((static_cast<UINT>(cellX) * 73856093U) ^ (static_cast<UINT>(cellY) * 19349663U)) & m_bucketMask;
+}
+
+// This function gets the buckets of the cells that hold the positions closer than distance to the point.
+// Cells that share a bucket are only returned once, returns the number of buckets.
+UINT HitObjectGrid::GetBuckets(_In_ const vec2f& point, _In_ const float& distance, _Out_ UINT* buckets) const {
+	const int cellX0 = GetCell(point.X - distance);
+	const int cellY0 = GetCell(point.Y - distance);
+	const int cellX1 = GetCell(point.X + distance);
+	const int cellY1 = GetCell(point.Y + distance);
+
+	UINT bucketCount = 0U;
+	for (int cellY = cellY0; cellY <= cellY1; cellY++) {
+		for (int cellX = cellX0; cellX <= cellX1; cellX++) {
+			const UINT bucket = GetBucket(cellX, cellY);
+			if (std::find(buckets, buckets + bucketCount, bucket) == buckets + bucketCount) {
+				buckets[bucketCount++] = bucket;
+			}
+		}
+	}
+
+	return bucketCount;
+}
+
+// This function returns the first entry with an index that is not lower than index.
+const HitObjectGrid::Entry* HitObjectGrid::FindEntry(_In_ const Entry* begin, _In_ const Entry* end, _In_ const UINT& index) {
+	return std::lower_bound(begin, end, index, [](const Entry& entry, const UINT& index) {
+		return entry.index < index;
+	});
+}
\ No newline at end of file
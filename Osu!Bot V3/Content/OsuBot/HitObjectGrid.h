@@ -0,0 +1,151 @@
+// HitObjectGrid.h : Declares the class that finds the hit objects near a point,
+// used to find stacked hit objects without comparing every pair of them.
+
+#pragma once
+
+#include <Content/OsuBot/Beatmap.h>
+
+#include <vector>
+
+
+namespace OsuBot
+{
+	namespace BeatmapInfo
+	{
+		// A class that finds the hit objects in a range of indices (a time window) near a point.
+		// Short ranges are checked one by one. For long ranges the positions are put in a grid of square cells
+		// the first time, the cells are hashed into as many buckets as there are hit objects so positions
+		// far outside of the playfield cost nothing. The positions of a bucket are sorted by hit object index,
+		// so the range is found in a bucket with a binary search.
+		class HitObjectGrid {
+		public:
+			// The index that is returned when no hit object is found.
+			constexpr static UINT noHitObject = UINT_MAX;
+
+			// Constructor.
+			// The grid holds the start positions of the hit objects, or the end positions of the sliders.
+			// Queries should use a distance up to maxDistance, a query then looks in at most 4 cells.
+			HitObjectGrid(_In_ const HitObjectTable* hitObjects, _In_ const bool& sliderEnds, _In_ const float& maxDistance) :
+				m_hitObjects(hitObjects),
+				m_sliderEnds(sliderEnds),
+				m_cellSize(2.f * maxDistance),
+				m_bucketMask(0U),
+				m_isBuilt(FALSE)
+			{}
+
+			// Member functions.
+			// Returns the highest index in [first, last) that is closer than distance to the point
+			// and passes the filter, or noHitObject.
+			template <typename Filter>
+			UINT FindLast(_In_ const vec2f& point, _In_ const float& distance, _In_ const UINT& first, _In_ const UINT& last, _In_ Filter filter) {
+				// The last indices are checked one by one, the hit objects of a stack usually follow each other.
+				const UINT scanFirst = (last - first > m_maxScanCount) ? last - m_maxScanCount : first;
+				for (UINT index = last; index > scanFirst; ) {
+					--index;
+					if (Contains(index) && (GetPosition(index) - point).Length() < distance && filter(index)) {
+						return index;
+					}
+				}
+				if (scanFirst == first) {
+					return noHitObject;
+				}
+
+				if (!m_isBuilt) {
+					Build();
+				}
+
+				UINT result = noHitObject;
+				UINT buckets[4];
+				const UINT bucketCount = GetBuckets(point, distance, buckets);
+
+				for (UINT i = 0U; i < bucketCount; i++) {
+					const Entry* bucketBegin = m_sortedEntries.data() + m_bucketStarts[buckets[i]];
+					const Entry* bucketEnd = m_sortedEntries.data() + m_bucketStarts[buckets[i] + 1U];
+
+					// Walk down from the last entry before the checked indices, a higher index than the result wins.
+					const UINT lowest = (result == noHitObject) ? first : result + 1U;
+					for (const Entry* entry = FindEntry(bucketBegin, bucketEnd, scanFirst); entry != bucketBegin && (entry - 1)->index >= lowest; ) {
+						--entry;
+						if ((entry->position - point).Length() < distance && filter(entry->index)) {
+							result = entry->index;
+							break;
+						}
+					}
+				}
+
+				return result;
+			}
+
+			// Calls the function with every index in [first, last) that is closer than distance to the point.
+			template <typename Function>
+			void ForEach(_In_ const vec2f& point, _In_ const float& distance, _In_ const UINT& first, _In_ const UINT& last, _In_ Function function) {
+				if (last - first <= m_maxScanCount) {
+					// A short range is checked one by one.
+					for (UINT index = first; index < last; index++) {
+						if (Contains(index) && (GetPosition(index) - point).Length() < distance) {
+							function(index);
+						}
+					}
+					return;
+				}
+
+				if (!m_isBuilt) {
+					Build();
+				}
+
+				UINT buckets[4];
+				const UINT bucketCount = GetBuckets(point, distance, buckets);
+
+				for (UINT i = 0U; i < bucketCount; i++) {
+					const Entry* bucketBegin = m_sortedEntries.data() + m_bucketStarts[buckets[i]];
+					const Entry* bucketEnd = m_sortedEntries.data() + m_bucketStarts[buckets[i] + 1U];
+
+					for (const Entry* entry = FindEntry(bucketBegin, bucketEnd, first); entry != bucketEnd && entry->index < last; ++entry) {
+						if ((entry->position - point).Length() < distance) {
+							function(entry->index);
+						}
+					}
+				}
+			}
+
+
+		private:
+			// A hit object position.
+			struct Entry {
+				UINT index;
+				vec2f position;
+			};
+
+			// Internal functions.
+			bool Contains(_In_ const UINT& index) const {
+				return !m_sliderEnds || m_hitObjects->m_objectTypes[index] == HITOBJECT_SLIDER;
+			}
+			vec2f GetPosition(_In_ const UINT& index) const {
+				return m_sliderEnds ? m_hitObjects->m_sliderDetails[index].m_endPosition : m_hitObjects->m_startPositions[index];
+			}
+
+			void Build();
+			int GetCell(_In_ const float& coordinate) const;
+			UINT GetBucket(_In_ const int& cellX, _In_ const int& cellY) const;
+			UINT GetBuckets(_In_ const vec2f& point, _In_ const float& distance, _Out_ UINT* buckets) const;
+			static const Entry* FindEntry(_In_ const Entry* begin, _In_ const Entry* end, _In_ const UINT& index);
+
+		private:
+			// The most indices of a query that are checked one by one before the buckets are used.
+			constexpr static UINT m_maxScanCount = 32U;
+
+			// Member variables.
+			const HitObjectTable* m_hitObjects;
+			bool m_sliderEnds;
+
+			float m_cellSize;
+			UINT m_bucketMask;
+			bool m_isBuilt;
+
+			// The positions sorted by bucket and then by index.
+			std::vector<Entry> m_sortedEntries;
+			// The first sorted entry of every bucket, and the end of the last bucket.
+			std::vector<UINT> m_bucketStarts;
+		};
+	}
+}
\ No newline at end of file
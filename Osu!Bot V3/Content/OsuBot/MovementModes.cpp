@@ -11,177 +11,93 @@ using namespace OsuBot;
 
 
 
-// Movement function to move to the next object.
-void MovementModes::MoveToObject(Bot* bot, vec2f(MovementModes::*callback)(const UINT&)) {
-	// Calculate the bezier pts if needed.
-	if (m_bezierPts.size() == 0U) {
-		// Retrive local pointers to
-		//		object before last (object that came before the last one),
-		//		previous (object that just ended),
-		//		current (object to move to),
-		//		next (object that comes after this move)
-		// hitobjects.
-		const BeatmapInfo::Beatmap* beatmap = bot->GetBeatmapAtIndex(bot->m_selectedBeatmapIndex);
-		const BeatmapInfo::HitObject* objectBeforeLast = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex - 2U);
-		const BeatmapInfo::HitObject* previousObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex - 1U);
-		const BeatmapInfo::HitObject* currentObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex);
-		const BeatmapInfo::HitObject* nextObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex + 1U);
-
+namespace
+{
+	// Returns the position of the hit object moved by its stack index, in playfield space.
+	vec2f GetStackedPosition(vec2f position, const BeatmapInfo::Beatmap& beatmap, const BeatmapInfo::HitObject& hitObject) {
+		return position.Sub(beatmap.GetStackOffset() * static_cast<float>(hitObject.GetStackIndex()));
+	}
+}
 
-		// Calculte the previous, begin, end and next points.
-		if (bot->m_hitObjectIndex == 0U) {
-			// Get the current cursor position.
-			GetCursorPos(&bot->m_cursorPosition);
 
-			m_previousPoint = m_beginPoint = m_backupPoint = vec2f(static_cast<FLOAT>(bot->m_cursorPosition.x), static_cast<FLOAT>(bot->m_cursorPosition.y));
-		}
-		else {
-			// Calculate the previous point.
-			if (previousObject->GetObjectType() == HITOBJECT_SLIDER) {
-				double previousPointTime = ((DOUBLE)previousObject->GetSliderTickCount() - 1.0) / (DOUBLE)previousObject->GetSliderTickCount();
-				previousPointTime = previousObject->GetSliderRepeatCount() % 2 == 0 ? 1.0 - previousPointTime : previousPointTime;
-				m_previousPoint = previousObject->GetPointByT(previousPointTime);
-				m_previousPoint.ConvertToWindowSpace(beatmap->GetStackOffset(), previousObject->GetStackIndex(), bot->GetMultiplier(), bot->GetOffset());
-			}
-			else if (bot->m_hitObjectIndex != 1U) {
-				// The previous point is the object before the last object.
-				m_previousPoint = objectBeforeLast->GetEndPosition();
-				m_previousPoint.ConvertToWindowSpace(beatmap->GetStackOffset(), objectBeforeLast->GetStackIndex(), bot->GetMultiplier(), bot->GetOffset());
-			}
-
-			// The end point of the previous move (current cursor position) becomes the begin point of this move.
-			GetCursorPos(&bot->m_cursorPosition);
-			m_beginPoint = vec2f(static_cast<FLOAT>(bot->m_cursorPosition.x), static_cast<FLOAT>(bot->m_cursorPosition.y));
-
-			//m_beginPoint = previousObject->GetEndPosition();
-			//m_beginPoint.ConvertToWindowSpace(beatmap->GetStackOffset(), previousObject->GetStackIndex(), bot->GetMultiplier(), bot->GetOffset());
-		}
-
-		m_endPoint = currentObject->GetStartPosition();
-		m_endPoint.ConvertToWindowSpace(beatmap->GetStackOffset(), currentObject->GetStackIndex(), bot->GetMultiplier(), bot->GetOffset());
+// This function binds the strategies of the movement modes.
+void MovementModes::SetMovementModes(const BYTE& circleMode, const BYTE& sliderMode, const BYTE& spinnerMode) {
+	m_circleMode = circleMode;
+	m_circleStrategy = GetMovementStrategy(circleMode);
+	m_sliderStrategy = GetMovementStrategy(sliderMode);
+	m_spinnerStrategy = GetMovementStrategy(spinnerMode);
+}
 
-		if (currentObject->GetObjectType() == HITOBJECT_SLIDER) {
-			double nextPointTime = 1.0 / max(1.0, (FLOAT)currentObject->GetSliderTickCount());
-			m_nextPoint = currentObject->GetPointByT(nextPointTime);
-			m_nextPoint.ConvertToWindowSpace(beatmap->GetStackOffset(), currentObject->GetStackIndex(), bot->GetMultiplier(), bot->GetOffset());
-		}
-		else {
-			m_nextPoint = nextObject->GetStartPosition();
-			m_nextPoint.ConvertToWindowSpace(beatmap->GetStackOffset(), nextObject->GetStackIndex(), bot->GetMultiplier(), bot->GetOffset());
-		}
+// Movement functions, called with the bound strategy.
+// The strategy was bound once, so the jump to its movement function is always predicted.
+void MovementModes::MoveToObject(Bot* bot) {
+	std::visit([&](const auto& strategy) { MoveToObject(bot, strategy); }, m_circleStrategy);
+}
+void MovementModes::MovementSlider(Bot* bot) {
+	std::visit([&](const auto& strategy) { MovementSlider(bot, strategy); }, m_sliderStrategy);
+}
+void MovementModes::MovementSpinner(Bot* bot) {
+	std::visit([&](const auto& strategy) { MovementSpinner(bot, strategy); }, m_spinnerStrategy);
+}
 
 
-		m_interpolateTime = TRUE;
+// Movement function to move to the next object.
+// The move was compiled when the beatmap was queued, only the move to the first object is compiled here.
+template <typename Strategy>
+void MovementModes::MoveToObject(Bot* bot, const Strategy& strategy) {
+	UNREFERENCED_PARAMETER(strategy);
 
-		// Calculate the control point(s).
-		m_controlPoint0 = m_beginPoint.Copy().Sub(m_backupPoint).Add(m_beginPoint);
+	const BeatmapInfo::Beatmap* beatmap = bot->GetBeatmapAtIndex(bot->m_selectedBeatmapIndex);
+	const MovementSegment* segment = &m_cursorSegment;
 
-		if (m_endPoint.Copy().Sub(m_beginPoint).Length() < (1.f / beatmap->GetCircleSize() * 400.f)) {
-			m_controlPoint1 = ControlPointFlowing(1U);
-			m_controlPoint0 = m_beginPoint.Copy().Sub(m_backupPoint).Normalize().Mult(m_endPoint.Copy().Sub(m_beginPoint).Length() / 2.f).Add(m_beginPoint);
+	if (bot->m_hitObjectIndex == 0U) {
+		if (!m_hasCursorSegment) {
+			// Get the current cursor position, the move to the first object starts there.
+			bot->m_cursorPosition = bot->GetOutputSink()->GetCursorPosition();
 
-			m_interpolateTime = FALSE;
-		}
-		else {
-			m_controlPoint1 = (bot->*callback)(1U);
-		}
+			vec2f cursorPoint = vec2f(static_cast<FLOAT>(bot->m_cursorPosition.x), static_cast<FLOAT>(bot->m_cursorPosition.y));
+			cursorPoint.ConvertToPlayfieldSpace(bot->GetPlayfieldMultiplier(), bot->GetOffset());
 
-		// Overwrite controlPoints for a linear move.
-		if (m_movementModeCircle == MODE_STANDARD) {
-			m_controlPoint0 = (bot->*callback)(0U);
-			m_controlPoint1 = (bot->*callback)(1U);
+			vec2f backupPoint = cursorPoint;
+			m_cursorSegment = CompileMovementSegment<Strategy>(*beatmap, 0U, cursorPoint, cursorPoint, bot->GetSongTime(), bot->GetPlayfieldMultiplier().Width, backupPoint);
+			m_hasCursorSegment = TRUE;
 		}
-
-		// Fill the bezier pts vector.
-		m_bezierPts = {
-			m_beginPoint,
-			m_controlPoint0,
-			m_controlPoint1,
-			m_endPoint
-		};
-
-		// Save controlPoint1 into backupPoint for next object.
-		m_backupPoint = m_controlPoint1;
-
-		// Save the current song time to calculate the time delta.
-		m_savedSongTime = bot->GetSongTime();
-		m_startTime = currentObject->GetStartTime();
 	}
-
-	// Calculate the time (0.0 - 1.0) until current object should be hit.
-	double deltaTime = m_startTime - m_savedSongTime;
-	double time = (deltaTime - (m_startTime - bot->GetSongTime())) / deltaTime;
-
-	if (m_interpolateTime) {
-		// Interpolate the time with a hermite curve.
-		time = HermiteInterpolation(time);
+	else {
+		segment = &GetMovementPlan(*beatmap, bot->GetPlayfieldMultiplier().Width).GetSegment(bot->m_hitObjectIndex);
 	}
 
-	// Clamp the time between 0.0 - 1.0.
-	time = CLAMP(0.0, time, 1.0);
-
+	// Get the point of the move at the song time.
+	vec2f resultPoint = segment->GetPoint(bot->GetSongTime());
+	resultPoint.ConvertToWindowSpace(0.f, 0, bot->GetMultiplier(), bot->GetOffset());
 
-	// Get the next point on the bezier curve.
-	vec2f bezierPoint = BeatmapInfo::GetPointOnBezier(m_bezierPts, time);
-	vec2f resultPoint = bezierPoint;
-	vec2f newPoint = bezierPoint;
-
-	vec2f sliderPointCurrent, sliderPointPrevious;
-
-	// Blend the resultPoint with the sliderPoint.
-	const BeatmapInfo::Beatmap* beatmap = bot->GetBeatmapAtIndex(bot->m_selectedBeatmapIndex);
-	const BeatmapInfo::HitObject* previousObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex - 1U);
-	const BeatmapInfo::HitObject* currentObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex);
-	if (currentObject->GetObjectType() == HITOBJECT_SLIDER && m_interpolateTime) {
-		// Movement into slider.
-		sliderPointCurrent = currentObject->GetPointByT(time - 1.0);
-		sliderPointCurrent.ConvertToWindowSpace(beatmap->GetStackOffset(), currentObject->GetStackIndex(), bot->GetMultiplier(), bot->GetOffset());
-
-		// Store sliderPoint in newPoint.
-		newPoint = sliderPointCurrent;
-
-		// Blend the points into a result.
-		time = HermiteInterpolation(time, -0.6);
-		resultPoint = bezierPoint.Copy().Mult(static_cast<float>(1.0 - time)).Add(sliderPointCurrent.Copy().Mult(static_cast<float>(time)));
-	}
-	if (previousObject->GetObjectType() == HITOBJECT_SLIDER && m_interpolateTime) {
-		// Movement out of slider.
-		sliderPointPrevious = previousObject->GetPointByT(time + 1.0);
-		sliderPointPrevious.ConvertToWindowSpace(beatmap->GetStackOffset(), previousObject->GetStackIndex(), bot->GetMultiplier(), bot->GetOffset());
-
-		// Blend the points into a result.
-		// NOTICE: Use newPoint instead of bezierPoint, so that movement out of slider can blend with movement into slider.
-		time = HermiteInterpolation(time, 0.6);
-		resultPoint = sliderPointPrevious.Copy().Mult(static_cast<float>(1.0 - time)).Add(newPoint.Copy().Mult(static_cast<float>(time)));
-	}
-	
 	// Set the cursor to the result point.
-	SetCursorPos(static_cast<int>(resultPoint.X), static_cast<int>(resultPoint.Y));
+	bot->GetOutputSink()->SetCursorPosition(static_cast<int>(resultPoint.X), static_cast<int>(resultPoint.Y));
 }
 
 // Movement function to move along a slider.
-void MovementModes::MovementSlider(Bot* bot, vec2f(MovementModes::*callback)(const UINT&)) {
+template <typename Strategy>
+void MovementModes::MovementSlider(Bot* bot, const Strategy& strategy) {
 	// NOTICE: Movement modes not yet implemented!
-	UNREFERENCED_PARAMETER(callback);
+	UNREFERENCED_PARAMETER(strategy);
 	
 	// Execute different code for standard slider mode.
-	if (m_movementModeSlider == MODE_STANDARD) {
+	if constexpr (Strategy::followSliderPath) {
 		// Retrive local pointers to the current object (slider).
 		const BeatmapInfo::Beatmap* beatmap = bot->GetBeatmapAtIndex(bot->m_selectedBeatmapIndex);
-		const BeatmapInfo::HitObject* currentObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex);
+		const BeatmapInfo::HitObject currentObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex);
 
-		// Calculate the time (0.0 - 1.0), slider repeats are handled after.
-		double time = (bot->GetSongTime() - currentObject->GetStartTime()) / currentObject->GetSliderTime();
-		time = CLAMP(0.0, time, (DOUBLE)currentObject->GetSliderRepeatCount());
-		time = static_cast<int>(floor(time)) % 2 == 0 ? time - floor(time) : floor(time) + 1.0 - time;
-		time = CLAMP(0.0, time, 1.0);
+		// Continue from the point of the last tick, or start following a new slider.
+		if (!m_sliderFollower.IsFollowing(currentObject)) {
+			m_sliderFollower.Follow(currentObject);
+		}
 
 		// Calculate the next point on the slider.
-		vec2f resultPoint = currentObject->GetPointByT(time);
-		resultPoint.ConvertToWindowSpace(beatmap->GetStackOffset(), currentObject->GetStackIndex(), bot->GetMultiplier(), bot->GetOffset());
+		vec2f resultPoint = m_sliderFollower.GetPointAtTime(bot->GetSongTime());
+		resultPoint.ConvertToWindowSpace(beatmap->GetStackOffset(), currentObject.GetStackIndex(), bot->GetMultiplier(), bot->GetOffset());
 
 		// Setthe cursor to the correct point on the slider body.
-		SetCursorPos(static_cast<int>(resultPoint.X), static_cast<int>(resultPoint.Y));
+		bot->GetOutputSink()->SetCursorPosition(static_cast<int>(resultPoint.X), static_cast<int>(resultPoint.Y));
 	}
 	else {
 		// Calculate the slider point if needed.
@@ -193,120 +109,192 @@ void MovementModes::MovementSlider(Bot* bot, vec2f(MovementModes::*callback)(con
 		//	//		next (object that comes after this move)
 		//	// hitobjects.
 		//	const BeatmapInfo::Beatmap* beatmap = bot->GetBeatmapAtIndex(bot->m_selectedBeatmapIndex);
-		//	const BeatmapInfo::HitObject* objectBeforeLast = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex - 2U);
-		//	const BeatmapInfo::HitObject* previousObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex - 1U);
-		//	const BeatmapInfo::HitObject* currentObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex);
-		//	const BeatmapInfo::HitObject* nextObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex + 1U);
+		//	const BeatmapInfo::HitObject objectBeforeLast = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex - 2U);
+		//	const BeatmapInfo::HitObject previousObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex - 1U);
+		//	const BeatmapInfo::HitObject currentObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex);
+		//	const BeatmapInfo::HitObject nextObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex + 1U);
 		//}
 	}
 }
 
 // Movement function to spin the spinners.
-void MovementModes::MovementSpinner(Bot* bot, vec2f(MovementModes::*callback)(const UINT&)) {
+template <typename Strategy>
+void MovementModes::MovementSpinner(Bot* bot, const Strategy& strategy) {
 	// NOTICE: Movement modes not yet implemented!
-	UNREFERENCED_PARAMETER(callback);
+	UNREFERENCED_PARAMETER(strategy);
 
-	// Calculate the spinner center if needed.
-	if (m_spinnerCenter == vec2f()) {
-		const BeatmapInfo::HitObject* currentObject = bot->GetBeatmapAtIndex(bot->m_selectedBeatmapIndex)->GetHitObjectAtIndex(bot->m_hitObjectIndex);
+	const BeatmapInfo::Beatmap* beatmap = bot->GetBeatmapAtIndex(bot->m_selectedBeatmapIndex);
+	const BeatmapInfo::HitObject currentObject = beatmap->GetHitObjectAtIndex(bot->m_hitObjectIndex);
 
-		// Set the radius with the beatmap circle size.
-		m_currentRadius = m_spinnerRadius * (1.f / bot->GetBeatmapAtIndex(bot->m_selectedBeatmapIndex)->GetCircleSize());
+	// Start following a new spinner, its center and radius are resolved to window space once.
+	if (!m_spinnerFollower.IsFollowing(currentObject)) {
+		vec2f spinnerCenter = currentObject.GetStartPosition();
+		spinnerCenter.Add(0.f, 6.f); // Offset the center the back from the global offset (POINT w = { 0, 6 } @ CheckGameActive() in OsuBot.cpp).
+		spinnerCenter.ConvertToWindowSpace(0.f, 0U, bot->GetMultiplier(), bot->GetOffset());
 
-		m_spinnerCenter = currentObject->GetStartPosition();
-		m_spinnerCenter.Add(0.f, 6.f); // Offset the center the back from the global offset (POINT w = { 0, 6 } @ CheckGameActive() in OsuBot.cpp).
-		m_spinnerCenter.ConvertToWindowSpace(0.f, 0U, bot->GetMultiplier(), bot->GetOffset());
+		// Set the radius with the beatmap circle size.
+		m_spinnerFollower.Follow(currentObject, spinnerCenter, m_spinnerRadius * (1.f / beatmap->GetCircleSize()), m_spinnerRpm);
 	}
 
-	// Calculate the next rotation point in the spinner.
-	vec2f resultPoint = vec2f(cosf(m_currentAngle) * m_currentRadius, sinf(m_currentAngle) * m_currentRadius);
-	resultPoint.Add(m_spinnerCenter);
+	// Calculate the rotation point in the spinner at the song time.
+	vec2f resultPoint = m_spinnerFollower.GetPointAtTime(bot->GetSongTime());
 
 	// Spin the spinner.
-	SetCursorPos(static_cast<int>(resultPoint.X), static_cast<int>(resultPoint.Y));
-
-	// Modify the current angle of the spinner.
-	m_currentAngle += M_PI / -12.f;
+	bot->GetOutputSink()->SetCursorPosition(static_cast<int>(resultPoint.X), static_cast<int>(resultPoint.Y));
 }
 
 
-// Returns a control point that follows a linear movement.
-vec2f MovementModes::ControlPointStandard(const UINT& index) {
-	vec2f cp0 = m_beginPoint.Copy().Mult(0.667f).Add(m_endPoint.Copy().Mult(0.334f));
-	vec2f cp1 = m_beginPoint.Copy().Mult(0.334f).Add(m_endPoint.Copy().Mult(0.667f));
+// This function compiles the moves to every hit object of the beatmap.
+// Every move begins at the end of the previous hit object, the move to the first hit object
+// begins on it (the bot compiles that move again from the cursor when the song starts).
+MovementPlan MovementModes::CompileMovementPlan(const BeatmapInfo::Beatmap& beatmap, const float& windowScale) const {
+	return std::visit([&](const auto& strategy) { return CompileMovementPlan(beatmap, windowScale, strategy); }, m_circleStrategy);
+}
+
+// This function returns the plan of the playing beatmap for the window scale and circle mode.
+// The plan of the queued beatmap is used unless the window was resized or the mode changed since it was queued,
+// then the plan is compiled again, once for the beatmap.
+const MovementPlan& MovementModes::GetMovementPlan(const BeatmapInfo::Beatmap& beatmap, const float& windowScale) {
+	if (beatmap.GetMovementPlan().IsCompiledFor(windowScale, m_circleMode)) {
+		return beatmap.GetMovementPlan();
+	}
 
-	return index ? cp0 : cp1;
+	if (m_recompiledPlanBeatmap != &beatmap || !m_recompiledPlan.IsCompiledFor(windowScale, m_circleMode)) {
+		m_recompiledPlan = CompileMovementPlan(beatmap, windowScale);
+		m_recompiledPlanBeatmap = &beatmap;
+	}
+	return m_recompiledPlan;
 }
 
-// Returns a control point that follows a flowing movement.
-vec2f MovementModes::ControlPointFlowing(const UINT& index) {
-	UNREFERENCED_PARAMETER(index);
+// This function compiles the moves with the control points of the strategy.
+template <typename Strategy>
+MovementPlan MovementModes::CompileMovementPlan(const BeatmapInfo::Beatmap& beatmap, const float& windowScale, const Strategy& strategy) const {
+	UNREFERENCED_PARAMETER(strategy);
 
-	vec2f d0 = m_previousPoint.Copy().Sub(m_beginPoint);
-	vec2f d1 = m_beginPoint.Copy().Sub(m_endPoint);
-	vec2f d2 = m_endPoint.Copy().Sub(m_nextPoint);
+	MovementPlan movementPlan(windowScale, m_circleMode);
 
-	float l0 = d0.Length();
-	float l1 = d1.Length();
-	float l2 = d2.Length();
+	const UINT hitObjectCount = beatmap.GetHitObjectsCount();
+	if (hitObjectCount == 0U) {
+		return movementPlan;
+	}
+	movementPlan.Reserve(hitObjectCount);
 
-	vec2f m0 = m_previousPoint.MidPoint(m_beginPoint);
-	vec2f m1 = m_beginPoint.MidPoint(m_endPoint);
-	vec2f m2 = m_endPoint.MidPoint(m_nextPoint);
+	const BeatmapInfo::HitObject firstObject = beatmap.GetHitObjectAtIndex(0U);
+	const vec2f firstPoint = GetStackedPosition(firstObject.GetStartPosition(), beatmap, firstObject);
 
-	float amplifier0 = (atan2f(l2 / 480.f, 1.85f * (l2 / 960.f)) / ((40000.f / 1.f) / l1)) + 1.f;
-	float amplifier1 = (atan2f(l1 / 480.f, 1.85f * (l1 / 960.f)) / ((40000.f / 1.f) / l1)) + 1.f;
+	// The second control point of the previous move, the next move continues in its direction.
+	vec2f backupPoint = firstPoint;
+	movementPlan.Add(CompileMovementSegment<Strategy>(beatmap, 0U, firstPoint, firstPoint, firstObject.GetStartTime(), windowScale, backupPoint));
 
-	vec2f cp0 = m1 + (m_beginPoint - (m1 + (m0 - m1) * ((l1 * amplifier1) / (l0 + l1))));
-	vec2f cp1 = m0 + (m_beginPoint - (m1 + (m0 - m1) * ((l1 * amplifier1) / (l0 + l1))));
-	vec2f cp2 = m2 + (m_endPoint - (m2 + (m1 - m2) * ((l2 * amplifier0) / (l1 + l2))));
-	vec2f cp3 = m1 + (m_endPoint - (m2 + (m1 - m2) * ((l2 * amplifier0) / (l1 + l2))));
+	for (UINT i = 1U; i < hitObjectCount; i++) {
+		// Retrive the
+		//		object before last (object that came before the last one),
+		//		previous (object that just ended)
+		// hitobjects.
+		const BeatmapInfo::HitObject objectBeforeLast = beatmap.GetHitObjectAtIndex(i - 2U);
+		const BeatmapInfo::HitObject previousObject = beatmap.GetHitObjectAtIndex(i - 1U);
 
-	// We only need cp3 for controlPoint1 for the bezier curve (for now).
-	return cp3;
-}
+		// The end point of the previous object becomes the begin point of this move.
+		const vec2f beginPoint = GetStackedPosition(previousObject.GetEndPosition(), beatmap, previousObject);
 
-// Returns a control point that follows an movement that looks to be able to predict the next movement.
-vec2f MovementModes::ControlPointPredicting(const UINT& index) {
-	UNREFERENCED_PARAMETER(index);
+		// Calculate the previous point.
+		vec2f previousPoint = beginPoint;
+		if (previousObject.GetObjectType() == HITOBJECT_SLIDER) {
+			// The previous point is the last tick (or repeat) before the tail of the slider.
+			previousPoint = GetStackedPosition(previousObject.GetSliderEvent(previousObject.GetSliderEventCount() - 2U).m_position, beatmap, previousObject);
+		}
+		else if (i != 1U) {
+			// The previous point is the object before the last object.
+			previousPoint = GetStackedPosition(objectBeforeLast.GetEndPosition(), beatmap, objectBeforeLast);
+		}
 
-	// Big complicated calculation that cannot be explaned.
-	// As it was made with mostly trial and error (what looked good/bad).
-	// And I also forgot why I did these steps :stuck_out_tongue_winking_eye:
-	return m_nextPoint.MidPoint(m_endPoint).Sub(m_nextPoint).Mult(m_beginPoint.Copy().Sub(m_endPoint).Length() / (860.f / 1.f)).Add(m_endPoint).MidPoint(m_controlPoint0);
+		movementPlan.Add(CompileMovementSegment<Strategy>(beatmap, i, beginPoint, previousPoint, previousObject.GetEndTime(), windowScale, backupPoint));
+	}
+
+	return movementPlan;
 }
 
+// This function compiles the move to the hit object at the index, from the begin point at the begin time.
+// The backup point is the second control point of the previous move, it is set to the one of this move.
+template <typename Strategy>
+MovementSegment MovementModes::CompileMovementSegment(
+	const BeatmapInfo::Beatmap& beatmap,
+	const UINT& index,
+	const vec2f& beginPoint,
+	const vec2f& previousPoint,
+	const double& beginTime,
+	const float& windowScale,
+	vec2f& backupPoint
+) const {
+	// Retrive the
+	//		previous (object that just ended),
+	//		current (object to move to),
+	//		next (object that comes after this move)
+	// hitobjects.
+	const BeatmapInfo::HitObject previousObject = beatmap.GetHitObjectAtIndex(index - 1U);
+	const BeatmapInfo::HitObject currentObject = beatmap.GetHitObjectAtIndex(index);
+	const BeatmapInfo::HitObject nextObject = beatmap.GetHitObjectAtIndex(index + 1U);
+
+	// Calculte the end and next points.
+	TransitionPoints points;
+	points.m_previousPoint = previousPoint;
+	points.m_beginPoint = beginPoint;
+	points.m_endPoint = GetStackedPosition(currentObject.GetStartPosition(), beatmap, currentObject);
+	points.m_windowScale = windowScale;
+
+	if (currentObject.GetObjectType() == HITOBJECT_SLIDER) {
+		// The next point is the first tick (or repeat) after the head of the slider.
+		points.m_nextPoint = GetStackedPosition(currentObject.GetSliderEvent(1U).m_position, beatmap, currentObject);
+	}
+	else {
+		points.m_nextPoint = GetStackedPosition(nextObject.GetStartPosition(), beatmap, nextObject);
+	}
+
+	MovementSegment segment;
+	segment.m_easeTime = TRUE;
 
-// Interpolates a double with a hermite curve.
-double MovementModes::HermiteInterpolation(const double& _X, const double& bias) {
-	// TODO: Change thse 6 variables to customize the hermite curve.
-	double _Y0 = 0.1;	// In target
-	double _Y1 = 0.0;	// Start
-	double _Y2 = 1.0;	// End
-	double _Y3 = 1.1;	// Out target
+	// Calculate the control point(s).
+	vec2f controlPoint1;
+	points.m_controlPoint0 = points.m_beginPoint.Copy().Sub(backupPoint).Add(points.m_beginPoint);
 
-	double tension	=  -0.2;	// 1 : high, 0 : normal, -1 : low
-	//double bias		=	0.3;	// >0 : first segment, 0 : mid, <0 : next segment
+	const float moveLenght = points.m_endPoint.Copy().Sub(points.m_beginPoint).Length();
+	if (moveLenght * windowScale < (1.f / beatmap.GetCircleSize() * 400.f)) {
+		controlPoint1 = MovementFlowing::GetControlPoint(points, 1U);
+		points.m_controlPoint0 = points.m_beginPoint;
+		if (points.m_beginPoint != backupPoint) {
+			points.m_controlPoint0 = points.m_beginPoint.Copy().Sub(backupPoint).Normalize().Mult(moveLenght / 2.f).Add(points.m_beginPoint);
+		}
 
+		segment.m_easeTime = FALSE;
+	}
+	else {
+		controlPoint1 = Strategy::GetControlPoint(points, 1U);
+	}
 
-	double a0, a1, a2, a3;
-	double m0, m1;
+	// Overwrite controlPoints for a linear move.
+	if constexpr (Strategy::linearMove) {
+		points.m_controlPoint0 = Strategy::GetControlPoint(points, 0U);
+		controlPoint1 = Strategy::GetControlPoint(points, 1U);
+	}
 
-	double _X2 = _X * _X;
-	double _X3 = _X2 * _X;
+	// The bezier curve of the move.
+	segment.m_points[0] = points.m_beginPoint;
+	segment.m_points[1] = points.m_controlPoint0;
+	segment.m_points[2] = controlPoint1;
+	segment.m_points[3] = points.m_endPoint;
 
-	m0	= (_Y1 - _Y0) * (1.0 + bias) * (1.0 - tension) / 2.0;
-	m0 += (_Y2 - _Y1) * (1.0 - bias) * (1.0 - tension) / 2.0;
-	m1	= (_Y2 - _Y1) * (1.0 + bias) * (1.0 - tension) / 2.0;
-	m1 += (_Y3 - _Y2) * (1.0 - bias) * (1.0 - tension) / 2.0;
+	// Save controlPoint1 into backupPoint for next object.
+	backupPoint = controlPoint1;
 
-	a0 =  2.0 *	_X3 - 3.0 * _X2 + 1.0;
-	a1 =		_X3 - 2.0 * _X2 + _X;
-	a2 =		_X3 -		_X2;
-	a3 = -2.0 * _X3 + 3.0 * _X2;
+	// The move takes the time until the current object should be hit.
+	segment.m_beginTime = beginTime;
+	segment.m_endTime = currentObject.GetStartTime();
 
-	// Calculate the resulting value on the hermite curve.
-	double _Y = (a0 * _Y1 + a1 * m0 + a2 * m1 + a3 * _Y2);
+	// Movement into slider, and out of slider.
+	segment.m_blendIntoSlider = currentObject.GetObjectType() == HITOBJECT_SLIDER && segment.m_easeTime;
+	segment.m_blendOutOfSlider = index != 0U && previousObject.GetObjectType() == HITOBJECT_SLIDER && segment.m_easeTime;
+	segment.m_sliderHead = segment.m_blendIntoSlider ? GetStackedPosition(currentObject.GetPointByT(0.0), beatmap, currentObject) : vec2f();
+	segment.m_sliderEnd = segment.m_blendOutOfSlider ? GetStackedPosition(previousObject.GetPointByT(1.0), beatmap, previousObject) : vec2f();
 
-	return CLAMP(0.0, _Y, 1.0);
+	return segment;
 }
\ No newline at end of file
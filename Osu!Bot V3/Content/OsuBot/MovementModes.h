@@ -4,6 +4,10 @@
 #pragma once
 
 #include <Common/Vec2f.h>
+#include <Content/OsuBot/Beatmap.h>
+#include <Content/OsuBot/MovementPlan.h>
+#include <Content/OsuBot/MovementStrategies.h>
+#include <Content/OsuBot/SpinnerFollower.h>
 
 
 namespace OsuBot
@@ -13,46 +17,68 @@ namespace OsuBot
 
 	class MovementModes {
 	public:
-		// Base movement functions.
-		void MoveToObject(Bot* bot, vec2f (MovementModes::*callback)(const UINT&));
-		void MovementSlider(Bot* bot, vec2f(MovementModes::*callback)(const UINT&));
-		void MovementSpinner(Bot* bot, vec2f(MovementModes::*callback)(const UINT&));
+		// Binds the strategies of the movement modes (MODE_NONE - MODE_PREDICTING).
+		// The movement plans are compiled with the circle mode, a plan queued with another mode is compiled again when it is played.
+		void SetMovementModes(const BYTE& circleMode, const BYTE& sliderMode, const BYTE& spinnerMode);
 
-		// TODO: Add movement variant calculation functions here.
-		vec2f ControlPointStandard(const UINT& index);
-		vec2f ControlPointFlowing(const UINT& index);
-		vec2f ControlPointPredicting(const UINT& index);
+		// Base movement functions, called with the bound strategies.
+		void MoveToObject(Bot* bot);
+		void MovementSlider(Bot* bot);
+		void MovementSpinner(Bot* bot);
 
-		// Hermite interpolation function.
-		double HermiteInterpolation(const double& time, const double& bias = 0.3);
+		// Compiles the moves to every hit object of the beatmap, with the circle strategy.
+		MovementPlan CompileMovementPlan(const BeatmapInfo::Beatmap& beatmap, const float& windowScale) const;
+
+	private:
+		// Movement functions of every strategy, no strategy does not move.
+		template <typename Strategy> void MoveToObject(Bot* bot, const Strategy& strategy);
+		template <typename Strategy> void MovementSlider(Bot* bot, const Strategy& strategy);
+		template <typename Strategy> void MovementSpinner(Bot* bot, const Strategy& strategy);
+		void MoveToObject(Bot* bot, const MovementNone& strategy) { UNREFERENCED_PARAMETER(bot); UNREFERENCED_PARAMETER(strategy); }
+		void MovementSlider(Bot* bot, const MovementNone& strategy) { UNREFERENCED_PARAMETER(bot); UNREFERENCED_PARAMETER(strategy); }
+		void MovementSpinner(Bot* bot, const MovementNone& strategy) { UNREFERENCED_PARAMETER(bot); UNREFERENCED_PARAMETER(strategy); }
+
+		// Movement plan functions.
+		template <typename Strategy>
+		MovementPlan CompileMovementPlan(const BeatmapInfo::Beatmap& beatmap, const float& windowScale, const Strategy& strategy) const;
+		MovementPlan CompileMovementPlan(const BeatmapInfo::Beatmap& beatmap, const float& windowScale, const MovementNone& strategy) const { UNREFERENCED_PARAMETER(beatmap); UNREFERENCED_PARAMETER(strategy); return MovementPlan(windowScale, m_circleMode); }
+		template <typename Strategy>
+		MovementSegment CompileMovementSegment(
+			const BeatmapInfo::Beatmap& beatmap,
+			const UINT& index,
+			const vec2f& beginPoint,
+			const vec2f& previousPoint,
+			const double& beginTime,
+			const float& windowScale,
+			vec2f& backupPoint
+		) const;
+		const MovementPlan& GetMovementPlan(const BeatmapInfo::Beatmap& beatmap, const float& windowScale);
 
 	public:
 		// Member variables.
-		BYTE m_movementModeCircle;
-		BYTE m_movementModeSlider;
-		BYTE m_movementModeSpinner;
 		float m_spinnerRadius;
+		float m_spinnerRpm;
 	private:
-		bool m_interpolateTime;
-		double m_savedSongTime;
-		double m_startTime;
-		float m_currentRadius;
-		float m_currentAngle;
-
-		// Frequently used vec2f objects for calculations.
-		vec2f m_beginPoint;
-		vec2f m_endPoint;
-		vec2f m_controlPoint0;
-		vec2f m_controlPoint1;
-		vec2f m_previousPoint;
-		vec2f m_nextPoint;
-		vec2f m_spinnerCenter;
-	public:
-		vec2f m_backupPoint;
+		// The strategies of the movement modes.
+		BYTE m_circleMode;
+		MovementStrategy m_circleStrategy;
+		MovementStrategy m_sliderStrategy;
+		MovementStrategy m_spinnerStrategy;
+
+		// Follows the slider that is being moved along.
+		BeatmapInfo::SliderFollower m_sliderFollower;
+		// Follows the spinner that is being spun.
+		SpinnerFollower m_spinnerFollower;
 
 	public:
-		// Bezier pts vector.
-		std::vector<vec2f> m_bezierPts;
+		// The move to the first hit object starts at the cursor, so it is compiled when the song starts.
+		MovementSegment m_cursorSegment;
+		bool m_hasCursorSegment;
+
+		// The plan is compiled again when the window scale or circle mode changed after the beatmap was queued.
+		MovementPlan m_recompiledPlan;
+		const BeatmapInfo::Beatmap* m_recompiledPlanBeatmap;
+
 		std::vector<vec2f> m_sliderPoints;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+// MovementPlan.cpp : Defines the content in MovementPlan.h
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot/MovementPlan.h>
+#include <Content/OsuBot/Bezier.h>
+
+
+using namespace OsuBot;
+
+
+namespace
+{
+	// The easing of the time, and of the blends with the sliders.
+	constexpr HermiteEasing timeEasing(0.3);
+	constexpr HermiteEasing sliderInEasing(-0.6);
+	constexpr HermiteEasing sliderOutEasing(0.6);
+}
+
+
+// This function returns the cursor position at the song time.
+vec2f MovementSegment::GetPoint(const double& songTime) const {
+	// Calculate the time (0.0 - 1.0) until the hit object should be hit.
+	double time = 1.0;
+	if (m_endTime > m_beginTime) {
+		time = (songTime - m_beginTime) / (m_endTime - m_beginTime);
+	}
+
+	if (m_easeTime) {
+		// Interpolate the time with a hermite curve.
+		time = timeEasing.Evaluate(time);
+	}
+
+	// Clamp the time between 0.0 - 1.0.
+	time = CLAMP(0.0, time, 1.0);
+
+	// Get the point on the bezier curve.
+	vec2f resultPoint = BeatmapInfo::GetPointOnBezier<3U>(m_points, static_cast<float>(time));
+	vec2f newPoint = resultPoint;
+
+	if (m_blendIntoSlider) {
+		// Blend the point into the slider head.
+		newPoint = m_sliderHead;
+
+		time = sliderInEasing.Evaluate(time);
+		resultPoint = resultPoint.Copy().Mult(static_cast<float>(1.0 - time)).Add(m_sliderHead.Copy().Mult(static_cast<float>(time)));
+	}
+	if (m_blendOutOfSlider) {
+		// Blend the point out of the slider end.
+		// NOTICE: Use newPoint instead of the bezier point, so that movement out of slider can blend with movement into slider.
+		time = sliderOutEasing.Evaluate(time);
+		resultPoint = m_sliderEnd.Copy().Mult(static_cast<float>(1.0 - time)).Add(newPoint.Copy().Mult(static_cast<float>(time)));
+	}
+
+	return resultPoint;
+}
\ No newline at end of file
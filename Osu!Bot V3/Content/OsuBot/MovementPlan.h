@@ -0,0 +1,108 @@
+// MovementPlan.h : Declares the cursor movement of a whole beatmap, compiled when the
+// beatmap is queued so the bot only has to evaluate it while playing.
+
+#pragma once
+
+#include <Common/Vec2f.h>
+
+#include <algorithm>
+#include <vector>
+
+
+namespace OsuBot
+{
+	// A hermite curve from 0.0 to 1.0 that eases a time (0.0 - 1.0), the bias moves the
+	// steepest part of the curve to the first (> 0) or the last (< 0) part of the time.
+	// The curve is stored as the coefficients of a cubic, so evaluating it is a few multiplies.
+	class HermiteEasing {
+	public:
+		// Constructor.
+		constexpr HermiteEasing(const double& bias) :
+			m_coefficient1(GetInTangent(bias)),
+			m_coefficient2(3.0 - 2.0 * GetInTangent(bias) - GetOutTangent(bias)),
+			m_coefficient3(GetInTangent(bias) + GetOutTangent(bias) - 2.0)
+		{}
+
+		// Returns the eased time, clamped between 0.0 - 1.0.
+		double Evaluate(const double& time) const {
+			double easedTime = ((m_coefficient3 * time + m_coefficient2) * time + m_coefficient1) * time;
+
+			return CLAMP(0.0, easedTime, 1.0);
+		}
+
+
+	private:
+		// The tangents of the curve at 0.0 and 1.0.
+		// The curve aims from 0.1 (the in target) through 0.0 and 1.0 to 1.1 (the out target).
+		constexpr static double tension = -0.2;
+		constexpr static double inTarget = 0.1;
+		constexpr static double outTarget = 1.1;
+
+		constexpr static double GetInTangent(const double& bias) {
+			return (0.0 - inTarget) * (1.0 + bias) * (1.0 - tension) / 2.0 + (1.0 - 0.0) * (1.0 - bias) * (1.0 - tension) / 2.0;
+		}
+		constexpr static double GetOutTangent(const double& bias) {
+			return (1.0 - 0.0) * (1.0 + bias) * (1.0 - tension) / 2.0 + (outTarget - 1.0) * (1.0 - bias) * (1.0 - tension) / 2.0;
+		}
+
+		// Member variables.
+		double m_coefficient1;
+		double m_coefficient2;
+		double m_coefficient3;
+	};
+
+	// The move of the cursor to a hit object, in playfield space (osu!pixels, stacking included).
+	// The cursor follows a cubic bezier curve from the end of the previous hit object,
+	// blended into the head of a slider and out of the end of a previous slider.
+	struct MovementSegment {
+		// Returns the cursor position at the song time.
+		vec2f GetPoint(const double& songTime) const;
+
+		// The begin point, two control points and the end point of the bezier curve.
+		vec2f m_points[4];
+		// The slider head that is moved into, and the slider path end that is moved out of.
+		vec2f m_sliderHead;
+		vec2f m_sliderEnd;
+
+		// The move starts when the previous hit object ends, and ends on the hit object.
+		double m_beginTime;
+		double m_endTime;
+
+		// Long moves ease the time, and blend with the sliders.
+		bool m_easeTime;
+		bool m_blendIntoSlider;
+		bool m_blendOutOfSlider;
+	};
+
+	// A class that holds the move to every hit object of a beatmap.
+	// The moves depend on the window scale and circle mode they were compiled with.
+	class MovementPlan {
+	public:
+		// Constructors.
+		MovementPlan() :
+			m_windowScale(0.f),
+			m_circleMode(0U)
+		{}
+		MovementPlan(const float& windowScale, const BYTE& circleMode) :
+			m_windowScale(windowScale),
+			m_circleMode(circleMode)
+		{}
+
+		// Member functions.
+		void Reserve(const UINT& segmentCount) { m_segments.reserve(segmentCount); }
+		void Add(const MovementSegment& segment) { m_segments.push_back(segment); }
+
+		// Accessor functions.
+		// The move to the hit object at the index, clamped to the last hit object.
+		const MovementSegment& GetSegment(const UINT& index) const { return m_segments[(std::min)(index, GetCount() - 1U)]; }
+		UINT GetCount() const { return (UINT)m_segments.size(); }
+		bool IsCompiledFor(const float& windowScale, const BYTE& circleMode) const { return m_windowScale == windowScale && m_circleMode == circleMode; }
+
+
+	private:
+		// Member variables.
+		std::vector<MovementSegment> m_segments;
+		float m_windowScale;
+		BYTE m_circleMode;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+// MovementStrategies.cpp : Defines the content in MovementStrategies.h
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot/MovementStrategies.h>
+
+
+using namespace OsuBot;
+
+
+// This function returns the strategy of a movement mode.
+MovementStrategy OsuBot::GetMovementStrategy(const BYTE& movementMode) {
+	switch (movementMode) {
+	case MODE_STANDARD:
+		return MovementStandard();
+
+	case MODE_FLOWING:
+		return MovementFlowing();
+
+	case MODE_PREDICTING:
+		return MovementPredicting();
+
+	default:
+		return MovementNone();
+	}
+}
+
+
+// Returns a control point that follows a linear movement.
+vec2f MovementStandard::GetControlPoint(const TransitionPoints& points, const UINT& index) {
+	vec2f cp0 = points.m_beginPoint.Copy().Mult(0.667f).Add(points.m_endPoint.Copy().Mult(0.334f));
+	vec2f cp1 = points.m_beginPoint.Copy().Mult(0.334f).Add(points.m_endPoint.Copy().Mult(0.667f));
+
+	return index ? cp0 : cp1;
+}
+
+// Returns a control point that follows a flowing movement.
+vec2f MovementFlowing::GetControlPoint(const TransitionPoints& points, const UINT& index) {
+	UNREFERENCED_PARAMETER(index);
+
+	vec2f d0 = points.m_previousPoint.Copy().Sub(points.m_beginPoint);
+	vec2f d1 = points.m_beginPoint.Copy().Sub(points.m_endPoint);
+	vec2f d2 = points.m_endPoint.Copy().Sub(points.m_nextPoint);
+
+	// The lenghts in window pixels.
+	float l0 = d0.Length() * points.m_windowScale;
+	float l1 = d1.Length() * points.m_windowScale;
+	float l2 = d2.Length() * points.m_windowScale;
+
+	vec2f m0 = points.m_previousPoint.MidPoint(points.m_beginPoint);
+	vec2f m1 = points.m_beginPoint.MidPoint(points.m_endPoint);
+	vec2f m2 = points.m_endPoint.MidPoint(points.m_nextPoint);
+
+	float amplifier0 = (atan2f(l2 / 480.f, 1.85f * (l2 / 960.f)) / ((40000.f / 1.f) / l1)) + 1.f;
+	float amplifier1 = (atan2f(l1 / 480.f, 1.85f * (l1 / 960.f)) / ((40000.f / 1.f) / l1)) + 1.f;
+
+	vec2f cp0 = m1 + (points.m_beginPoint - (m1 + (m0 - m1) * ((l1 * amplifier1) / (l0 + l1))));
+	vec2f cp1 = m0 + (points.m_beginPoint - (m1 + (m0 - m1) * ((l1 * amplifier1) / (l0 + l1))));
+	vec2f cp2 = m2 + (points.m_endPoint - (m2 + (m1 - m2) * ((l2 * amplifier0) / (l1 + l2))));
+	vec2f cp3 = m1 + (points.m_endPoint - (m2 + (m1 - m2) * ((l2 * amplifier0) / (l1 + l2))));
+
+	// We only need cp3 for controlPoint1 for the bezier curve (for now).
+	return cp3;
+}
+
+// Returns a control point that follows an movement that looks to be able to predict the next movement.
+vec2f MovementPredicting::GetControlPoint(const TransitionPoints& points, const UINT& index) {
+	UNREFERENCED_PARAMETER(index);
+
+	// Big complicated calculation that cannot be explaned.
+	// As it was made with mostly trial and error (what looked good/bad).
+	// And I also forgot why I did these steps :stuck_out_tongue_winking_eye:
+	return points.m_nextPoint.MidPoint(points.m_endPoint).Sub(points.m_nextPoint).Mult(points.m_beginPoint.Copy().Sub(points.m_endPoint).Length() * points.m_windowScale / (860.f / 1.f)).Add(points.m_endPoint).MidPoint(points.m_controlPoint0);
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+// MovementStrategies.h : Declares a type for every movement mode of the cursor,
+// the movement functions are instantiated for every type so a mode is chosen once.
+
+#pragma once
+
+#include <Common/Vec2f.h>
+
+#include <variant>
+
+
+namespace OsuBot
+{
+	// The points around a move (in playfield space), the control points are calculated from them.
+	struct TransitionPoints {
+		vec2f m_previousPoint;
+		vec2f m_beginPoint;
+		vec2f m_endPoint;
+		vec2f m_nextPoint;
+		vec2f m_controlPoint0;
+
+		// Window pixels per osu!pixel, the control points are tuned in window pixels.
+		float m_windowScale;
+	};
+
+	// A movement strategy has
+	//		GetControlPoint(points, index) : returns control point 0 or 1 of the move to a hit object,
+	//		linearMove : TRUE when both control points of every move come from GetControlPoint,
+	//		followSliderPath : TRUE when the cursor follows the path of a slider.
+	// To add a movement mode, add a strategy type to MovementStrategy and GetMovementStrategy.
+
+	// The cursor is not moved.
+	struct MovementNone {};
+
+	// A linear movement.
+	struct MovementStandard {
+		constexpr static bool linearMove = TRUE;
+		constexpr static bool followSliderPath = TRUE;
+
+		static vec2f GetControlPoint(const TransitionPoints& points, const UINT& index);
+	};
+
+	// A flowing movement.
+	struct MovementFlowing {
+		constexpr static bool linearMove = FALSE;
+		constexpr static bool followSliderPath = FALSE;
+
+		static vec2f GetControlPoint(const TransitionPoints& points, const UINT& index);
+	};
+
+	// A movement that looks to be able to predict the next movement.
+	struct MovementPredicting {
+		constexpr static bool linearMove = FALSE;
+		constexpr static bool followSliderPath = FALSE;
+
+		static vec2f GetControlPoint(const TransitionPoints& points, const UINT& index);
+	};
+
+	// One of the movement strategies, in order of the movement modes.
+	using MovementStrategy = std::variant<MovementNone, MovementStandard, MovementFlowing, MovementPredicting>;
+
+	// Returns the strategy of a movement mode (MODE_NONE - MODE_PREDICTING), unknown modes do not move.
+	MovementStrategy GetMovementStrategy(const BYTE& movementMode);
+}
\ No newline at end of file
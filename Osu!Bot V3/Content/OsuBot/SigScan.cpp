@@ -3,7 +3,9 @@
 #include <Content/OsuBot/SigScan.h>
 #include <Common/SplitString.h>
 
+#ifdef _WIN32
 #include <TlHelp32.h>
+#endif
 #include <sstream>
 
 
@@ -0,0 +1,325 @@
+// SliderPath.cpp : Defines the content in SliderPath.h
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot/Beatmap.h>
+
+#include <algorithm>
+
+
+using namespace OsuBot::BeatmapInfo;
+
+
+// This function returns the point on the path at the lenght from the start of the path.
+// Lenghts outside of the path are clamped to the start and end of the path.
+vec2f SliderPath::GetPointAtLenght(_In_ const float& lenght) const {
+	// Find the first point past the lenght.
+	const float* nextLenght = std::upper_bound(m_lenghts, m_lenghts + m_pointCount, lenght);
+
+	if (nextLenght == m_lenghts) {
+		// The lenght is before the start of the path.
+		return m_points[0];
+	}
+	else if (nextLenght == m_lenghts + m_pointCount) {
+		// The lenght is past the end of the path.
+		return m_points[m_pointCount - 1U];
+	}
+
+	// Interpolate on the line between the points around the lenght.
+	// The points in the path are never equal, so the line lenght is greater than 0.
+	UINT nextPoint = (UINT)(nextLenght - m_lenghts);
+	float lineTime = (lenght - m_lenghts[nextPoint - 1U]) / (m_lenghts[nextPoint] - m_lenghts[nextPoint - 1U]);
+
+	return m_points[nextPoint - 1U] + (m_points[nextPoint] - m_points[nextPoint - 1U]) * lineTime;
+}
+
+// This function returns the point on the path at the time (0.0 - 1.0) along the path.
+vec2f SliderPath::GetPointByT(_In_ const double& time) const {
+	return GetPointAtLenght(static_cast<float>(time) * GetLenght());
+}
+
+
+// This function finds the points at the times (0.0 - 1.0) along the path in one sweep.
+// The times should be sorted from low to high, then the search only moves forward along the path.
+void SliderPath::GetPointsByT(_In_ const double* times, _In_ const UINT& timeCount, _Out_ vec2f* points) const {
+	SliderPathCursor cursor(*this);
+	const float lenght = GetLenght();
+
+	for (UINT i = 0U; i < timeCount; i++) {
+		points[i] = cursor.GetPointAtLenght(static_cast<float>(times[i]) * lenght);
+	}
+}
+
+
+// This function returns the point on the path at the lenght from the start of the path,
+// starting from the line of the last point.
+// Gives the same points as SliderPath::GetPointAtLenght().
+vec2f SliderPathCursor::GetPointAtLenght(_In_ const float& lenght) {
+	const vec2f* points = m_path.GetPoints();
+	const float* lenghts = m_path.GetLenghts();
+	const UINT pointCount = m_path.GetPointCount();
+
+	if (lenght < lenghts[0]) {
+		// The lenght is before the start of the path.
+		m_line = 0U;
+		return points[0];
+	}
+	else if (lenght >= lenghts[pointCount - 1U]) {
+		// The lenght is past the end of the path.
+		m_line = pointCount > 1U ? pointCount - 2U : 0U;
+		return points[pointCount - 1U];
+	}
+
+	if (m_line >= pointCount - 1U) {
+		// The cursor was used on a longer path, start from the first line.
+		m_line = 0U;
+	}
+
+	// Walk to the line that holds the lenght, the line ends past the lenght.
+	UINT walkedLines = 0U;
+	while (lenghts[m_line + 1U] <= lenght && walkedLines < m_maxWalkLines) {
+		m_line++;
+		walkedLines++;
+	}
+	while (lenghts[m_line] > lenght && walkedLines < m_maxWalkLines) {
+		m_line--;
+		walkedLines++;
+	}
+
+	if (walkedLines == m_maxWalkLines) {
+		// The point is far away from the last point, search for its line.
+		m_line = (UINT)(std::upper_bound(lenghts, lenghts + pointCount, lenght) - lenghts) - 1U;
+	}
+
+	float lineTime = (lenght - lenghts[m_line]) / (lenghts[m_line + 1U] - lenghts[m_line]);
+
+	return points[m_line] + (points[m_line + 1U] - points[m_line]) * lineTime;
+}
+
+
+// This function starts a new path at the end of the path pool.
+// Returns the index of the first point of the path.
+UINT SliderGeometry::BeginPath() {
+	m_firstPoint = (UINT)m_pathPoints.size();
+	return m_firstPoint;
+}
+
+// This function adds a point to the end of the path, with its lenght from the start of the path.
+// A point equal to the last point adds no lenght and is skipped.
+void SliderGeometry::AddPathPoint(_In_ const vec2f& point) {
+	if ((UINT)m_pathPoints.size() == m_firstPoint) {
+		// The first point of the path.
+		m_pathPoints.push_back(point);
+		m_pathLenghts.push_back(0.f);
+		return;
+	}
+
+	if (point == m_pathPoints.back()) {
+		// Same point, skip it.
+		return;
+	}
+
+	m_pathLenghts.push_back(m_pathLenghts.back() + (point - m_pathPoints.back()).Length());
+	m_pathPoints.push_back(point);
+}
+
+// This function flattens a bezier segment into points on the path.
+// The curve is split in half (de Casteljau) until every part is flat enough to be drawn with lines,
+// so straight parts get few points and sharp bends get many.
+void SliderGeometry::AddBezierSegment(_In_ const Segment& segment) {
+	const UINT pointCount = segment.m_pointCount;
+
+	if (pointCount < 3U) {
+		// A point or a line is added as is.
+		for (UINT i = 0U; i < pointCount; i++) {
+			AddPathPoint(segment.m_points[i]);
+		}
+		return;
+	}
+
+	// The curves are stored as a stack of pointCount control points each, the top curve is flattened first.
+	m_bezierCurves.assign(segment.m_points, segment.m_points + pointCount);
+	m_bezierSubdivision.resize(pointCount * 3U);
+
+	const float flatness = m_pathTolerance * m_pathTolerance * 4.f;
+
+	while (!m_bezierCurves.empty()) {
+		const vec2f* curve = m_bezierCurves.data() + m_bezierCurves.size() - pointCount;
+
+		// Check if the control points are close to a line.
+		bool flatEnough = TRUE;
+		for (UINT i = 1U; i < pointCount - 1U; i++) {
+			vec2f bend = curve[i - 1U] - curve[i] * 2.f + curve[i + 1U];
+			if (bend.X * bend.X + bend.Y * bend.Y > flatness) {
+				flatEnough = FALSE;
+				break;
+			}
+		}
+
+		if (flatEnough) {
+			// Add the points of the flat curve, except the last which starts the next curve.
+			ApproximateBezier(curve, pointCount);
+			m_bezierCurves.resize(m_bezierCurves.size() - pointCount);
+			continue;
+		}
+
+		// Replace the curve with its right half and push the left half, which is flattened first.
+		SubdivideBezier(curve, pointCount);
+		const vec2f* left = m_bezierSubdivision.data() + pointCount;
+		const vec2f* right = left + pointCount;
+
+		std::copy(right, right + pointCount, m_bezierCurves.end() - pointCount);
+		m_bezierCurves.insert(m_bezierCurves.end(), left, left + pointCount);
+	}
+
+	// Add the end of the segment.
+	AddPathPoint(segment.m_points[pointCount - 1U]);
+}
+
+// This function flattens a catmull-rom spline through the segment points into points on the path.
+// The spline between two points uses the points before and after them,
+// missing points at the ends are mirrored.
+void SliderGeometry::AddCatmullSegment(_In_ const Segment& segment) {
+	const vec2f* points = segment.m_points;
+	const UINT pointCount = segment.m_pointCount;
+
+	if (pointCount < 3U) {
+		// A point or a line is added as is.
+		for (UINT i = 0U; i < pointCount; i++) {
+			AddPathPoint(points[i]);
+		}
+		return;
+	}
+
+	// The times of the points on every part of the spline.
+	float times[m_catmullDetail + 1U];
+	for (UINT j = 0U; j <= m_catmullDetail; j++) {
+		times[j] = static_cast<float>(j) / static_cast<float>(m_catmullDetail);
+	}
+
+	vec2f splinePoints[m_catmullDetail + 1U];
+
+	for (UINT i = 0U; i < pointCount - 1U; i++) {
+		vec2f vec1 = i > 0U ? points[i - 1U] : points[i];
+		vec2f vec2 = points[i];
+		vec2f vec3 = points[i + 1U];
+		vec2f vec4 = i < pointCount - 2U ? points[i + 2U] : vec3 * 2.f - vec2;
+
+		// The part of the spline between vec2 and vec3 is a cubic bezier curve,
+		// its control points follow the tangents at vec2 and vec3.
+		vec2f bezier[4] = {
+			vec2,
+			vec2 + (vec3 - vec1) / 6.f,
+			vec3 - (vec4 - vec2) / 6.f,
+			vec3
+		};
+
+		GetPointsOnBezier(bezier, 4U, times, m_catmullDetail + 1U, splinePoints);
+
+		for (UINT j = 0U; j <= m_catmullDetail; j++) {
+			AddPathPoint(splinePoints[j]);
+		}
+	}
+}
+
+// This function flattens a circular arc into points on the path.
+// The number of points is chosen so the lines stay within the tolerance of the arc.
+void SliderGeometry::AddArcSegment(_In_ const vec2f& center, _In_ const float& radius, _In_ const float& startAngle, _In_ const float& endAngle) {
+	UINT pointCount = 2U;
+
+	if (radius * 2.f > m_pathTolerance) {
+		// The angle of one line that stays within the tolerance.
+		float lineAngle = 2.f * acosf(1.f - m_pathTolerance / radius);
+		pointCount = (std::max)(2U, static_cast<UINT>(ceilf(fabsf(endAngle - startAngle) / lineAngle)) + 1U);
+	}
+
+	for (UINT i = 0U; i < pointCount; i++) {
+		float t = static_cast<float>(i) / static_cast<float>(pointCount - 1U);
+		AddPathPoint(GetPointOnCircle(center, radius, startAngle + (endAngle - startAngle) * t));
+	}
+}
+
+// This function splits the curve in half with de Casteljau's algorithm.
+// The halves are stored after the midpoints in the subdivision buffer, left half first.
+void SliderGeometry::SubdivideBezier(_In_ const vec2f* curve, _In_ const UINT& pointCount) {
+	vec2f* midpoints = m_bezierSubdivision.data();
+	vec2f* left = midpoints + pointCount;
+	vec2f* right = left + pointCount;
+
+	std::copy(curve, curve + pointCount, midpoints);
+
+	for (UINT i = 0U; i < pointCount; i++) {
+		left[i] = midpoints[0];
+		right[pointCount - i - 1U] = midpoints[pointCount - i - 1U];
+
+		for (UINT j = 0U; j < pointCount - i - 1U; j++) {
+			midpoints[j] = (midpoints[j] + midpoints[j + 1U]) * 0.5f;
+		}
+	}
+}
+
+// This function adds the points of a flat curve to the path, except its last point.
+// The curve is split once more and the points are smoothed over both halves.
+void SliderGeometry::ApproximateBezier(_In_ const vec2f* curve, _In_ const UINT& pointCount) {
+	SubdivideBezier(curve, pointCount);
+
+	// Join both halves into one polyline, the last point of the left half is the first of the right half.
+	vec2f* halves = m_bezierSubdivision.data() + pointCount;
+	std::copy(halves + pointCount + 1U, halves + pointCount * 2U, halves + pointCount);
+
+	AddPathPoint(curve[0]);
+	for (UINT i = 1U; i < pointCount - 1U; i++) {
+		UINT index = i * 2U;
+		AddPathPoint((halves[index - 1U] + halves[index] * 2.f + halves[index + 1U]) * 0.25f);
+	}
+}
+
+// This function ends the path that was started with BeginPath().
+// The path is cut at the pixel lenght of the slider, or extended in the direction of its last line.
+// Returns the number of points in the path.
+UINT SliderGeometry::EndPath(_In_ const float& pixelLenght) {
+	UINT pointCount = (UINT)m_pathPoints.size() - m_firstPoint;
+
+	if (pointCount < 2U || pixelLenght <= 0.f) {
+		// The path has no direction or the slider has no pixel lenght, use the path as is.
+		return pointCount;
+	}
+
+	// Find the first point at or past the pixel lenght.
+	auto pathLenghtsBegin = m_pathLenghts.begin() + m_firstPoint;
+	auto endLenght = std::lower_bound(pathLenghtsBegin, m_pathLenghts.end(), pixelLenght);
+
+	if (endLenght == m_pathLenghts.end()) {
+		// The path is shorter than the slider, extend the last line.
+		vec2f lastPoint = m_pathPoints.back();
+		vec2f direction = (lastPoint - m_pathPoints.at(m_pathPoints.size() - 2U)).Normalize();
+
+		m_pathPoints.push_back(lastPoint + direction * (pixelLenght - m_pathLenghts.back()));
+		m_pathLenghts.push_back(pixelLenght);
+	}
+	else {
+		// The path is longer than the slider, move the end point back to the pixel lenght.
+		UINT endPoint = (UINT)(endLenght - m_pathLenghts.begin());
+		vec2f previousPoint = m_pathPoints[endPoint - 1U];
+		float lineTime = (pixelLenght - m_pathLenghts[endPoint - 1U]) / (m_pathLenghts[endPoint] - m_pathLenghts[endPoint - 1U]);
+
+		m_pathPoints[endPoint] = previousPoint + (m_pathPoints[endPoint] - previousPoint) * lineTime;
+		m_pathLenghts[endPoint] = pixelLenght;
+
+		m_pathPoints.resize(endPoint + 1U);
+		m_pathLenghts.resize(endPoint + 1U);
+	}
+
+	return (UINT)m_pathPoints.size() - m_firstPoint;
+}
+
+// This function adds a finished path (from another slider geometry) to the end of the path pool.
+// Returns the index of the first point of the path.
+UINT SliderGeometry::AddPath(_In_ const SliderPath& path) {
+	m_firstPoint = (UINT)m_pathPoints.size();
+
+	m_pathPoints.insert(m_pathPoints.end(), path.GetPoints(), path.GetPoints() + path.GetPointCount());
+	m_pathLenghts.insert(m_pathLenghts.end(), path.GetLenghts(), path.GetLenghts() + path.GetPointCount());
+
+	return m_firstPoint;
+}
\ No newline at end of file
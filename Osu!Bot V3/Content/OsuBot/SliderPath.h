@@ -0,0 +1,157 @@
+// SliderPath.h : Declares the classes that hold the flattened slider paths
+// of a beatmap, so points on a slider are found without evaluating the curves.
+
+#pragma once
+
+#include <Common/Vec2f.h>
+
+
+namespace OsuBot
+{
+	namespace BeatmapInfo
+	{
+		// A class that views the points of a slider segment.
+		class Segment {
+		public:
+			// Constructor.
+			Segment(_In_ const vec2f* points, _In_ UINT pointCount) : m_points(points), m_pointCount(pointCount) {};
+
+			// Member variables.
+			const vec2f* m_points;
+			UINT m_pointCount;
+		};
+
+		// A class that views the flattened path of a slider.
+		// The path is a polyline with the length from the start of the slider at every point.
+		class SliderPath {
+		public:
+			// Constructor.
+			SliderPath(_In_ const vec2f* points, _In_ const float* lenghts, _In_ UINT pointCount) :
+				m_points(points),
+				m_lenghts(lenghts),
+				m_pointCount(pointCount)
+			{}
+
+			// Member functions.
+			vec2f GetPointAtLenght(_In_ const float& lenght) const;
+			vec2f GetPointByT(_In_ const double& time) const;
+			void GetPointsByT(_In_ const double* times, _In_ const UINT& timeCount, _Out_ vec2f* points) const;
+
+			// Accessor functions.
+			float			GetLenght() const				{ return m_lenghts[m_pointCount - 1U]; }
+			const vec2f*	GetPoints() const				{ return m_points; }
+			const float*	GetLenghts() const				{ return m_lenghts; }
+			UINT			GetPointCount() const			{ return m_pointCount; }
+
+
+		private:
+			// Member variables.
+			const vec2f* m_points;
+			const float* m_lenghts;
+			UINT m_pointCount;
+		};
+
+		// A class that follows a point along a slider path.
+		// The cursor remembers the line of the last point and walks from there,
+		// so following the path forwards (or backwards) costs the same for every point.
+		class SliderPathCursor {
+		public:
+			// Constructor.
+			explicit SliderPathCursor(_In_ const SliderPath& path) : m_path(path), m_line(0U) {}
+
+			// Member functions.
+			vec2f GetPointAtLenght(_In_ const float& lenght);
+
+
+		private:
+			// Points further away than this number of lines are searched for instead.
+			constexpr static UINT m_maxWalkLines = 8U;
+
+			// Member variables.
+			SliderPath m_path;
+			// The index of the point that starts the line of the last point.
+			UINT m_line;
+		};
+
+		// A class that holds an event on the timeline of a slider.
+		// The timeline of a slider starts with its head, every span ends with a repeat
+		// (or the tail for the last span) and has the ticks of the span before its end.
+		class SliderEvent {
+		public:
+			// The kinds of slider events.
+			enum sliderEventTypes : BYTE {
+				Head,
+				Tick,
+				Repeat,
+				Tail
+			};
+
+			// Constructor.
+			SliderEvent(_In_ sliderEventTypes type, _In_ int time, _In_ const vec2f& position) :
+				m_position(position),
+				m_time(time),
+				m_type(type)
+			{}
+
+			// Member variables.
+			vec2f m_position;
+			int m_time;
+			BYTE m_type;
+		};
+
+		// A class that holds the flattened paths and timelines of all sliders in a beatmap.
+		// The paths and timelines are stored in pools and hit objects refer to them by index,
+		// so they are copied (or read from the beatmap cache) in a few bulk copies.
+		class SliderGeometry {
+		public:
+			// Constructor.
+			SliderGeometry() : m_firstPoint(0U) {}
+
+			// Member functions.
+			UINT BeginPath();
+			void AddPathPoint(_In_ const vec2f& point);
+			void AddBezierSegment(_In_ const Segment& segment);
+			void AddCatmullSegment(_In_ const Segment& segment);
+			void AddArcSegment(_In_ const vec2f& center, _In_ const float& radius, _In_ const float& startAngle, _In_ const float& endAngle);
+			UINT EndPath(_In_ const float& pixelLenght);
+			UINT AddPath(_In_ const SliderPath& path);
+
+			// Accessor functions.
+			SliderPath GetPath(_In_ const UINT& firstPoint, _In_ const UINT& pointCount) const {
+				return SliderPath(m_pathPoints.data() + firstPoint, m_pathLenghts.data() + firstPoint, pointCount);
+			}
+
+			// Member variables.
+			std::vector<vec2f> m_pathPoints;
+			std::vector<float> m_pathLenghts;
+			std::vector<SliderEvent> m_sliderEvents;
+
+			// The control points of the slider that is being parsed, reused for every slider.
+			std::vector<vec2f> m_controlPoints;
+			// The tick times and points of the slider that is being parsed, reused for every slider.
+			std::vector<double> m_tickTimes;
+			std::vector<vec2f> m_tickPoints;
+
+		private:
+			// Internal functions.
+			void SubdivideBezier(_In_ const vec2f* curve, _In_ const UINT& pointCount);
+			void ApproximateBezier(_In_ const vec2f* curve, _In_ const UINT& pointCount);
+
+		private:
+			// Flattening tolerance in osu!pixels.
+			constexpr static float m_pathTolerance = 0.25f;
+
+			// Number of lines per catmull-rom segment.
+			constexpr static UINT m_catmullDetail = 50U;
+
+			// Member variables.
+			UINT m_firstPoint;
+
+			// Buffers used while flattening bezier segments, reused for every segment.
+			// The curves that still have to be flattened.
+			std::vector<vec2f> m_bezierCurves;
+			// The midpoints, left half and right half of the last subdivision.
+			std::vector<vec2f> m_bezierSubdivision;
+		};
+	}
+}
\ No newline at end of file
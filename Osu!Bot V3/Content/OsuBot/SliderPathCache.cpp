@@ -0,0 +1,220 @@
+// SliderPathCache.cpp : Defines the content in SliderPathCache.h
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot/SliderPathCache.h>
+
+#include <algorithm>
+#include <cstring>
+
+
+using namespace OsuBot::BeatmapInfo;
+
+
+namespace
+{
+	// Adds the bytes to a FNV-1a hash.
+	void HashBytes(_Inout_ ULONGLONG& hash, _In_ const void* data, _In_ size_t size) {
+		const BYTE* bytes = static_cast<const BYTE*>(data);
+		for (size_t i = 0U; i < size; i++) {
+			hash ^= static_cast<ULONGLONG>(bytes[i]);
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	// The memory of the lookup node and shared pointer control block of a cached path.
+	constexpr size_t entryOverhead = 4U * sizeof(void*) + sizeof(ULONGLONG) * 2U;
+}
+
+
+// This function returns a (FNV-1a) hash of the slider type, control points and pixel lenght.
+ULONGLONG SliderKey::GetHash() const {
+	ULONGLONG hash = 14695981039346656037ULL;
+
+	HashBytes(hash, &m_sliderType, sizeof(m_sliderType));
+	HashBytes(hash, &m_pixelLenght, sizeof(m_pixelLenght));
+	HashBytes(hash, m_controlPoints, m_controlPointCount * sizeof(vec2f));
+
+	return hash;
+}
+
+
+// The points are stored as floats, two for every point.
+static_assert(sizeof(vec2f) == 2U * sizeof(float), "vec2f must be two floats.");
+
+// Cached slider path constructor.
+// The key and path are copied into one array.
+CachedSliderPath::CachedSliderPath(_In_ const SliderKey& key, _In_ BYTE pathType, _In_ const SliderPath& path) :
+	m_sliderType(key.m_sliderType),
+	m_pixelLenght(key.m_pixelLenght),
+	m_controlPointCount(key.m_controlPointCount),
+	m_pathType(pathType),
+	m_pathPointCount(path.GetPointCount())
+{
+	const float* controlPoints = reinterpret_cast<const float*>(key.m_controlPoints);
+	const float* pathPoints = reinterpret_cast<const float*>(path.GetPoints());
+
+	m_values.reserve(m_controlPointCount * 2U + m_pathPointCount * 3U);
+	m_values.insert(m_values.end(), controlPoints, controlPoints + m_controlPointCount * 2U);
+	m_values.insert(m_values.end(), pathPoints, pathPoints + m_pathPointCount * 2U);
+	m_values.insert(m_values.end(), path.GetLenghts(), path.GetLenghts() + m_pathPointCount);
+}
+
+// This function checks if the path was made from the same slider as the key.
+bool CachedSliderPath::IsSameSlider(_In_ const SliderKey& key) const {
+	return m_sliderType == key.m_sliderType &&
+		m_pixelLenght == key.m_pixelLenght &&
+		m_controlPointCount == key.m_controlPointCount &&
+		std::equal(GetControlPoints(), GetControlPoints() + m_controlPointCount, key.m_controlPoints);
+}
+
+// This function returns the memory used by the path in bytes.
+size_t CachedSliderPath::GetMemoryUsage() const {
+	return sizeof(CachedSliderPath) + m_values.capacity() * sizeof(float);
+}
+
+
+// Constructor.
+SliderPathCache::SliderPathCache() :
+	m_mostRecent(nullptr),
+	m_leastRecent(nullptr),
+	m_memoryUsage(0U),
+	m_memoryBudget(m_defaultMemoryBudget),
+	m_hits(0ULL),
+	m_misses(0ULL),
+	m_evictions(0ULL)
+{}
+
+// This function returns the cache that is shared by all beatmaps.
+SliderPathCache& SliderPathCache::GetInstance() {
+	static SliderPathCache sliderPathCache;
+	return sliderPathCache;
+}
+
+// This function returns the cached path of the slider, or nullptr if the slider is not cached.
+std::shared_ptr<const CachedSliderPath> SliderPathCache::Find(_In_ const SliderKey& key) {
+	const ULONGLONG hash = key.GetHash();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto entry = m_entries.find(hash);
+	if (entry == m_entries.end() || !entry->second.path->IsSameSlider(key)) {
+		// Not cached, or another slider has the same hash.
+		m_misses++;
+		return nullptr;
+	}
+
+	// Move the path to the front, it is the most recently used.
+	Unlink(&entry->second);
+	LinkMostRecent(&entry->second);
+	m_hits++;
+
+	return entry->second.path;
+}
+
+// This function caches the path of the slider.
+// A cached path with the same hash is replaced.
+void SliderPathCache::Insert(_In_ const SliderKey& key, _In_ BYTE pathType, _In_ const SliderPath& path) {
+	// Copy the path before locking, the other threads can use the cache meanwhile.
+	auto cachedPath = std::make_shared<const CachedSliderPath>(key, pathType, path);
+
+	const ULONGLONG hash = key.GetHash();
+	const size_t memoryUsage = cachedPath->GetMemoryUsage() + entryOverhead;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (memoryUsage > m_memoryBudget) {
+		// The path alone is larger than the budget.
+		return;
+	}
+
+	auto entry = m_entries.find(hash);
+	if (entry != m_entries.end()) {
+		// Replace the path with the same hash.
+		Erase(&entry->second);
+	}
+
+	Entry& newEntry = m_entries[hash];
+	newEntry.hash = hash;
+	newEntry.path = std::move(cachedPath);
+	LinkMostRecent(&newEntry);
+	m_memoryUsage += memoryUsage;
+
+	Evict();
+}
+
+// This function removes all cached paths, the counters are kept.
+// Paths that are still used by a beatmap stay alive until the beatmap is done with them.
+void SliderPathCache::Clear() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_entries.clear();
+	m_mostRecent = nullptr;
+	m_leastRecent = nullptr;
+	m_memoryUsage = 0U;
+}
+
+// This function returns the cache counters.
+SliderPathCache::Statistics SliderPathCache::GetStatistics() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return { m_hits, m_misses, m_evictions, m_entries.size(), m_memoryUsage, m_memoryBudget };
+}
+
+// This function sets the memory budget in bytes, paths are removed until the cache fits in it.
+void SliderPathCache::SetMemoryBudget(_In_ size_t memoryBudget) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_memoryBudget = memoryBudget;
+	Evict();
+}
+
+// This function removes the least recently used paths until the cache fits in the memory budget.
+// The mutex must be locked by the caller.
+void SliderPathCache::Evict() {
+	while (m_memoryUsage > m_memoryBudget && m_leastRecent != nullptr) {
+		Erase(m_leastRecent);
+		m_evictions++;
+	}
+}
+
+// This function takes the entry out of the recently used list.
+// The mutex must be locked by the caller.
+void SliderPathCache::Unlink(_Inout_ Entry* entry) {
+	if (entry->moreRecent != nullptr) {
+		entry->moreRecent->lessRecent = entry->lessRecent;
+	}
+	else {
+		m_mostRecent = entry->lessRecent;
+	}
+
+	if (entry->lessRecent != nullptr) {
+		entry->lessRecent->moreRecent = entry->moreRecent;
+	}
+	else {
+		m_leastRecent = entry->moreRecent;
+	}
+}
+
+// This function puts the entry at the front of the recently used list.
+// The mutex must be locked by the caller.
+void SliderPathCache::LinkMostRecent(_Inout_ Entry* entry) {
+	entry->moreRecent = nullptr;
+	entry->lessRecent = m_mostRecent;
+	if (m_mostRecent != nullptr) {
+		m_mostRecent->moreRecent = entry;
+	}
+	else {
+		// The list was empty.
+		m_leastRecent = entry;
+	}
+	m_mostRecent = entry;
+}
+
+// This function removes the entry and its path from the cache.
+// The mutex must be locked by the caller.
+void SliderPathCache::Erase(_Inout_ Entry* entry) {
+	m_memoryUsage -= entry->path->GetMemoryUsage() + entryOverhead;
+	Unlink(entry);
+	m_entries.erase(entry->hash);
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+// SliderPathCache.h : Declares the class that keeps the flattened paths of parsed sliders
+// for the whole process, so identical sliders in other difficulties of a beatmap set
+// (or the same beatmap queued again) are not flattened again.
+
+#pragma once
+
+#include <Content/OsuBot/SliderPath.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace OsuBot
+{
+	namespace BeatmapInfo
+	{
+		// A class that views the values that make a slider path.
+		// Sliders with the same key have the same path.
+		class SliderKey {
+		public:
+			// Constructor.
+			SliderKey(_In_ BYTE sliderType, _In_ const vec2f* controlPoints, _In_ UINT controlPointCount, _In_ float pixelLenght) :
+				m_sliderType(sliderType),
+				m_controlPoints(controlPoints),
+				m_controlPointCount(controlPointCount),
+				m_pixelLenght(pixelLenght)
+			{}
+
+			// Member functions.
+			ULONGLONG GetHash() const;
+
+			// Member variables.
+			BYTE m_sliderType;
+			const vec2f* m_controlPoints;
+			UINT m_controlPointCount;
+			float m_pixelLenght;
+		};
+
+		// A class that holds a cached slider path, it is never changed after it is cached.
+		// The control points, path points and path lenghts are stored in one allocation.
+		class CachedSliderPath {
+		public:
+			// Constructor.
+			CachedSliderPath(_In_ const SliderKey& key, _In_ BYTE pathType, _In_ const SliderPath& path);
+
+			// Member functions.
+			bool IsSameSlider(_In_ const SliderKey& key) const;
+			size_t GetMemoryUsage() const;
+
+			// Accessor functions.
+			// The slider type the path was made with and the path.
+			BYTE		GetPathType() const		{ return m_pathType; }
+			SliderPath	GetPath() const			{ return SliderPath(GetPathPoints(), GetPathLenghts(), m_pathPointCount); }
+
+
+		private:
+			// Internal functions.
+			const vec2f*	GetControlPoints() const	{ return reinterpret_cast<const vec2f*>(m_values.data()); }
+			const vec2f*	GetPathPoints() const		{ return GetControlPoints() + m_controlPointCount; }
+			const float*	GetPathLenghts() const		{ return reinterpret_cast<const float*>(GetPathPoints() + m_pathPointCount); }
+
+		private:
+			// Member variables.
+			// The slider key.
+			BYTE m_sliderType;
+			float m_pixelLenght;
+			UINT m_controlPointCount;
+
+			BYTE m_pathType;
+			UINT m_pathPointCount;
+
+			// The control points, then the path points, then the path lenghts.
+			std::vector<float> m_values;
+		};
+
+		// A class that keeps the most recently used slider paths within a memory budget.
+		// The least recently used paths are removed first, every function is thread safe.
+		class SliderPathCache {
+		public:
+			// The cache counters.
+			struct Statistics {
+				ULONGLONG hits;
+				ULONGLONG misses;
+				ULONGLONG evictions;
+				size_t pathCount;
+				size_t memoryUsage;
+				size_t memoryBudget;
+			};
+
+			// The cache that is shared by all beatmaps.
+			static SliderPathCache& GetInstance();
+
+			// Member functions.
+			std::shared_ptr<const CachedSliderPath> Find(_In_ const SliderKey& key);
+			void Insert(_In_ const SliderKey& key, _In_ BYTE pathType, _In_ const SliderPath& path);
+			void Clear();
+
+			// Accessor functions.
+			Statistics GetStatistics() const;
+			void SetMemoryBudget(_In_ size_t memoryBudget);
+
+
+		private:
+			// Constructor.
+			SliderPathCache();
+
+		private:
+			// The default memory budget, a few beatmap sets.
+			constexpr static size_t m_defaultMemoryBudget = 16U * 1024U * 1024U;
+
+			// A cached path, linked from the most to the least recently used.
+			// The entries are the values of the lookup, so a path costs no other allocations.
+			struct Entry {
+				ULONGLONG hash;
+				std::shared_ptr<const CachedSliderPath> path;
+				Entry* moreRecent;
+				Entry* lessRecent;
+			};
+
+			// Internal functions.
+			void Evict();
+			void Unlink(_Inout_ Entry* entry);
+			void LinkMostRecent(_Inout_ Entry* entry);
+			void Erase(_Inout_ Entry* entry);
+
+			// Member variables.
+			mutable std::mutex m_mutex;
+
+			// The paths by the hash of their key, and the ends of the recently used list.
+			std::unordered_map<ULONGLONG, Entry> m_entries;
+			Entry* m_mostRecent;
+			Entry* m_leastRecent;
+
+			size_t m_memoryUsage;
+			size_t m_memoryBudget;
+			ULONGLONG m_hits;
+			ULONGLONG m_misses;
+			ULONGLONG m_evictions;
+		};
+	}
+}
\ No newline at end of file
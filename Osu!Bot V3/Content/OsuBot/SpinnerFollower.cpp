@@ -0,0 +1,61 @@
+// SpinnerFollower.cpp : Defines the content in SpinnerFollower.h
+
+#include <Common/Pch.h>
+
+#include <Content/OsuBot/SpinnerFollower.h>
+
+#include <cmath>
+
+
+using namespace OsuBot;
+
+
+namespace
+{
+	// The points of a rotation in the table, a point between two of them is off the circle
+	// by less than 0.0001 of the radius.
+	constexpr UINT rotationSteps = 256U;
+
+	// The points on the unit circle of one (counterclockwise) rotation, and the first point again at the end.
+	struct RotationTable {
+		RotationTable() {
+			for (UINT step = 0U; step <= rotationSteps; step++) {
+				const double angle = -2.0 * M_PI * step / rotationSteps;
+				m_points[step] = vec2f(static_cast<float>(cos(angle)), static_cast<float>(sin(angle)));
+			}
+		}
+
+		vec2f m_points[rotationSteps + 1U];
+	};
+
+	const RotationTable rotationTable;
+}
+
+
+// This function starts following the spinner.
+void SpinnerFollower::Follow(_In_ const BeatmapInfo::HitObject& spinner, _In_ const vec2f& center, _In_ const float& radius, _In_ const float& rpm) {
+	m_spinner = spinner;
+	m_center = center;
+	m_radius = radius;
+	m_rotationsPerMillisecond = rpm / 60000.0;
+}
+
+// This function returns the point on the spinner at the song time.
+// The rotation starts at the right of the center when the spinner starts.
+vec2f SpinnerFollower::GetPointAtTime(_In_ const double& songTime) const {
+	// Calculate the part of the last rotation, so the angle keeps its precision on long spinners.
+	const double rotations = (std::max)(songTime - m_spinner.GetStartTime(), 0.0) * m_rotationsPerMillisecond;
+	const double step = (rotations - floor(rotations)) * rotationSteps;
+
+	// Interpolate between the two closest points of the table.
+	const UINT index = (std::min)(static_cast<UINT>(step), rotationSteps - 1U);
+	const float time = static_cast<float>(step - index);
+
+	const vec2f& point0 = rotationTable.m_points[index];
+	const vec2f& point1 = rotationTable.m_points[index + 1U];
+
+	return vec2f(
+		m_center.X + (point0.X + (point1.X - point0.X) * time) * m_radius,
+		m_center.Y + (point0.Y + (point1.Y - point0.Y) * time) * m_radius
+	);
+}
\ No newline at end of file
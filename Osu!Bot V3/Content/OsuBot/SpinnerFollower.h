@@ -0,0 +1,36 @@
+// SpinnerFollower.h : Declares the class that spins the cursor around a spinner,
+// with a table of rotation points instead of calculating a sine and cosine every tick.
+
+#pragma once
+
+#include <Content/OsuBot/Beatmap.h>
+
+
+namespace OsuBot
+{
+	// A class that spins the cursor around the spinner it follows, at a fixed rate from the start of the spinner.
+	// The center and radius are in window space, they are resolved once when the spinner is followed.
+	// The angle is taken from the song time, so the rate stays exact however far apart the ticks are.
+	class SpinnerFollower {
+	public:
+		// Constructor.
+		SpinnerFollower() : m_spinner(nullptr, 0U), m_radius(0.f), m_rotationsPerMillisecond(0.0) {}
+
+		// Member functions.
+		void Follow(_In_ const BeatmapInfo::HitObject& spinner, _In_ const vec2f& center, _In_ const float& radius, _In_ const float& rpm);
+		vec2f GetPointAtTime(_In_ const double& songTime) const;
+
+		// Accessor functions.
+		bool IsFollowing(_In_ const BeatmapInfo::HitObject& spinner) const {
+			return m_spinner.GetHitObjectTable() == spinner.GetHitObjectTable() && m_spinner.GetIndex() == spinner.GetIndex();
+		}
+
+
+	private:
+		// Member variables.
+		BeatmapInfo::HitObject m_spinner;
+		vec2f m_center;
+		float m_radius;
+		double m_rotationsPerMillisecond;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+// BeatmapCacheTests.cpp : Tests that the compiled beatmap is read back as it was parsed,
+// and that a damaged compiled beatmap is not used.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/BeatmapCache.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// Returns the content of the file.
+	std::string ReadFileContent(_In_ const std::filesystem::path& path) {
+		std::ifstream file(path, std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	// Writes the content to the file, without changing its size.
+	void WriteFileContent(_In_ const std::filesystem::path& path, _In_ const std::string& content) {
+		std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.write(content.data(), static_cast<std::streamsize>(content.size()));
+	}
+
+	// Returns the path of the only compiled beatmap in the beatmap cache of the directory.
+	std::filesystem::path GetCompiledBeatmapPath(_In_ const TestDirectory& directory) {
+		std::filesystem::path compiledBeatmapPath;
+		for (const auto& entry : std::filesystem::directory_iterator(directory.GetPath() / "BeatmapCache")) {
+			compiledBeatmapPath = entry.path();
+		}
+		return compiledBeatmapPath;
+	}
+
+	// Returns the offset of the slider details of the slider in the compiled beatmap,
+	// found by the values that are in front of the path and timeline ranges.
+	size_t FindSliderDetails(_In_ const std::string& compiledBeatmap, _In_ const HitObject& slider) {
+		char values[sizeof(vec2f) + sizeof(int) + sizeof(float) + sizeof(UINT)];
+		const vec2f endPosition = slider.GetEndPosition();
+		const int sliderTime = slider.GetSliderTime();
+		const float sliderTickCount = slider.GetSliderTickCount();
+		const UINT sliderRepeatCount = slider.GetSliderRepeatCount();
+		memcpy(values, &endPosition, sizeof(vec2f));
+		memcpy(values + sizeof(vec2f), &sliderTime, sizeof(int));
+		memcpy(values + sizeof(vec2f) + sizeof(int), &sliderTickCount, sizeof(float));
+		memcpy(values + sizeof(vec2f) + sizeof(int) + sizeof(float), &sliderRepeatCount, sizeof(UINT));
+
+		return compiledBeatmap.find(std::string(values, sizeof(values)));
+	}
+
+	// Parses the beatmap with the beatmap cache, so its compiled beatmap is written, and damages a slider range in it.
+	// The slider details are the range values after the end position, slider time, tick count and repeat count.
+	void DamageSliderRange(_In_ const TestDirectory& directory, _In_ const std::wstring& beatmapPath, _In_ const size_t& rangeValue, _In_ const UINT& value) {
+		Beatmap beatmap(beatmapPath.c_str());
+		REQUIRE(beatmap.ParseBeatmap(TRUE));
+		REQUIRE(beatmap.GetHitObjectAtIndex(3U).GetObjectType() == HITOBJECT_SLIDER);
+
+		const std::filesystem::path compiledBeatmapPath = GetCompiledBeatmapPath(directory);
+		std::string compiledBeatmap = ReadFileContent(compiledBeatmapPath);
+		const size_t sliderDetails = FindSliderDetails(compiledBeatmap, beatmap.GetHitObjectAtIndex(3U));
+		REQUIRE(sliderDetails != std::string::npos);
+
+		const size_t rangeOffset = sliderDetails + sizeof(vec2f) + sizeof(int) + sizeof(float) + sizeof(UINT) + rangeValue * sizeof(UINT);
+		memcpy(&compiledBeatmap[rangeOffset], &value, sizeof(UINT));
+		WriteFileContent(compiledBeatmapPath, compiledBeatmap);
+	}
+}
+
+
+TEST_CASE(LoadsTheSavedBeatmap) {
+	const TestDirectory directory("LoadsTheSavedBeatmap");
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = 500U;
+	const std::wstring beatmapPath = directory.WriteFile("Mixed.osu", MakeSyntheticBeatmap(synthetic));
+
+	Beatmap parsedBeatmap(beatmapPath.c_str());
+	REQUIRE(parsedBeatmap.ParseBeatmap(TRUE));
+	REQUIRE(std::filesystem::exists(GetCompiledBeatmapPath(directory)));
+
+	Beatmap loadedBeatmap(beatmapPath.c_str());
+	REQUIRE(BeatmapCache(beatmapPath).LoadBeatmap(&loadedBeatmap));
+	REQUIRE(parsedBeatmap.GetHitObjectsCount() == loadedBeatmap.GetHitObjectsCount());
+	CHECK(parsedBeatmap.GetTitle() == loadedBeatmap.GetTitle());
+	CHECK(parsedBeatmap.GetVersion() == loadedBeatmap.GetVersion());
+	CHECK_EQUAL(parsedBeatmap.GetStackOffset(), loadedBeatmap.GetStackOffset());
+
+	UINT differentHitObjectCount = 0U;
+	for (UINT i = 0U; i < parsedBeatmap.GetHitObjectsCount(); i++) {
+		const HitObject parsed = parsedBeatmap.GetHitObjectAtIndex(i);
+		const HitObject loaded = loadedBeatmap.GetHitObjectAtIndex(i);
+
+		bool equal = parsed.GetObjectType() == loaded.GetObjectType() &&
+			parsed.GetStartTime() == loaded.GetStartTime() && parsed.GetEndTime() == loaded.GetEndTime() &&
+			parsed.GetStartPosition() == loaded.GetStartPosition() && parsed.GetStackIndex() == loaded.GetStackIndex();
+
+		if (equal && parsed.GetObjectType() == HITOBJECT_SLIDER) {
+			const SliderPath parsedPath = parsed.GetSliderPath();
+			const SliderPath loadedPath = loaded.GetSliderPath();
+			equal = parsed.GetEndPosition() == loaded.GetEndPosition() && parsed.GetSliderTime() == loaded.GetSliderTime() &&
+				parsed.GetSliderRepeatCount() == loaded.GetSliderRepeatCount() && parsed.GetSliderEventCount() == loaded.GetSliderEventCount() &&
+				parsedPath.GetPointCount() == loadedPath.GetPointCount() &&
+				memcmp(parsedPath.GetPoints(), loadedPath.GetPoints(), parsedPath.GetPointCount() * sizeof(vec2f)) == 0;
+		}
+
+		if (!equal) {
+			differentHitObjectCount++;
+		}
+	}
+	CHECK_EQUAL(0U, differentHitObjectCount);
+}
+
+TEST_CASE(KeepsNegativeStackIndices) {
+	const TestDirectory directory("KeepsNegativeStackIndices");
+	SyntheticBeatmap synthetic;
+	synthetic.m_kind = BeatmapKind::StackedStreams;
+	synthetic.m_hitObjectCount = 2000U;
+	const std::wstring beatmapPath = directory.WriteFile("StackedStreams.osu", MakeSyntheticBeatmap(synthetic));
+
+	Beatmap parsedBeatmap(beatmapPath.c_str());
+	REQUIRE(parsedBeatmap.ParseBeatmap(TRUE));
+	Beatmap loadedBeatmap(beatmapPath.c_str());
+	REQUIRE(BeatmapCache(beatmapPath).LoadBeatmap(&loadedBeatmap));
+
+	// The stack indices are read back as the signed values they were written as.
+	UINT negativeStackIndexCount = 0U;
+	UINT differentStackIndexCount = 0U;
+	for (UINT i = 0U; i < parsedBeatmap.GetHitObjectsCount(); i++) {
+		const int stackIndex = parsedBeatmap.GetHitObjectAtIndex(i).GetStackIndex();
+		if (stackIndex < 0) {
+			negativeStackIndexCount++;
+		}
+		if (stackIndex != loadedBeatmap.GetHitObjectAtIndex(i).GetStackIndex()) {
+			differentStackIndexCount++;
+		}
+	}
+	CHECK(negativeStackIndexCount > 0U);
+	CHECK_EQUAL(0U, differentStackIndexCount);
+}
+
+TEST_CASE(RejectsASliderPathOutsideThePathPoints) {
+	const TestDirectory directory("RejectsASliderPathOutsideThePathPoints");
+	const std::wstring beatmapPath = directory.WriteFile("AllObjectTypes.osu", ReadFileContent(GetTestBeatmapPath("AllObjectTypes.osu")));
+
+	// The point count of the first slider path is larger than all path points.
+	DamageSliderRange(directory, beatmapPath, 1U, 0x10000000U);
+
+	Beatmap loadedBeatmap(beatmapPath.c_str());
+	CHECK(!BeatmapCache(beatmapPath).LoadBeatmap(&loadedBeatmap));
+
+	// The beatmap is parsed again instead.
+	Beatmap parsedBeatmap(beatmapPath.c_str());
+	REQUIRE(parsedBeatmap.ParseBeatmap(TRUE));
+	CHECK_EQUAL(16U, parsedBeatmap.GetHitObjectsCount());
+}
+
+TEST_CASE(RejectsASliderTimelineOutsideTheSliderEvents) {
+	const TestDirectory directory("RejectsASliderTimelineOutsideTheSliderEvents");
+	const std::wstring beatmapPath = directory.WriteFile("AllObjectTypes.osu", ReadFileContent(GetTestBeatmapPath("AllObjectTypes.osu")));
+
+	// The first slider event of the first slider is past the slider events, the range would wrap around.
+	DamageSliderRange(directory, beatmapPath, 2U, 0xFFFFFFFFU);
+
+	Beatmap loadedBeatmap(beatmapPath.c_str());
+	CHECK(!BeatmapCache(beatmapPath).LoadBeatmap(&loadedBeatmap));
+}
\ No newline at end of file
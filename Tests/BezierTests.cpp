@@ -0,0 +1,108 @@
+// BezierTests.cpp : Tests the batch evaluator of the bezier curves against the Bernstein form,
+// and that the SIMD kernels give the same points as the scalar evaluator.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/ReferenceSliderPath.h>
+
+#include <Content/OsuBot/Bezier.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// Returns a curve of random points in the playfield.
+	std::vector<vec2f> MakeCurve(_In_ const UINT& pointCount, _Inout_ std::mt19937& random) {
+		std::vector<vec2f> curve(pointCount);
+		for (vec2f& point : curve) {
+			point = vec2f(static_cast<float>(random() % 513U), static_cast<float>(random() % 385U));
+		}
+		return curve;
+	}
+
+	// Returns the times from 0.0 to 1.0, the time count apart.
+	std::vector<float> MakeTimes(_In_ const UINT& timeCount) {
+		std::vector<float> times(timeCount);
+		for (UINT i = 0U; i < timeCount; i++) {
+			times[i] = static_cast<float>(i) / static_cast<float>(timeCount - 1U);
+		}
+		return times;
+	}
+
+	// Returns the largest distance between the batch of points and the Bernstein form.
+	float GetMaximumDistance(_In_ const std::vector<vec2f>& curve, _In_ const std::vector<float>& times) {
+		std::vector<vec2f> points(times.size());
+		GetPointsOnBezier(curve.data(), (UINT)curve.size(), times.data(), (UINT)times.size(), points.data());
+
+		float maximumDistance = 0.f;
+		for (size_t i = 0U; i < times.size(); i++) {
+			const vec2f reference = GetReferenceBezierPoint(curve.data(), (UINT)curve.size(), times[i]);
+			maximumDistance = (std::max)(maximumDistance, (points[i] - reference).Length());
+		}
+		return maximumDistance;
+	}
+}
+
+
+TEST_CASE(MatchesTheBernsteinForm) {
+	std::mt19937 random(11U);
+	const std::vector<float> times = MakeTimes(257U);
+
+	for (UINT degree = 1U; degree <= maxBatchBezierDegree; degree++) {
+		const float maximumDistance = GetMaximumDistance(MakeCurve(degree + 1U, random), times);
+		if (maximumDistance > 0.001f) {
+			printf("Degree %u: %g px from the Bernstein form\n", degree, maximumDistance);
+		}
+		CHECK(maximumDistance <= 0.001f);
+	}
+}
+
+TEST_CASE(EvaluatesCurvesAboveTheBatchDegree) {
+	std::mt19937 random(12U);
+	const std::vector<float> times = MakeTimes(101U);
+
+	for (const UINT degree : { maxBatchBezierDegree + 1U, 80U, 120U }) {
+		CHECK(GetMaximumDistance(MakeCurve(degree + 1U, random), times) <= 0.001f);
+	}
+}
+
+TEST_CASE(GivesTheSamePointsForEveryBatchSize) {
+	// A batch of 8 times and more is evaluated with AVX, 4 times with SSE2, the rest one by one.
+	// The kernels do the same float operations, so every time gives the same point in any batch.
+	std::mt19937 random(13U);
+	const std::vector<float> times = MakeTimes(39U);
+
+	UINT differentPointCount = 0U;
+	for (const UINT degree : { 1U, 2U, 3U, 5U, 8U, 16U, 33U, maxBatchBezierDegree }) {
+		const std::vector<vec2f> curve = MakeCurve(degree + 1U, random);
+
+		std::vector<vec2f> batchPoints(times.size());
+		GetPointsOnBezier(curve.data(), (UINT)curve.size(), times.data(), (UINT)times.size(), batchPoints.data());
+
+		for (size_t i = 0U; i < times.size(); i++) {
+			vec2f point;
+			GetPointsOnBezier(curve.data(), (UINT)curve.size(), &times[i], 1U, &point);
+			if (memcmp(&point, &batchPoints[i], sizeof(vec2f)) != 0) {
+				differentPointCount++;
+			}
+		}
+	}
+	CHECK_EQUAL(0U, differentPointCount);
+}
+
+TEST_CASE(HandlesCurvesWithoutDegree) {
+	const vec2f point(12.f, 34.f);
+	const float times[3] = { 0.f, 0.5f, 1.f };
+	vec2f points[3] = {};
+
+	GetPointsOnBezier(&point, 1U, times, 3U, points);
+	for (const vec2f& result : points) {
+		CHECK(result == point);
+	}
+}
\ No newline at end of file
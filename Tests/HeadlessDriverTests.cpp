@@ -0,0 +1,145 @@
+// HeadlessDriverTests.cpp : Tests the bot logic played by the headless driver,
+// on the recorded output of the bot.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/HeadlessDriver.h>
+
+#include <filesystem>
+
+
+using namespace OsuBot;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	const DX::Size<INT> windowSize(1920, 1080);
+
+	// Returns the events of the type, in order.
+	std::vector<OutputEvent> GetEventsOfType(_In_ const std::vector<OutputEvent>& events, _In_ const BYTE& type) {
+		std::vector<OutputEvent> result;
+		for (const OutputEvent& event : events) {
+			if (event.m_type == type) {
+				result.push_back(event);
+			}
+		}
+		return result;
+	}
+
+	// Returns the beatmap queued by a bot, without the beatmap cache.
+	std::unique_ptr<Bot> QueueBeatmap(_In_ const std::wstring& beatmapPath) {
+		auto bot = std::make_unique<Bot>(1000U, 0.0, L"");
+		bot->SetBeatmapCacheEnabled(FALSE);
+		bot->SetWindowGeometry(GetWindowGeometry({ 0, 0 }, windowSize.Width, windowSize.Height));
+		bot->AddBeatmapToQueue(beatmapPath);
+		return bot;
+	}
+}
+
+
+TEST_CASE(PlaysEveryHitObjectOnce) {
+	const std::wstring beatmapPath = GetTestBeatmapPath("AllObjectTypes.osu");
+	const std::unique_ptr<Bot> bot = QueueBeatmap(beatmapPath);
+	REQUIRE(!bot->m_beatmapQueue.IsEmpty());
+	const BeatmapInfo::Beatmap* beatmap = bot->GetBeatmapAtIndex(0U);
+	CHECK_EQUAL(16U, beatmap->GetHitObjectsCount());
+
+	HeadlessDriver driver(windowSize, 1000U);
+	REQUIRE(driver.Play(beatmapPath));
+
+	// Every hit object is pressed once, and released before the next one is pressed.
+	const std::vector<OutputEvent> presses = GetEventsOfType(driver.GetEvents(), OutputEvent::Press);
+	const std::vector<OutputEvent> releases = GetEventsOfType(driver.GetEvents(), OutputEvent::Release);
+	REQUIRE(presses.size() == beatmap->GetHitObjectsCount());
+	REQUIRE(releases.size() == presses.size());
+
+	for (UINT i = 0U; i < presses.size(); i++) {
+		const BeatmapInfo::HitObject hitObject = beatmap->GetHitObjectAtIndex(i);
+
+		// Pressed on the first tick at or after the start time, released at or after the end time.
+		CHECK(presses[i].m_songTime >= hitObject.GetStartTime());
+		CHECK(presses[i].m_songTime < hitObject.GetStartTime() + 1.0);
+		CHECK(releases[i].m_songTime >= hitObject.GetEndTime());
+		CHECK(releases[i].m_songTime >= presses[i].m_songTime);
+		if (i + 1U < presses.size()) {
+			CHECK(releases[i].m_songTime <= presses[i + 1U].m_songTime);
+		}
+	}
+}
+
+TEST_CASE(PressesOnTheCircles) {
+	HeadlessDriver driver(windowSize, 1000U);
+	REQUIRE(driver.Play(GetTestBeatmapPath("AllObjectTypes.osu")));
+
+	const std::vector<OutputEvent> presses = GetEventsOfType(driver.GetEvents(), OutputEvent::Press);
+	REQUIRE(presses.size() >= 3U);
+
+	// The first circles are not stacked, the cursor is on them in window space when they are pressed.
+	const WindowGeometry geometry = GetWindowGeometry({ 0, 0 }, windowSize.Width, windowSize.Height);
+	const vec2f circles[] = { vec2f(64.f, 64.f), vec2f(448.f, 64.f), vec2f(448.f, 320.f) };
+	for (UINT i = 0U; i < 3U; i++) {
+		CHECK_NEAR(circles[i].X * geometry.m_multiplier.Width + geometry.m_offset.Width, presses[i].m_position.x, 1.0);
+		CHECK_NEAR(circles[i].Y * geometry.m_multiplier.Height + geometry.m_offset.Height, presses[i].m_position.y, 1.0);
+	}
+}
+
+TEST_CASE(StaysInTheWindow) {
+	HeadlessDriver driver(windowSize, 1000U);
+	REQUIRE(driver.Play(GetTestBeatmapPath("AllObjectTypes.osu")));
+	REQUIRE(!driver.GetEvents().empty());
+
+	for (const OutputEvent& event : driver.GetEvents()) {
+		CHECK(event.m_position.x >= 0 && event.m_position.x < windowSize.Width);
+		CHECK(event.m_position.y >= 0 && event.m_position.y < windowSize.Height);
+	}
+}
+
+TEST_CASE(PlaysTheSameEveryTime) {
+	const TestDirectory directory("PlaysTheSameEveryTime");
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = 300U;
+	const std::wstring beatmapPath = directory.WriteFile("Mixed.osu", MakeSyntheticBeatmap(synthetic));
+
+	HeadlessDriver driver(windowSize, 240U);
+	REQUIRE(driver.Play(beatmapPath));
+	const std::vector<OutputEvent> firstEvents = driver.GetEvents();
+	REQUIRE(driver.Play(beatmapPath));
+	const std::vector<OutputEvent>& secondEvents = driver.GetEvents();
+
+	REQUIRE(firstEvents.size() == secondEvents.size());
+	UINT differentEventCount = 0U;
+	for (size_t i = 0U; i < firstEvents.size(); i++) {
+		if (firstEvents[i].m_songTime != secondEvents[i].m_songTime || firstEvents[i].m_type != secondEvents[i].m_type ||
+			firstEvents[i].m_position.x != secondEvents[i].m_position.x || firstEvents[i].m_position.y != secondEvents[i].m_position.y) {
+			differentEventCount++;
+		}
+	}
+	CHECK_EQUAL(0U, differentEventCount);
+}
+
+TEST_CASE(DoesNotWriteTheBeatmapCache) {
+	const TestDirectory directory("DoesNotWriteTheBeatmapCache");
+	const std::wstring beatmapPath = directory.WriteFile("Mixed.osu", MakeSyntheticBeatmap(SyntheticBeatmap()));
+
+	HeadlessDriver driver(windowSize, 1000U);
+	REQUIRE(driver.Play(beatmapPath));
+	CHECK(!std::filesystem::exists(directory.GetPath() / "BeatmapCache"));
+
+	// The cache is written when it is enabled, and the cached beatmap plays the same.
+	const std::vector<OutputEvent> events = driver.GetEvents();
+	HeadlessDriver cachedDriver(windowSize, 1000U, TRUE);
+	REQUIRE(cachedDriver.Play(beatmapPath));
+	CHECK(std::filesystem::exists(directory.GetPath() / "BeatmapCache"));
+	REQUIRE(cachedDriver.Play(beatmapPath));
+	CHECK_EQUAL(events.size(), cachedDriver.GetEvents().size());
+}
+
+TEST_CASE(FailsOnAMissingBeatmap) {
+	const TestDirectory directory("FailsOnAMissingBeatmap");
+
+	HeadlessDriver driver(windowSize, 1000U);
+	CHECK(!driver.Play((directory.GetPath() / "Missing.osu").wstring()));
+	CHECK(driver.GetEvents().empty());
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+// MovementPlanTests.cpp : Tests that the bot plays with a movement plan of the current window,
+// whatever the window geometry was when the beatmap was queued.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/HeadlessDriver.h>
+
+#include <vector>
+
+
+using namespace OsuBot;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	const POINT windowOrigin = { 0, 0 };
+	const DX::Size<INT> windowSize(1920, 1080);
+	const UINT updatesPerSecond = 240U;
+
+	// How the window geometry is set around queueing the beatmap.
+	enum class QueueGeometry {
+		// The geometry of the window is set before the beatmap is queued.
+		Window,
+		// The beatmap is queued before any geometry is set.
+		None,
+		// The beatmap is queued with a smaller window, which is resized before the song starts.
+		SmallerWindow
+	};
+
+	// Plays the beatmap in the window like the headless driver, with the geometry queued as set.
+	std::vector<OutputEvent> PlaySong(_In_ const std::wstring& beatmapPath, _In_ const QueueGeometry& queueGeometry) {
+		SyntheticSongClock songClock;
+		RecordingOutputSink outputSink(songClock, POINT{ windowSize.Width / 2, windowSize.Height / 2 });
+
+		Bot bot(updatesPerSecond, 0.0, L"");
+		bot.RegisterSongClock(&songClock);
+		bot.RegisterOutputSink(&outputSink);
+		bot.SetBeatmapCacheEnabled(FALSE);
+
+		if (queueGeometry == QueueGeometry::Window) {
+			bot.SetWindowGeometry(GetWindowGeometry(windowOrigin, windowSize.Width, windowSize.Height));
+		}
+		else if (queueGeometry == QueueGeometry::SmallerWindow) {
+			bot.SetWindowGeometry(GetWindowGeometry(windowOrigin, 800, 600));
+		}
+		bot.AddBeatmapToQueue(beatmapPath);
+		if (bot.m_beatmapQueue.IsEmpty()) {
+			return std::vector<OutputEvent>();
+		}
+		bot.SetWindowGeometry(GetWindowGeometry(windowOrigin, windowSize.Width, windowSize.Height));
+
+		const BeatmapInfo::Beatmap* beatmap = bot.GetBeatmapAtIndex(0U);
+		const double beginTime = beatmap->GetHitObjectAtIndex(0U).GetStartTime() - 1000.0;
+		const double endTime = beatmap->GetHitObjectAtIndex(beatmap->GetHitObjectsCount() - 1U).GetEndTime() + 1000.0;
+		const UINT tickCount = static_cast<UINT>((endTime - beginTime) * updatesPerSecond / 1000.0) + 1U;
+
+		songClock.SetSongTime(beginTime);
+		bot.StartSong(0U);
+		for (UINT tick = 0U; tick < tickCount; tick++) {
+			songClock.SetSongTime(beginTime + tick * 1000.0 / updatesPerSecond);
+			bot.UpdateSongTime();
+			bot.PlayHitObjects();
+		}
+		return outputSink.GetEvents();
+	}
+
+	// Checks that the beatmap queued with the geometry plays the same as when it was queued in the window.
+	void CheckQueueGeometry(_In_ const std::wstring& beatmapPath, _In_ const QueueGeometry& queueGeometry) {
+		const std::vector<OutputEvent> expectedEvents = PlaySong(beatmapPath, QueueGeometry::Window);
+		const std::vector<OutputEvent> events = PlaySong(beatmapPath, queueGeometry);
+		REQUIRE(!expectedEvents.empty());
+		REQUIRE(expectedEvents.size() == events.size());
+
+		UINT differentEventCount = 0U;
+		for (size_t i = 0U; i < events.size(); i++) {
+			const POINT& position = events[i].m_position;
+			if (events[i].m_type != expectedEvents[i].m_type || position.x != expectedEvents[i].m_position.x ||
+				position.y != expectedEvents[i].m_position.y) {
+				differentEventCount++;
+			}
+		}
+		CHECK_EQUAL(0U, differentEventCount);
+	}
+}
+
+
+TEST_CASE(PlaysABeatmapQueuedBeforeTheWindowGeometry) {
+	CheckQueueGeometry(GetTestBeatmapPath("AllObjectTypes.osu"), QueueGeometry::None);
+}
+
+TEST_CASE(PlaysABeatmapQueuedBeforeTheWindowWasResized) {
+	CheckQueueGeometry(GetTestBeatmapPath("AllObjectTypes.osu"), QueueGeometry::SmallerWindow);
+
+	const TestDirectory directory("PlaysABeatmapQueuedBeforeTheWindowWasResized");
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = 300U;
+	CheckQueueGeometry(directory.WriteFile("Mixed.osu", MakeSyntheticBeatmap(synthetic)), QueueGeometry::SmallerWindow);
+}
\ No newline at end of file
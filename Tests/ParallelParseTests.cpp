@@ -0,0 +1,102 @@
+// ParallelParseTests.cpp : Tests that a beatmap parsed in chunks on several threads
+// is the same as the beatmap parsed on one thread.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/Beatmap.h>
+#include <Content/OsuBot/SliderPathCache.h>
+
+#include <cstring>
+#include <memory>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// Parses the beatmap with at most the thread count, without the beatmap cache.
+	// The sliders are flattened again, not copied from the slider path cache.
+	std::unique_ptr<Beatmap> ParseWithThreads(_In_ const std::wstring& beatmapPath, _In_ const UINT& threadCount) {
+		SliderPathCache::GetInstance().Clear();
+		Beatmap::SetParseThreadCount(threadCount);
+		std::unique_ptr<Beatmap> beatmap = std::make_unique<Beatmap>(beatmapPath.c_str());
+		const bool parsed = beatmap->ParseBeatmap(FALSE);
+		Beatmap::SetParseThreadCount(0U);
+
+		return parsed ? std::move(beatmap) : nullptr;
+	}
+
+	// Returns TRUE if the slider events of both sliders are the same.
+	bool IsSameTimeline(_In_ const HitObject& lhs, _In_ const HitObject& rhs) {
+		if (lhs.GetSliderEventCount() != rhs.GetSliderEventCount()) {
+			return FALSE;
+		}
+		for (UINT i = 0U; i < lhs.GetSliderEventCount(); i++) {
+			const SliderEvent& lhsEvent = lhs.GetSliderEvent(i);
+			const SliderEvent& rhsEvent = rhs.GetSliderEvent(i);
+			if (lhsEvent.m_type != rhsEvent.m_type || lhsEvent.m_time != rhsEvent.m_time || lhsEvent.m_position != rhsEvent.m_position) {
+				return FALSE;
+			}
+		}
+		return TRUE;
+	}
+
+	// Returns TRUE if both hit objects are the same, with the same slider path and timeline.
+	bool IsSameHitObject(_In_ const HitObject& lhs, _In_ const HitObject& rhs) {
+		if (lhs.GetObjectType() != rhs.GetObjectType() || lhs.GetStartTime() != rhs.GetStartTime() || lhs.GetEndTime() != rhs.GetEndTime() ||
+			lhs.GetStartPosition() != rhs.GetStartPosition() || lhs.GetEndPosition() != rhs.GetEndPosition() || lhs.GetStackIndex() != rhs.GetStackIndex()) {
+			return FALSE;
+		}
+		if (lhs.GetObjectType() != HITOBJECT_SLIDER) {
+			return TRUE;
+		}
+
+		const SliderPath lhsPath = lhs.GetSliderPath();
+		const SliderPath rhsPath = rhs.GetSliderPath();
+		return lhs.GetSliderTime() == rhs.GetSliderTime() && lhs.GetSliderRepeatCount() == rhs.GetSliderRepeatCount() &&
+			lhsPath.GetPointCount() == rhsPath.GetPointCount() &&
+			memcmp(lhsPath.GetPoints(), rhsPath.GetPoints(), lhsPath.GetPointCount() * sizeof(vec2f)) == 0 &&
+			IsSameTimeline(lhs, rhs);
+	}
+
+	// Checks the beatmap parsed with every thread count against the beatmap parsed on one thread.
+	void CheckThreadCounts(_In_ const std::wstring& beatmapPath, _In_ const UINT& hitObjectCount) {
+		const std::unique_ptr<Beatmap> expectedBeatmap = ParseWithThreads(beatmapPath, 1U);
+		REQUIRE(expectedBeatmap != nullptr);
+		REQUIRE(expectedBeatmap->GetHitObjectsCount() == hitObjectCount);
+
+		for (const UINT threadCount : { 2U, 3U, 8U }) {
+			const std::unique_ptr<Beatmap> beatmap = ParseWithThreads(beatmapPath, threadCount);
+			REQUIRE(beatmap != nullptr);
+			REQUIRE(beatmap->GetHitObjectsCount() == hitObjectCount);
+
+			UINT differentHitObjectCount = 0U;
+			for (UINT i = 0U; i < hitObjectCount; i++) {
+				if (!IsSameHitObject(expectedBeatmap->GetHitObjectAtIndex(i), beatmap->GetHitObjectAtIndex(i))) {
+					differentHitObjectCount++;
+				}
+			}
+			CHECK_EQUAL(0U, differentHitObjectCount);
+		}
+	}
+}
+
+
+TEST_CASE(ParsesMixedBeatmapsInChunks) {
+	const TestDirectory directory("ParsesMixedBeatmapsInChunks");
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = 10000U;
+	CheckThreadCounts(directory.WriteFile("Mixed.osu", MakeSyntheticBeatmap(synthetic)), synthetic.m_hitObjectCount);
+}
+
+TEST_CASE(ParsesStackedStreamsInChunks) {
+	// The hit objects are stacked after the chunks are appended, so stacks across chunks are kept.
+	const TestDirectory directory("ParsesStackedStreamsInChunks");
+	SyntheticBeatmap synthetic;
+	synthetic.m_kind = BeatmapKind::StackedStreams;
+	synthetic.m_hitObjectCount = 10000U;
+	CheckThreadCounts(directory.WriteFile("StackedStreams.osu", MakeSyntheticBeatmap(synthetic)), synthetic.m_hitObjectCount);
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+// ParseAllocationTests.cpp : Tests that the lines of a beatmap are tokenized without allocating,
+// with an operator new that counts the allocations of the test.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/Beatmap.h>
+#include <Content/OsuBot/SliderPathCache.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// The allocations since the test started.
+	std::atomic<UINT> allocationCount(0U);
+
+	// Returns the allocations of parsing the beatmap, without the beatmap cache.
+	UINT CountParseAllocations(_In_ const std::wstring& beatmapPath, _Out_ UINT& hitObjectCount) {
+		SliderPathCache::GetInstance().Clear();
+		Beatmap beatmap(beatmapPath.c_str());
+
+		const UINT firstAllocationCount = allocationCount;
+		const bool parsed = beatmap.ParseBeatmap(FALSE);
+		const UINT parseAllocationCount = allocationCount - firstAllocationCount;
+
+		hitObjectCount = parsed ? beatmap.GetHitObjectsCount() : 0U;
+		return parseAllocationCount;
+	}
+}
+
+
+// Count every allocation, the memory comes from malloc.
+void* operator new(size_t size) {
+	allocationCount++;
+	if (void* memory = malloc(size ? size : 1U)) {
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+void operator delete(void* memory) noexcept {
+	free(memory);
+}
+void operator delete[](void* memory) noexcept {
+	free(memory);
+}
+void operator delete(void* memory, size_t) noexcept {
+	free(memory);
+}
+void operator delete[](void* memory, size_t) noexcept {
+	free(memory);
+}
+
+
+TEST_CASE(ParsesCirclesWithoutAllocatingPerLine) {
+	const TestDirectory directory("ParsesCirclesWithoutAllocatingPerLine");
+	SyntheticBeatmap synthetic;
+	synthetic.m_kind = BeatmapKind::Circles;
+
+	synthetic.m_hitObjectCount = 1000U;
+	UINT smallHitObjectCount = 0U;
+	const UINT smallAllocationCount = CountParseAllocations(directory.WriteFile("Small.osu", MakeSyntheticBeatmap(synthetic)), smallHitObjectCount);
+
+	synthetic.m_hitObjectCount = 8000U;
+	UINT largeHitObjectCount = 0U;
+	const UINT largeAllocationCount = CountParseAllocations(directory.WriteFile("Large.osu", MakeSyntheticBeatmap(synthetic)), largeHitObjectCount);
+
+	printf("%u circles: %u allocations, %u circles: %u allocations\n", smallHitObjectCount, smallAllocationCount, largeHitObjectCount, largeAllocationCount);
+	REQUIRE(smallHitObjectCount == 1000U);
+	REQUIRE(largeHitObjectCount == 8000U);
+
+	// The 7000 more lines only grow the arrays a few more times.
+	CHECK(largeAllocationCount < smallAllocationCount + 64U);
+}
+
+TEST_CASE(ParsesSlidersWithFewAllocations) {
+	const TestDirectory directory("ParsesSlidersWithFewAllocations");
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = 2000U;
+
+	UINT hitObjectCount = 0U;
+	const UINT parseAllocationCount = CountParseAllocations(directory.WriteFile("Mixed.osu", MakeSyntheticBeatmap(synthetic)), hitObjectCount);
+	REQUIRE(hitObjectCount == 2000U);
+
+	// The slider path cache allocates for every new slider, the tokens of a line and its control points don't.
+	printf("%u hit objects: %u allocations\n", hitObjectCount, parseAllocationCount);
+	CHECK(parseAllocationCount < hitObjectCount * 3U);
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+// ParseNumberTests.cpp : Tests the number parsing of the beatmap parser against the standard library.
+
+#include <TestSupport/Test.h>
+
+#include <Common/ParseNumber.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// The result of parsing a string from its start.
+	template<typename _T>
+	struct ParsedNumber {
+		ParseError error;
+		_T value;
+		size_t lenght;
+	};
+
+	// Parses the string, the value keeps the initial value when the parse fails.
+	template<typename _T>
+	ParsedNumber<_T> Parse(_In_ const std::string& str, _In_ const _T& initialValue) {
+		ParsedNumber<_T> parsed = { ParseError::None, initialValue, 0U };
+		const ParseResult<char> result = ParseNumber(str.data(), str.data() + str.size(), parsed.value);
+		parsed.error = result.error;
+		parsed.lenght = static_cast<size_t>(result.ptr - str.data());
+		return parsed;
+	}
+
+	// Checks that the string parses to the value, with the lenght of the number.
+	template<typename _T>
+	void CheckParsed(_In_ const std::string& str, _In_ const _T& value, _In_ const size_t& lenght) {
+		const ParsedNumber<_T> parsed = Parse(str, _T(0));
+		CHECK(parsed.error == ParseError::None);
+		CHECK_EQUAL(value, parsed.value);
+		CHECK_EQUAL(lenght, parsed.lenght);
+	}
+
+	// Checks that the string fails to parse with the error, and the value isn't changed.
+	template<typename _T>
+	void CheckFailed(_In_ const std::string& str, _In_ const ParseError& error) {
+		const ParsedNumber<_T> parsed = Parse(str, _T(7));
+		CHECK(parsed.error == error);
+		CHECK_EQUAL(_T(7), parsed.value);
+	}
+}
+
+
+TEST_CASE(ParsesIntegers) {
+	CheckParsed<int>("0", 0, 1U);
+	CheckParsed<int>("123", 123, 3U);
+	CheckParsed<int>("-45", -45, 3U);
+	CheckParsed<int>("+7", 7, 2U);
+	CheckParsed<int>("  \t12", 12, 5U);
+	CheckParsed<int>("007", 7, 3U);
+	CheckParsed<int>("2147483647", 2147483647, 10U);
+	CheckParsed<int>("-2147483648", -2147483647 - 1, 11U);
+}
+
+TEST_CASE(StopsIntegersAtTrailingCharacters) {
+	// The characters after the number are left for the caller, like std::stoi.
+	CheckParsed<int>("12abc", 12, 2U);
+	CheckParsed<int>("64,192", 64, 2U);
+	CheckParsed<int>("-3:4", -3, 2U);
+	CheckParsed<int>("1.5", 1, 1U);
+	CheckParsed<int>("1e3", 1, 1U);
+	CheckParsed<UINT>("42\r", 42U, 2U);
+}
+
+TEST_CASE(RejectsIntegersWithoutDigits) {
+	CheckFailed<int>("", ParseError::InvalidArgument);
+	CheckFailed<int>("abc", ParseError::InvalidArgument);
+	CheckFailed<int>("-", ParseError::InvalidArgument);
+	CheckFailed<int>("+-1", ParseError::InvalidArgument);
+	CheckFailed<int>(" ", ParseError::InvalidArgument);
+	CheckFailed<UINT>(".5", ParseError::InvalidArgument);
+
+	// A failed parse points at the start of the range.
+	CHECK_EQUAL(0U, Parse<int>("x1", 0).lenght);
+}
+
+TEST_CASE(RejectsIntegersOutOfRange) {
+	CheckFailed<int>("2147483648", ParseError::OutOfRange);
+	CheckFailed<int>("-2147483649", ParseError::OutOfRange);
+	CheckFailed<int>("99999999999999999999999", ParseError::OutOfRange);
+	CheckFailed<UINT>("4294967296", ParseError::OutOfRange);
+	CheckFailed<UINT>("-1", ParseError::OutOfRange);
+	CheckParsed<UINT>("4294967295", 4294967295U, 10U);
+	CheckParsed<UINT>("-0", 0U, 2U);
+
+	// The whole number is read, even when it is out of range.
+	CHECK_EQUAL(23U, Parse<int>("99999999999999999999999,1", 0).lenght);
+}
+
+TEST_CASE(ParsesDecimals) {
+	CheckParsed<float>("1.5", 1.5f, 3U);
+	CheckParsed<float>("-0.25", -0.25f, 5U);
+	CheckParsed<float>("+3", 3.f, 2U);
+	CheckParsed<float>(".5", 0.5f, 2U);
+	CheckParsed<float>("5.", 5.f, 2U);
+	CheckParsed<float>(" 1.4", 1.4f, 4U);
+	CheckParsed<float>("0", 0.f, 1U);
+	CheckParsed<double>("333.333333333333", 333.333333333333, 16U);
+	CheckParsed<double>("-133.333333333333", -133.333333333333, 17U);
+	CheckParsed<double>("0.000000000000000000000000000001", 1e-30, 32U);
+
+	// Digits after the 19th significant digit only move the exponent.
+	CheckParsed<double>("12345678901234567890123", 12345678901234567890123.0, 23U);
+}
+
+TEST_CASE(ParsesExponents) {
+	CheckParsed<float>("1e3", 1000.f, 3U);
+	CheckParsed<float>("1E-2", 0.01f, 4U);
+	CheckParsed<float>("2.5e+2", 250.f, 6U);
+	CheckParsed<double>("-4.2e-7", -4.2e-7, 7U);
+	CheckParsed<double>("1e22", 1e22, 4U);
+
+	// Past the exact powers of 10 the value is scaled with pow, it may be a step away from the nearest double.
+	CHECK_NEAR(1e23, Parse<double>("1e23", 0.0).value, 1e23 * 1e-15);
+	CHECK_NEAR(1e-300, Parse<double>("1e-300", 0.0).value, 1e-300 * 1e-15);
+	CheckParsed<double>("0e999", 0.0, 5U);
+
+	// An exponent without digits is not part of the number.
+	CheckParsed<float>("1e", 1.f, 1U);
+	CheckParsed<float>("1e+", 1.f, 1U);
+	CheckParsed<float>("2E-x", 2.f, 1U);
+}
+
+TEST_CASE(StopsDecimalsAtTrailingCharacters) {
+	CheckParsed<float>("1.4,", 1.4f, 3U);
+	CheckParsed<float>("210.5|0", 210.5f, 5U);
+	CheckParsed<float>("3.5.5", 3.5f, 3U);
+	CheckParsed<float>("-1-1", -1.f, 2U);
+	CheckParsed<double>("1.0f", 1.0, 3U);
+}
+
+TEST_CASE(RejectsDecimalsWithoutDigits) {
+	CheckFailed<float>("", ParseError::InvalidArgument);
+	CheckFailed<float>(".", ParseError::InvalidArgument);
+	CheckFailed<float>("-.", ParseError::InvalidArgument);
+	CheckFailed<float>("e5", ParseError::InvalidArgument);
+	CheckFailed<float>("inf", ParseError::InvalidArgument);
+	CheckFailed<double>("nan", ParseError::InvalidArgument);
+}
+
+TEST_CASE(RejectsDecimalsOutOfRange) {
+	CheckFailed<float>("1e39", ParseError::OutOfRange);
+	CheckFailed<float>("-3.5e38", ParseError::OutOfRange);
+	CheckFailed<float>("1e-50", ParseError::OutOfRange);
+	CheckFailed<double>("1e400", ParseError::OutOfRange);
+	CheckFailed<double>("1e-400", ParseError::OutOfRange);
+	CheckParsed<float>("3.4e38", 3.4e38f, 6U);
+}
+
+TEST_CASE(ParsesWideCharacters) {
+	const std::wstring str = L"-12.5e1,3";
+	float value = 0.f;
+	const ParseResult<wchar_t> result = ParseNumber(str.data(), str.data() + str.size(), value);
+	CHECK(result.error == ParseError::None);
+	CHECK_EQUAL(-125.f, value);
+	CHECK_EQUAL(7, result.ptr - str.data());
+
+	int integer = 0;
+	CHECK(ParseNumber(std::wstring_view(L"+31"), integer) == ParseError::None);
+	CHECK_EQUAL(31, integer);
+}
+
+TEST_CASE(MatchesTheStandardLibrary) {
+	// Random decimals the way beatmaps write them: up to 15 significant digits, some with an exponent.
+	std::mt19937 random(4U);
+	UINT differentFloatCount = 0U;
+	UINT differentDoubleCount = 0U;
+	UINT differentIntCount = 0U;
+
+	for (UINT i = 0U; i < 100000U; i++) {
+		char str[64];
+		const double number = static_cast<double>(random() % 100000000U) / static_cast<double>(1U + random() % 100000U);
+		const int precision = 1 + static_cast<int>(random() % 15U);
+		if (random() % 4U == 0U) {
+			snprintf(str, sizeof(str), "%s%.*e", (random() % 2U) ? "-" : "", precision - 1, number);
+		}
+		else {
+			snprintf(str, sizeof(str), "%s%.*g", (random() % 2U) ? "-" : "", precision, number);
+		}
+
+		// The float is rounded from the double, it may be one step away from std::stof in a halfway case.
+		const float expectedFloat = std::stof(str);
+		const ParsedNumber<float> parsedFloat = Parse(std::string(str), 0.f);
+		if (parsedFloat.error != ParseError::None ||
+			(parsedFloat.value != expectedFloat && parsedFloat.value != std::nextafter(expectedFloat, 0.f) &&
+				parsedFloat.value != std::nextafter(expectedFloat, expectedFloat * 2.f))) {
+			differentFloatCount++;
+		}
+
+		// Up to 15 digits and exponents up to 22 are exact.
+		const ParsedNumber<double> parsedDouble = Parse(std::string(str), 0.0);
+		if (parsedDouble.error != ParseError::None || parsedDouble.value != std::strtod(str, nullptr)) {
+			differentDoubleCount++;
+		}
+
+		// Integers, as std::stoi reads them.
+		snprintf(str, sizeof(str), "%d", static_cast<int>(random()));
+		const ParsedNumber<int> parsedInt = Parse(std::string(str), 0);
+		if (parsedInt.error != ParseError::None || parsedInt.value != std::stoi(str)) {
+			differentIntCount++;
+		}
+	}
+
+	CHECK_EQUAL(0U, differentFloatCount);
+	CHECK_EQUAL(0U, differentDoubleCount);
+	CHECK_EQUAL(0U, differentIntCount);
+}
\ No newline at end of file
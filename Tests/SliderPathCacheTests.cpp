@@ -0,0 +1,97 @@
+// SliderPathCacheTests.cpp : Tests that a slider path from the slider path cache is the path
+// the slider is flattened into, and that the cache keeps its memory budget.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/Beatmap.h>
+#include <Content/OsuBot/SliderPathCache.h>
+
+#include <cstring>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// Returns the number of sliders of both beatmaps with a different path.
+	UINT CountDifferentPaths(_In_ const Beatmap& lhs, _In_ const Beatmap& rhs) {
+		UINT differentPathCount = 0U;
+		for (UINT i = 0U; i < lhs.GetHitObjectsCount(); i++) {
+			const HitObject lhsObject = lhs.GetHitObjectAtIndex(i);
+			if (lhsObject.GetObjectType() != HITOBJECT_SLIDER) {
+				continue;
+			}
+
+			const SliderPath lhsPath = lhsObject.GetSliderPath();
+			const SliderPath rhsPath = rhs.GetHitObjectAtIndex(i).GetSliderPath();
+			if (lhsPath.GetPointCount() != rhsPath.GetPointCount() ||
+				memcmp(lhsPath.GetPoints(), rhsPath.GetPoints(), lhsPath.GetPointCount() * sizeof(vec2f)) != 0 ||
+				lhsPath.GetLenght() != rhsPath.GetLenght()) {
+				differentPathCount++;
+			}
+		}
+		return differentPathCount;
+	}
+
+	// Returns the number of sliders of the beatmap.
+	UINT CountSliders(_In_ const Beatmap& beatmap) {
+		UINT sliderCount = 0U;
+		for (UINT i = 0U; i < beatmap.GetHitObjectsCount(); i++) {
+			if (beatmap.GetHitObjectAtIndex(i).GetObjectType() == HITOBJECT_SLIDER) {
+				sliderCount++;
+			}
+		}
+		return sliderCount;
+	}
+}
+
+
+TEST_CASE(GivesTheFlattenedPathsFromTheCache) {
+	const TestDirectory directory("GivesTheFlattenedPathsFromTheCache");
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = 2000U;
+	const std::wstring beatmapPath = directory.WriteFile("Mixed.osu", MakeSyntheticBeatmap(synthetic));
+
+	SliderPathCache& sliderPathCache = SliderPathCache::GetInstance();
+	sliderPathCache.Clear();
+	Beatmap flattenedBeatmap(beatmapPath.c_str());
+	REQUIRE(flattenedBeatmap.ParseBeatmap(FALSE));
+	const SliderPathCache::Statistics firstStatistics = sliderPathCache.GetStatistics();
+
+	Beatmap cachedBeatmap(beatmapPath.c_str());
+	REQUIRE(cachedBeatmap.ParseBeatmap(FALSE));
+	const SliderPathCache::Statistics statistics = sliderPathCache.GetStatistics();
+
+	// Every slider of the second parse is found in the cache.
+	CHECK_EQUAL(static_cast<ULONGLONG>(CountSliders(cachedBeatmap)), statistics.hits - firstStatistics.hits);
+	CHECK_EQUAL(firstStatistics.misses, statistics.misses);
+	CHECK_EQUAL(0U, CountDifferentPaths(flattenedBeatmap, cachedBeatmap));
+}
+
+TEST_CASE(KeepsTheMemoryBudget) {
+	const TestDirectory directory("KeepsTheMemoryBudget");
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = 2000U;
+	const std::wstring beatmapPath = directory.WriteFile("Mixed.osu", MakeSyntheticBeatmap(synthetic));
+
+	SliderPathCache& sliderPathCache = SliderPathCache::GetInstance();
+	sliderPathCache.Clear();
+	sliderPathCache.SetMemoryBudget(64U * 1024U);
+
+	Beatmap flattenedBeatmap(beatmapPath.c_str());
+	REQUIRE(flattenedBeatmap.ParseBeatmap(FALSE));
+	Beatmap cachedBeatmap(beatmapPath.c_str());
+	REQUIRE(cachedBeatmap.ParseBeatmap(FALSE));
+	const SliderPathCache::Statistics statistics = sliderPathCache.GetStatistics();
+
+	// The least recently used paths were removed, the paths that are left are still the same.
+	CHECK(statistics.memoryUsage <= 64U * 1024U);
+	CHECK(statistics.evictions > 0U);
+	CHECK_EQUAL(0U, CountDifferentPaths(flattenedBeatmap, cachedBeatmap));
+
+	sliderPathCache.SetMemoryBudget(16U * 1024U * 1024U);
+	sliderPathCache.Clear();
+}
\ No newline at end of file
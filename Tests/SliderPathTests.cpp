@@ -0,0 +1,197 @@
+// SliderPathTests.cpp : Tests the flattened slider paths against the evaluator the bot used before,
+// which sampled every curve 50 times per control point.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/ReferenceSliderPath.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/Beatmap.h>
+
+#include <algorithm>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// The distances between the flattened paths and the old evaluator.
+	struct PathDistances {
+		UINT m_sliderCount = 0U;
+		// The distances on the curves.
+		std::vector<float> m_distances;
+		// The distances past the end of the curves, per pixel of extension.
+		float m_maximumExtensionDistance = 0.f;
+
+		float GetMaximum() const { return m_distances.empty() ? 0.f : *std::max_element(m_distances.begin(), m_distances.end()); }
+		float GetPercentile(_In_ const double& percentile) {
+			std::sort(m_distances.begin(), m_distances.end());
+			return m_distances.empty() ? 0.f : m_distances[static_cast<size_t>(percentile * (m_distances.size() - 1U))];
+		}
+	};
+
+	// Returns the distances at 101 times along every linear and bezier slider of the beatmap.
+	PathDistances MeasurePathDistances(_In_ const TestDirectory& directory, _In_ const SyntheticBeatmap& synthetic) {
+		const std::string content = MakeSyntheticBeatmap(synthetic);
+		const std::wstring beatmapPath = directory.WriteFile("Sliders.osu", content);
+
+		Beatmap beatmap(beatmapPath.c_str());
+		if (!beatmap.ParseBeatmap(FALSE)) {
+			return PathDistances();
+		}
+
+		const std::vector<ReferenceSlider> sliders = ReadReferenceSliders(content);
+		PathDistances distances;
+		for (UINT i = 0U; i < beatmap.GetHitObjectsCount() && i < sliders.size(); i++) {
+			const ReferenceSlider& slider = sliders[i];
+
+			// Perfect circle sliders are arcs, catmull sliders are splines, the old evaluator had neither.
+			const bool bezier = slider.m_sliderType == 'B' || (slider.m_sliderType == 'P' && slider.m_controlPoints.size() != 3U);
+			if (slider.m_sliderType != 'L' && !bezier) {
+				continue;
+			}
+
+			const SliderPath path = beatmap.GetHitObjectAtIndex(i).GetSliderPath();
+			const ReferenceSliderPath referencePath(slider);
+			for (UINT j = 0U; j <= 100U; j++) {
+				const double time = j / 100.0;
+				const float distance = (path.GetPointByT(time) - referencePath.GetPointByT(time)).Length();
+
+				// A short path is extended along its last line. The last flattened line is a chord of the curve,
+				// its direction is a few degrees off the tangent, so the distance grows along the extension.
+				const double extensionLenght = time * slider.m_pixelLenght - referencePath.GetCurveLenght();
+				if (extensionLenght > 1.0) {
+					distances.m_maximumExtensionDistance = (std::max)(distances.m_maximumExtensionDistance, static_cast<float>(distance / extensionLenght));
+				}
+				else {
+					distances.m_distances.push_back(distance);
+				}
+			}
+			distances.m_sliderCount++;
+		}
+
+		return distances;
+	}
+}
+
+
+TEST_CASE(MatchesTheOldEvaluator) {
+	const TestDirectory directory("MatchesTheOldEvaluator");
+
+	PathDistances distances;
+	for (UINT seed = 1U; seed <= 3U; seed++) {
+		SyntheticBeatmap synthetic;
+		synthetic.m_hitObjectCount = 2000U;
+		synthetic.m_seed = seed;
+
+		const PathDistances seedDistances = MeasurePathDistances(directory, synthetic);
+		distances.m_sliderCount += seedDistances.m_sliderCount;
+		distances.m_distances.insert(distances.m_distances.end(), seedDistances.m_distances.begin(), seedDistances.m_distances.end());
+		distances.m_maximumExtensionDistance = (std::max)(distances.m_maximumExtensionDistance, seedDistances.m_maximumExtensionDistance);
+	}
+	REQUIRE(distances.m_sliderCount > 1000U);
+
+	// The flattened path is within 0.25 px of the curve, and the old samples are on the curve.
+	// Along the path the lenghts of both polylines drift apart a little, so the points may be a bit further apart.
+	const float maximum = distances.GetMaximum();
+	const float median = distances.GetPercentile(0.5);
+	const float percentile99 = distances.GetPercentile(0.99);
+	printf("%u sliders, distance to the old evaluator: median %.4f px, p99 %.4f px, max %.4f px, max %.4f px per extended px\n",
+		distances.m_sliderCount, median, percentile99, maximum, distances.m_maximumExtensionDistance);
+
+	CHECK(median <= 0.05f);
+	CHECK(percentile99 <= 0.25f);
+	CHECK(maximum <= 1.f);
+
+	// The extension is at most about 6 degrees off the tangent of the curve.
+	CHECK(distances.m_maximumExtensionDistance <= 0.1f);
+}
+
+TEST_CASE(CutsAndExtendsToThePixelLenght) {
+	const TestDirectory directory("CutsAndExtendsToThePixelLenght");
+	const std::wstring beatmapPath = directory.WriteFile("Lenghts.osu",
+		"osu file format v14\r\n\r\n[Difficulty]\r\nSliderMultiplier:1.4\r\n\r\n[TimingPoints]\r\n0,500,4,2,0,60,1,0\r\n\r\n[HitObjects]\r\n"
+		"0,0,1000,2,0,L|100:0,1,200\r\n"
+		"0,0,3000,2,0,L|100:0,1,50\r\n"
+		"0,0,5000,2,0,B|100:0|100:100,1,100\r\n");
+
+	Beatmap beatmap(beatmapPath.c_str());
+	REQUIRE(beatmap.ParseBeatmap(FALSE));
+	REQUIRE(beatmap.GetHitObjectsCount() == 3U);
+
+	// A path shorter than the pixel lenght goes on along its last line.
+	const SliderPath extended = beatmap.GetHitObjectAtIndex(0U).GetSliderPath();
+	CHECK_NEAR(200.f, extended.GetLenght(), 0.01f);
+	CHECK_NEAR(200.f, extended.GetPointByT(1.0).X, 0.01f);
+	CHECK_NEAR(150.f, extended.GetPointByT(0.75).X, 0.01f);
+
+	// A longer path is cut at the pixel lenght.
+	const SliderPath cut = beatmap.GetHitObjectAtIndex(1U).GetSliderPath();
+	CHECK_NEAR(50.f, cut.GetLenght(), 0.01f);
+	CHECK_NEAR(50.f, cut.GetPointByT(1.0).X, 0.01f);
+
+	// Times outside of the path are clamped to its ends.
+	const SliderPath curve = beatmap.GetHitObjectAtIndex(2U).GetSliderPath();
+	CHECK_NEAR(100.f, curve.GetLenght(), 0.01f);
+	CHECK((curve.GetPointByT(-1.0) - vec2f(0.f, 0.f)).Length() < 0.01f);
+	CHECK((curve.GetPointByT(2.0) - curve.GetPointByT(1.0)).Length() < 0.01f);
+}
+
+TEST_CASE(GivesTheSamePointsInOneSweep) {
+	const TestDirectory directory("GivesTheSamePointsInOneSweep");
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = 500U;
+	const std::wstring beatmapPath = directory.WriteFile("Sliders.osu", MakeSyntheticBeatmap(synthetic));
+
+	Beatmap beatmap(beatmapPath.c_str());
+	REQUIRE(beatmap.ParseBeatmap(FALSE));
+
+	double times[64];
+	for (UINT j = 0U; j < 64U; j++) {
+		times[j] = j / 63.0;
+	}
+
+	UINT differentPointCount = 0U;
+	for (UINT i = 0U; i < beatmap.GetHitObjectsCount(); i++) {
+		const HitObject hitObject = beatmap.GetHitObjectAtIndex(i);
+		if (hitObject.GetObjectType() != HITOBJECT_SLIDER) {
+			continue;
+		}
+
+		const SliderPath path = hitObject.GetSliderPath();
+		vec2f points[64];
+		path.GetPointsByT(times, 64U, points);
+		for (UINT j = 0U; j < 64U; j++) {
+			if (points[j] != path.GetPointByT(times[j])) {
+				differentPointCount++;
+			}
+		}
+	}
+	CHECK_EQUAL(0U, differentPointCount);
+}
+
+TEST_CASE(FollowsASliderWithoutSliderTime) {
+	const TestDirectory directory("FollowsASliderWithoutSliderTime");
+	const std::wstring beatmapPath = directory.WriteFile("SliderTime.osu",
+		"osu file format v14\r\n\r\n[Difficulty]\r\nSliderMultiplier:1.4\r\n\r\n[TimingPoints]\r\n0,500,4,2,0,60,1,0\r\n\r\n[HitObjects]\r\n"
+		"10,20,1000,2,0,L|100:20,1,0.1\r\n"
+		"10,20,3000,2,0,L|100:20,2,0.1\r\n");
+
+	Beatmap beatmap(beatmapPath.c_str());
+	REQUIRE(beatmap.ParseBeatmap(FALSE));
+	REQUIRE(beatmap.GetHitObjectsCount() == 2U);
+
+	// The slider is too short to take a millisecond, the cursor stays on its head.
+	for (UINT i = 0U; i < beatmap.GetHitObjectsCount(); i++) {
+		const HitObject slider = beatmap.GetHitObjectAtIndex(i);
+		REQUIRE(slider.GetSliderTime() == 0);
+
+		SliderFollower follower;
+		follower.Follow(slider);
+		for (const double songTime : { -1.0, 0.0, 1.0 }) {
+			const vec2f point = follower.GetPointAtTime(slider.GetStartTime() + songTime);
+			CHECK((point - slider.GetStartPosition()).Length() < 0.01f);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+// SliderTimelineTests.cpp : Tests the events of the slider timelines, the head, ticks, repeats and tail
+// of every span at their time and point on the slider path.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/Beatmap.h>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// An event the timeline should have, the point is on the x axis.
+	struct ExpectedEvent {
+		BYTE m_type;
+		int m_time;
+		float m_x;
+	};
+
+	// Checks the timeline of the slider against the events.
+	template<size_t _Size>
+	void CheckTimeline(_In_ const HitObject& slider, _In_ const ExpectedEvent(&expectedEvents)[_Size]) {
+		REQUIRE(slider.GetObjectType() == HITOBJECT_SLIDER);
+		REQUIRE(slider.GetSliderEventCount() == _Size);
+
+		for (UINT i = 0U; i < _Size; i++) {
+			const SliderEvent& event = slider.GetSliderEvent(i);
+			CHECK_EQUAL(expectedEvents[i].m_type, event.m_type);
+			CHECK_EQUAL(expectedEvents[i].m_time, event.m_time);
+			CHECK_NEAR(expectedEvents[i].m_x, event.m_position.X, 0.01f);
+		}
+	}
+
+	// Parses the hit objects with a tick every 140 osu!pixels and 400 milliseconds.
+	Beatmap ParseHitObjects(_In_ const TestDirectory& directory, _In_ const std::string& hitObjects) {
+		const std::wstring beatmapPath = directory.WriteFile("Timeline.osu",
+			"osu file format v14\r\n\r\n[Difficulty]\r\nSliderMultiplier:1.4\r\nSliderTickRate:1\r\n\r\n"
+			"[TimingPoints]\r\n0,400,4,2,0,60,1,0\r\n\r\n[HitObjects]\r\n" + hitObjects);
+
+		Beatmap beatmap(beatmapPath.c_str());
+		REQUIRE(beatmap.ParseBeatmap(FALSE));
+		return beatmap;
+	}
+}
+
+
+TEST_CASE(PutsTheTicksOnEverySpan) {
+	const TestDirectory directory("PutsTheTicksOnEverySpan");
+	const Beatmap beatmap = ParseHitObjects(directory, "0,0,1000,2,0,L|420:0,2,420\r\n");
+
+	// Three ticks apart, the tick on the end of the path is the repeat.
+	const ExpectedEvent expectedEvents[] = {
+		{ SliderEvent::Head, 1000, 0.f },
+		{ SliderEvent::Tick, 1400, 140.f },
+		{ SliderEvent::Tick, 1800, 280.f },
+		{ SliderEvent::Repeat, 2200, 420.f },
+		{ SliderEvent::Tick, 2600, 280.f },
+		{ SliderEvent::Tick, 3000, 140.f },
+		{ SliderEvent::Tail, 3400, 0.f }
+	};
+	CheckTimeline(beatmap.GetHitObjectAtIndex(0U), expectedEvents);
+}
+
+TEST_CASE(MirrorsTheTicksOfAReversedSpan) {
+	const TestDirectory directory("MirrorsTheTicksOfAReversedSpan");
+	const Beatmap beatmap = ParseHitObjects(directory, "0,0,1000,2,0,L|350:0,3,350\r\n");
+
+	// Two and a half ticks, the reversed span meets the same ticks on the path,
+	// half a tick after the repeat instead of a whole tick.
+	const ExpectedEvent expectedEvents[] = {
+		{ SliderEvent::Head, 1000, 0.f },
+		{ SliderEvent::Tick, 1400, 140.f },
+		{ SliderEvent::Tick, 1800, 280.f },
+		{ SliderEvent::Repeat, 2000, 350.f },
+		{ SliderEvent::Tick, 2200, 280.f },
+		{ SliderEvent::Tick, 2600, 140.f },
+		{ SliderEvent::Repeat, 3000, 0.f },
+		{ SliderEvent::Tick, 3400, 140.f },
+		{ SliderEvent::Tick, 3800, 280.f },
+		{ SliderEvent::Tail, 4000, 350.f }
+	};
+	CheckTimeline(beatmap.GetHitObjectAtIndex(0U), expectedEvents);
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+// SpinnerFollowerTests.cpp : Tests the points of the spinner follower against the circle
+// and the rate it spins at, over ticks that are not evenly apart.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/SpinnerFollower.h>
+
+#include <cmath>
+#include <random>
+
+
+using namespace OsuBot;
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// A spinner of 3319 milliseconds, from 1000 milliseconds.
+	Beatmap ParseSpinner(_In_ const TestDirectory& directory) {
+		const std::wstring beatmapPath = directory.WriteFile("Spinner.osu",
+			"osu file format v14\r\n\r\n[TimingPoints]\r\n0,400,4,2,0,60,1,0\r\n\r\n[HitObjects]\r\n"
+			"256,192,1000,12,0,4319,0:0:0:0:\r\n");
+
+		Beatmap beatmap(beatmapPath.c_str());
+		REQUIRE(beatmap.ParseBeatmap(FALSE));
+		REQUIRE(beatmap.GetHitObjectsCount() == 1U);
+		REQUIRE(beatmap.GetHitObjectAtIndex(0U).GetObjectType() == HITOBJECT_SPINNER);
+		return beatmap;
+	}
+
+	// The song times of the ticks over the spinner, 0.5 to 3 milliseconds apart.
+	std::vector<double> GetJitteredTicks(_In_ const HitObject& spinner) {
+		std::mt19937 random(25U);
+		std::vector<double> songTimes;
+		for (double songTime = spinner.GetStartTime(); songTime <= spinner.GetEndTime(); songTime += 0.5 + (random() % 2500U) / 1000.0) {
+			songTimes.push_back(songTime);
+		}
+		return songTimes;
+	}
+}
+
+
+TEST_CASE(StartsAtTheRightOfTheCenter) {
+	const TestDirectory directory("StartsAtTheRightOfTheCenter");
+	const Beatmap beatmap = ParseSpinner(directory);
+	const HitObject spinner = beatmap.GetHitObjectAtIndex(0U);
+
+	SpinnerFollower follower;
+	CHECK(!follower.IsFollowing(spinner));
+	follower.Follow(spinner, vec2f(400.f, 300.f), 50.f, 477.f);
+	CHECK(follower.IsFollowing(spinner));
+
+	// Before the spinner starts the cursor waits at the start of the rotation.
+	for (const double songTime : { 500.0, 1000.0 }) {
+		const vec2f point = follower.GetPointAtTime(songTime);
+		CHECK_NEAR(450.f, point.X, 0.001f);
+		CHECK_NEAR(300.f, point.Y, 0.001f);
+	}
+}
+
+TEST_CASE(StaysOnTheCircle) {
+	const TestDirectory directory("StaysOnTheCircle");
+	const Beatmap beatmap = ParseSpinner(directory);
+	const HitObject spinner = beatmap.GetHitObjectAtIndex(0U);
+
+	SpinnerFollower follower;
+	follower.Follow(spinner, vec2f(400.f, 300.f), 50.f, 477.f);
+
+	// The point of the table is within 0.01 pixels of the point from the sine and cosine of the angle.
+	const std::vector<double> songTimes = GetJitteredTicks(spinner);
+	REQUIRE(songTimes.size() > 1000U);
+	double largestDistance = 0.0;
+	for (const double& songTime : songTimes) {
+		const double angle = -2.0 * M_PI * (songTime - spinner.GetStartTime()) * 477.0 / 60000.0;
+		const vec2f point = follower.GetPointAtTime(songTime);
+		largestDistance = (std::max)(largestDistance, std::hypot(point.X - (400.0 + cos(angle) * 50.0), point.Y - (300.0 + sin(angle) * 50.0)));
+	}
+	CHECK(largestDistance <= 0.01);
+}
+
+TEST_CASE(SpinsAtTheRpm) {
+	const TestDirectory directory("SpinsAtTheRpm");
+	const Beatmap beatmap = ParseSpinner(directory);
+	const HitObject spinner = beatmap.GetHitObjectAtIndex(0U);
+
+	SpinnerFollower follower;
+	follower.Follow(spinner, vec2f(400.f, 300.f), 50.f, 477.f);
+
+	// The angle is unwrapped over the ticks, every tick turns less than half a rotation.
+	const std::vector<double> songTimes = GetJitteredTicks(spinner);
+	double previousAngle = 0.0;
+	double totalAngle = 0.0;
+	for (const double& songTime : songTimes) {
+		const vec2f point = follower.GetPointAtTime(songTime);
+		const double angle = atan2(point.Y - 300.0, point.X - 400.0);
+		double turn = angle - previousAngle;
+		turn -= 2.0 * M_PI * floor((turn + M_PI) / (2.0 * M_PI));
+		totalAngle += turn;
+		previousAngle = angle;
+	}
+
+	// The rotations turn counterclockwise on the screen, the y axis points down.
+	const double rpm = -totalAngle / (2.0 * M_PI) / (songTimes.back() - songTimes.front()) * 60000.0;
+	CHECK_NEAR(477.0, rpm, 0.01);
+}
\ No newline at end of file
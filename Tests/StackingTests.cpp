@@ -0,0 +1,98 @@
+// StackingTests.cpp : Tests the stack indices of the hit objects against the stacking scan of osu!.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/ReferenceStacking.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/Beatmap.h>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// Parses the synthetic beatmap and checks its stack indices against osu!, some hit objects should be stacked.
+	void CheckStacking(_In_ const TestDirectory& directory, _In_ const SyntheticBeatmap& synthetic) {
+		const std::wstring beatmapPath = directory.WriteFile("Stacking.osu", MakeSyntheticBeatmap(synthetic));
+		Beatmap beatmap(beatmapPath.c_str());
+		REQUIRE(beatmap.ParseBeatmap(FALSE));
+		REQUIRE(beatmap.GetHitObjectsCount() == synthetic.m_hitObjectCount);
+
+		// The synthetic beatmaps have a stack leniency of 0.7.
+		ReferenceStacking reference(beatmap, synthetic.m_approachRate, 0.7f);
+		const std::vector<int>& stackIndices = reference.CalculateStacking();
+
+		UINT differentCount = 0U;
+		UINT stackedCount = 0U;
+		for (UINT i = 0U; i < beatmap.GetHitObjectsCount(); i++) {
+			const int stackIndex = beatmap.GetHitObjectAtIndex(i).GetStackIndex();
+			differentCount += (stackIndex != stackIndices[i]) ? 1U : 0U;
+			stackedCount += (stackIndex != 0) ? 1U : 0U;
+		}
+		CHECK_EQUAL(0U, differentCount);
+		CHECK(stackedCount > 0U);
+	}
+}
+
+
+TEST_CASE(StacksCirclesAndSliderTails) {
+	const TestDirectory directory("StacksCirclesAndSliderTails");
+	const std::wstring beatmapPath = directory.WriteFile("Stacks.osu",
+		"osu file format v14\r\n\r\n[General]\r\nStackLeniency: 0.7\r\n\r\n[Difficulty]\r\nApproachRate:9\r\nSliderMultiplier:1.4\r\nSliderTickRate:1\r\n\r\n"
+		"[TimingPoints]\r\n0,400,4,2,0,60,1,0\r\n\r\n[HitObjects]\r\n"
+		"200,200,100,1,0,0:0:0:0:\r\n"
+		"200,200,200,1,0,0:0:0:0:\r\n"
+		"201,200,300,1,0,0:0:0:0:\r\n"
+		"0,0,1000,2,0,L|100:0,1,100\r\n"
+		"100,0,1400,1,0,0:0:0:0:\r\n"
+		"100,0,1500,1,0,0:0:0:0:\r\n");
+
+	Beatmap beatmap(beatmapPath.c_str());
+	REQUIRE(beatmap.ParseBeatmap(FALSE));
+	REQUIRE(beatmap.GetHitObjectsCount() == 6U);
+
+	// The circles on one spot stack up to the last one, the circles on the slider tail down from it.
+	const int expectedStackIndices[] = { 2, 1, 0, 0, -1, -2 };
+	for (UINT i = 0U; i < 6U; i++) {
+		CHECK_EQUAL(expectedStackIndices[i], beatmap.GetHitObjectAtIndex(i).GetStackIndex());
+	}
+
+	// Calculating the stacking again gives the same indices.
+	beatmap.CalculateStacking();
+	for (UINT i = 0U; i < 6U; i++) {
+		CHECK_EQUAL(expectedStackIndices[i], beatmap.GetHitObjectAtIndex(i).GetStackIndex());
+	}
+}
+
+TEST_CASE(MatchesOsuOnStackedStreams) {
+	const TestDirectory directory("MatchesOsuOnStackedStreams");
+	for (UINT seed = 1U; seed <= 4U; seed++) {
+		SyntheticBeatmap synthetic;
+		synthetic.m_kind = BeatmapKind::StackedStreams;
+		synthetic.m_hitObjectCount = 3000U;
+		synthetic.m_seed = seed;
+		CheckStacking(directory, synthetic);
+	}
+}
+
+TEST_CASE(MatchesOsuOnDenseStreamsWithALongTimeWindow) {
+	// At approach rate 0 the time window is 1260 milliseconds, hundreds of hit objects of a 5 millisecond stream.
+	const TestDirectory directory("MatchesOsuOnDenseStreamsWithALongTimeWindow");
+	SyntheticBeatmap synthetic;
+	synthetic.m_kind = BeatmapKind::StackedStreams;
+	synthetic.m_hitObjectCount = 3000U;
+	synthetic.m_approachRate = 0.f;
+	synthetic.m_circleInterval = 5;
+	CheckStacking(directory, synthetic);
+}
+
+TEST_CASE(MatchesOsuOnMixedHitObjects) {
+	// Random positions, only a few hit objects stack.
+	const TestDirectory directory("MatchesOsuOnMixedHitObjects");
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = 5000U;
+	synthetic.m_approachRate = 0.f;
+	CheckStacking(directory, synthetic);
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+// ReferenceSliderPath.cpp : Defines the content in ReferenceSliderPath.h
+
+#include <TestSupport/ReferenceSliderPath.h>
+
+#include <Common/ParseNumber.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// Returns the binomial coefficient of n over i.
+	double GetBinomialCoefficient(_In_ const UINT& n, _In_ const UINT& i) {
+		double coefficient = 1.0;
+		for (UINT u = 0U; u < (std::min)(i, n - i); u++) {
+			coefficient = coefficient * static_cast<double>(n - u) / static_cast<double>(u + 1U);
+		}
+		return coefficient;
+	}
+
+	// Returns the fields of the line split at the separator.
+	std::vector<std::string> SplitFields(_In_ const std::string& line, _In_ const char& separator) {
+		std::vector<std::string> fields;
+		std::istringstream stream(line);
+		std::string field;
+		while (std::getline(stream, field, separator)) {
+			fields.push_back(field);
+		}
+		return fields;
+	}
+
+	// Returns the number at the start of the field.
+	template<typename _T>
+	_T ReadField(_In_ const std::string& field) {
+		_T value = _T(0);
+		ParseNumber(std::string_view(field), value);
+		return value;
+	}
+}
+
+
+// This function reads the slider of every hit object line, the lines before [HitObjects] are skipped.
+std::vector<ReferenceSlider> OsuBotTests::ReadReferenceSliders(_In_ const std::string& beatmapContent) {
+	std::vector<ReferenceSlider> sliders;
+	std::istringstream stream(beatmapContent);
+	std::string line;
+	bool hitObjectsFound = FALSE;
+
+	while (std::getline(stream, line)) {
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+
+		if (!hitObjectsFound) {
+			hitObjectsFound = line == "[HitObjects]";
+			continue;
+		}
+		if (line.empty()) {
+			continue;
+		}
+
+		const std::vector<std::string> fields = SplitFields(line, ',');
+		ReferenceSlider slider;
+		if ((ReadField<int>(fields.at(3)) & 2) > 0) {
+			slider.m_controlPoints.push_back(vec2f(ReadField<float>(fields.at(0)), ReadField<float>(fields.at(1))));
+
+			const std::vector<std::string> points = SplitFields(fields.at(5), '|');
+			slider.m_sliderType = points.at(0).at(0);
+			for (size_t i = 1U; i < points.size(); i++) {
+				const std::vector<std::string> coordinates = SplitFields(points[i], ':');
+				slider.m_controlPoints.push_back(vec2f(ReadField<float>(coordinates.at(0)), ReadField<float>(coordinates.at(1))));
+			}
+
+			// The last point is dropped when it repeats the point before it, as the parser does.
+			if (slider.m_controlPoints.size() > 1U && slider.m_controlPoints.back() == slider.m_controlPoints[slider.m_controlPoints.size() - 2U]) {
+				slider.m_controlPoints.pop_back();
+			}
+
+			slider.m_pixelLenght = ReadField<float>(fields.at(7));
+		}
+		sliders.push_back(slider);
+	}
+
+	return sliders;
+}
+
+
+// This function returns the point on the bezier curve, the sum of the control points weighted by their Bernstein polynomials.
+vec2f OsuBotTests::GetReferenceBezierPoint(_In_ const vec2f* curve, _In_ const UINT& pointCount, _In_ const double& time) {
+	const UINT degree = pointCount - 1U;
+	vec2f point(0.f, 0.f);
+
+	for (UINT i = 0U; i <= degree; i++) {
+		const double bernstein = GetBinomialCoefficient(degree, i) * pow(time, static_cast<double>(i)) * pow(1.0 - time, static_cast<double>(degree - i));
+		point.Add(curve[i].Copy().Mult(static_cast<FLOAT>(bernstein)));
+	}
+
+	return point;
+}
+
+
+// Constructor.
+ReferenceSliderPath::ReferenceSliderPath(_In_ const ReferenceSlider& slider) :
+	m_pixelLenght(slider.m_pixelLenght)
+{
+	const std::vector<vec2f>& points = slider.m_controlPoints;
+
+	if (slider.m_sliderType == 'L') {
+		for (size_t i = 1U; i < points.size(); i++) {
+			m_segments.push_back({ points[i - 1U], points[i] });
+		}
+	}
+	else {
+		// A repeated point ends the curve, the point also starts the next curve.
+		size_t curveStart = 0U;
+		for (size_t i = 0U; i < points.size(); i++) {
+			if (i - curveStart > 1U && points[i] == points[i - 1U]) {
+				m_segments.push_back(std::vector<vec2f>(points.begin() + curveStart, points.begin() + i));
+				curveStart = i;
+			}
+		}
+		m_segments.push_back(std::vector<vec2f>(points.begin() + curveStart, points.end()));
+	}
+
+	// Sample every segment from its start to its end.
+	for (const std::vector<vec2f>& segment : m_segments) {
+		const UINT sampleCount = (UINT)segment.size() * 50U;
+		for (UINT i = 0U; i < sampleCount; i++) {
+			const vec2f sample = GetReferenceBezierPoint(segment.data(), (UINT)segment.size(), static_cast<double>(i) / static_cast<double>(sampleCount - 1U));
+
+			if (m_samples.empty()) {
+				m_sampleLenghts.push_back(0.0);
+			}
+			else if (sample == m_samples.back()) {
+				continue;
+			}
+			else {
+				m_sampleLenghts.push_back(m_sampleLenghts.back() + (sample - m_samples.back()).Length());
+			}
+			m_samples.push_back(sample);
+		}
+	}
+}
+
+// This function returns the point at the lenght along the samples, interpolated between them.
+vec2f ReferenceSliderPath::GetPointByT(_In_ const double& time) const {
+	const double lenght = (std::max)(0.0, (std::min)(1.0, time)) * m_pixelLenght;
+
+	if (m_samples.size() < 2U) {
+		return m_samples.empty() ? vec2f(0.f, 0.f) : m_samples.front();
+	}
+
+	// Past the last sample the path goes on along its last line.
+	size_t line = (size_t)(std::upper_bound(m_sampleLenghts.begin(), m_sampleLenghts.end(), lenght) - m_sampleLenghts.begin());
+	line = (std::max)(line, (size_t)1U);
+	line = (std::min)(line, m_samples.size() - 1U);
+
+	const double lineTime = (lenght - m_sampleLenghts[line - 1U]) / (m_sampleLenghts[line] - m_sampleLenghts[line - 1U]);
+	const vec2f& lineStart = m_samples[line - 1U];
+	const vec2f& lineEnd = m_samples[line];
+
+	return vec2f(
+		static_cast<float>(lineStart.X + (lineEnd.X - lineStart.X) * lineTime),
+		static_cast<float>(lineStart.Y + (lineEnd.Y - lineStart.Y) * lineTime));
+}
+
+// This function walks the samples of the segments from the start of the path, like the old evaluator.
+vec2f ReferenceSliderPath::GetPointByTOld(_In_ const double& time) const {
+	vec2f oldPoint = m_segments.front().front();
+
+	double currentDistance = 0.0;
+	const double pointPixelLenght = static_cast<double>(m_pixelLenght) * time;
+
+	for (size_t segmentIndex = 0U; segmentIndex < m_segments.size(); segmentIndex++) {
+		const std::vector<vec2f>& segment = m_segments[segmentIndex];
+		const double timeStep = 1.0 / static_cast<double>(segment.size() * 50U - 1U);
+
+		if (segmentIndex == m_segments.size() - 1U) {
+			// The last segment goes on past its end until the pixel lenght.
+			double currentTime = 0.0;
+			while (currentDistance < m_pixelLenght) {
+				vec2f point = GetReferenceBezierPoint(segment.data(), (UINT)segment.size(), currentTime);
+				currentDistance += (oldPoint - point).Length();
+
+				if (currentDistance > pointPixelLenght) {
+					return oldPoint;
+				}
+
+				oldPoint = point;
+				currentTime += timeStep;
+			}
+		}
+
+		for (double currentTime = 0.0; currentTime < 1.0 + timeStep; currentTime += timeStep) {
+			vec2f point = GetReferenceBezierPoint(segment.data(), (UINT)segment.size(), currentTime);
+
+			currentDistance += (oldPoint - point).Length();
+			if (currentDistance > pointPixelLenght) {
+				return oldPoint;
+			}
+
+			oldPoint = point;
+		}
+	}
+
+	return oldPoint;
+}
\ No newline at end of file
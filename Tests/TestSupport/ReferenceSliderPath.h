@@ -0,0 +1,61 @@
+// ReferenceSliderPath.h : Declares the slider path evaluator the bot used before the paths were flattened,
+// to check the flattened paths against and to measure them against.
+
+#pragma once
+
+#include <Common/Pch.h>
+#include <Common/Vec2f.h>
+
+#include <string>
+#include <vector>
+
+
+namespace OsuBotTests
+{
+	// The slider of a hit object line, as written in the beatmap.
+	struct ReferenceSlider {
+		// The slider type ('L', 'P', 'B' or 'C'), 0 when the hit object is not a slider.
+		char m_sliderType = 0;
+		// The start position, followed by the slider points.
+		std::vector<vec2f> m_controlPoints;
+		float m_pixelLenght = 0.f;
+	};
+
+	// Returns the slider of every hit object line of the beatmap content, in order.
+	std::vector<ReferenceSlider> ReadReferenceSliders(_In_ const std::string& beatmapContent);
+
+	// A slider path of linear and bezier segments, evaluated the way the bot did before the paths were flattened:
+	// every segment is sampled 50 times per control point with the Bernstein form.
+	class ReferenceSliderPath {
+	public:
+		// Constructor.
+		// Linear sliders are split into lines, other sliders into bezier curves at the repeated points.
+		explicit ReferenceSliderPath(_In_ const ReferenceSlider& slider);
+
+		// Member functions.
+		// Returns the point at the time (0.0 - 1.0) along the path, between the samples of the old evaluator.
+		// A path shorter than the pixel lenght is extended along its last line.
+		vec2f GetPointByT(_In_ const double& time) const;
+		// Returns the point at the time like the old evaluator: the samples are walked from the start on every call,
+		// and the last sample before the lenght is returned.
+		vec2f GetPointByTOld(_In_ const double& time) const;
+
+		// Accessor functions.
+		UINT GetSampleCount() const { return (UINT)m_samples.size(); }
+		// The lenght of the curves, without the extension to the pixel lenght.
+		double GetCurveLenght() const { return m_sampleLenghts.empty() ? 0.0 : m_sampleLenghts.back(); }
+
+
+	private:
+		// Member variables.
+		std::vector<std::vector<vec2f>> m_segments;
+		float m_pixelLenght;
+
+		// The samples of all segments, with the lenght from the start of the path at every sample.
+		std::vector<vec2f> m_samples;
+		std::vector<double> m_sampleLenghts;
+	};
+
+	// Returns the point on the bezier curve at the time (0.0 - 1.0), with the Bernstein form.
+	vec2f GetReferenceBezierPoint(_In_ const vec2f* curve, _In_ const UINT& pointCount, _In_ const double& time);
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+// ReferenceStacking.cpp : Defines the content in ReferenceStacking.h
+
+#include <TestSupport/ReferenceStacking.h>
+
+#include <algorithm>
+
+
+using namespace OsuBot::BeatmapInfo;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// Hit objects closer than this (in osu!pixels) are stacked.
+	constexpr float stackDistance = 3.f;
+}
+
+
+// Constructor.
+ReferenceStacking::ReferenceStacking(_In_ const Beatmap& beatmap, _In_ const float& approachRate, _In_ const float& stackLeniency) {
+	const double preemptTime = approachRate > 5.f ? 1200.0 - 750.0 * (approachRate - 5.f) / 5.0 : 1200.0 + 600.0 * (5.f - approachRate) / 5.0;
+	m_stackThreshold = preemptTime * stackLeniency;
+
+	const UINT hitObjectCount = beatmap.GetHitObjectsCount();
+	m_startTimes.resize(hitObjectCount);
+	m_endTimes.resize(hitObjectCount);
+	m_objectTypes.resize(hitObjectCount);
+	m_startPositions.resize(hitObjectCount);
+	m_endPositions.resize(hitObjectCount);
+	m_stackIndices.resize(hitObjectCount);
+
+	for (UINT i = 0U; i < hitObjectCount; i++) {
+		const HitObject hitObject = beatmap.GetHitObjectAtIndex(i);
+		m_startTimes[i] = hitObject.GetStartTime();
+		m_endTimes[i] = hitObject.GetEndTime();
+		m_objectTypes[i] = (BYTE)hitObject.GetObjectType();
+		m_startPositions[i] = hitObject.GetStartPosition();
+		m_endPositions[i] = (m_objectTypes[i] == HITOBJECT_SLIDER) ? hitObject.GetEndPosition() : m_startPositions[i];
+	}
+}
+
+// This function calculates the stack indices like the stacking of osu!, it is quadratic in the hit objects of the time window.
+const std::vector<int>& ReferenceStacking::CalculateStacking() {
+	std::fill(m_stackIndices.begin(), m_stackIndices.end(), 0);
+	auto isStacked = [](const vec2f& position, const vec2f& stackPosition) { return (position - stackPosition).Length() < stackDistance; };
+
+	for (int i = (int)m_stackIndices.size() - 1; i > 0; i--) {
+		if (m_stackIndices[i] != 0 || m_objectTypes[i] == HITOBJECT_SPINNER) {
+			continue;
+		}
+
+		int stackTop = i;
+		if (m_objectTypes[i] == HITOBJECT_CIRCLE) {
+			for (int n = i - 1; n >= 0; n--) {
+				if (m_objectTypes[n] == HITOBJECT_SPINNER) {
+					continue;
+				}
+				if (m_startTimes[stackTop] - m_endTimes[n] > m_stackThreshold) {
+					break;
+				}
+
+				if (m_objectTypes[n] == HITOBJECT_SLIDER && isStacked(m_endPositions[n], m_startPositions[stackTop])) {
+					// The stack is on the slider tail, the hit objects on the tail move the other way.
+					const int offset = m_stackIndices[stackTop] - m_stackIndices[n] + 1;
+					for (int j = n + 1; j <= i; j++) {
+						if (isStacked(m_endPositions[n], m_startPositions[j])) {
+							m_stackIndices[j] -= offset;
+						}
+					}
+					break;
+				}
+
+				if (isStacked(m_startPositions[n], m_startPositions[stackTop])) {
+					m_stackIndices[n] = m_stackIndices[stackTop] + 1;
+					stackTop = n;
+				}
+			}
+		}
+		else {
+			for (int n = i - 1; n >= 0; n--) {
+				if (m_objectTypes[n] == HITOBJECT_SPINNER) {
+					continue;
+				}
+				if (m_startTimes[stackTop] - m_startTimes[n] > m_stackThreshold) {
+					break;
+				}
+
+				if (isStacked(m_endPositions[n], m_startPositions[stackTop])) {
+					m_stackIndices[n] = m_stackIndices[stackTop] + 1;
+					stackTop = n;
+				}
+			}
+		}
+	}
+
+	return m_stackIndices;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+// ReferenceStacking.h : Declares the stacking scan of osu!, to check the stack indices of the bot against and to measure them against.
+
+#pragma once
+
+#include <Common/Pch.h>
+#include <Common/Vec2f.h>
+
+#include <Content/OsuBot/Beatmap.h>
+
+#include <vector>
+
+
+namespace OsuBotTests
+{
+	// The stacking of file format v6 and newer the way osu! calculates it: going back from every hit object,
+	// every hit object before it in the stack time window is compared with the stack top.
+	class ReferenceStacking {
+	public:
+		// Constructor.
+		// The hit objects are copied from the parsed beatmap, the approach rate and stack leniency are those of its file.
+		ReferenceStacking(_In_ const OsuBot::BeatmapInfo::Beatmap& beatmap, _In_ const float& approachRate, _In_ const float& stackLeniency);
+
+		// Member functions.
+		// Calculates the stack index of every hit object.
+		const std::vector<int>& CalculateStacking();
+
+		// Accessor functions.
+		const std::vector<int>& GetStackIndices() const { return m_stackIndices; }
+
+
+	private:
+		// Member variables.
+		double m_stackThreshold;
+
+		std::vector<int> m_startTimes;
+		std::vector<int> m_endTimes;
+		std::vector<BYTE> m_objectTypes;
+		std::vector<vec2f> m_startPositions;
+		// Circles and spinners end where they start.
+		std::vector<vec2f> m_endPositions;
+
+		std::vector<int> m_stackIndices;
+	};
+}
\ No newline at end of file
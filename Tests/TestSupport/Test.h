@@ -0,0 +1,84 @@
+// Test.h : Declares the test cases and checks of the headless tests.
+// Every test file is its own executable, TestMain.cpp runs the test cases in it.
+
+#pragma once
+
+#include <Common/Pch.h>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+
+// Declares and registers a test case.
+#define TEST_CASE(name) \
+	static void name(); \
+	static const OsuBotTests::TestRegistration name##Registration(#name, name); \
+	static void name()
+
+// Checks that the condition is true, the test case continues when it is not.
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			OsuBotTests::ReportFailure(__FILE__, __LINE__, "CHECK(" #condition ")"); \
+		} \
+	} while (0)
+
+// Checks that the condition is true, the test case stops when it is not.
+#define REQUIRE(condition) \
+	do { \
+		if (!(condition)) { \
+			OsuBotTests::ReportFailure(__FILE__, __LINE__, "REQUIRE(" #condition ")"); \
+			throw OsuBotTests::RequireFailed(); \
+		} \
+	} while (0)
+
+// Checks that the values are equal.
+#define CHECK_EQUAL(expected, actual) \
+	do { \
+		const auto& checkExpected = (expected); \
+		const auto& checkActual = (actual); \
+		if (!(checkExpected == checkActual)) { \
+			OsuBotTests::ReportFailure(__FILE__, __LINE__, "CHECK_EQUAL(" #expected ", " #actual "): " + \
+				OsuBotTests::ToString(checkExpected) + " != " + OsuBotTests::ToString(checkActual)); \
+		} \
+	} while (0)
+
+// Checks that the values are at most the tolerance apart.
+#define CHECK_NEAR(expected, actual, tolerance) \
+	do { \
+		const double checkExpected = static_cast<double>(expected); \
+		const double checkActual = static_cast<double>(actual); \
+		if (!(std::fabs(checkExpected - checkActual) <= static_cast<double>(tolerance))) { \
+			OsuBotTests::ReportFailure(__FILE__, __LINE__, "CHECK_NEAR(" #expected ", " #actual ", " #tolerance "): " + \
+				OsuBotTests::ToString(checkExpected) + " and " + OsuBotTests::ToString(checkActual)); \
+		} \
+	} while (0)
+
+
+namespace OsuBotTests
+{
+	// A test case function, registered with TEST_CASE.
+	using TestFunction = void (*)();
+
+	// Registers a test case when the test executable starts.
+	class TestRegistration {
+	public:
+		TestRegistration(_In_ const char* name, _In_ TestFunction function);
+	};
+
+	// Thrown by REQUIRE to stop the test case.
+	struct RequireFailed {};
+
+	// Reports a failed check of the running test case.
+	void ReportFailure(_In_ const char* file, _In_ const int& line, _In_ const std::string& message);
+
+	// Returns the value as text for a failure message.
+	template<typename _T>
+	inline std::string ToString(_In_ const _T& value) {
+		std::ostringstream stream;
+		stream.precision(9);
+		stream << value;
+		return stream.str();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,229 @@
+// TestBeatmaps.cpp : Defines the content in TestBeatmaps.h
+
+#include <TestSupport/TestBeatmaps.h>
+
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+
+using namespace OsuBotTests;
+
+
+namespace
+{
+	// A random number generator that gives the same numbers with every standard library.
+	class SyntheticRandom {
+	public:
+		explicit SyntheticRandom(_In_ const UINT& seed) :
+			m_engine(seed)
+		{}
+
+		// Returns a random integer in [minimum, maximum].
+		int Integer(_In_ const int& minimum, _In_ const int& maximum) {
+			return minimum + static_cast<int>(m_engine() % static_cast<UINT>(maximum - minimum + 1));
+		}
+
+		// Returns a random number in [0, 1).
+		double Fraction() {
+			return (m_engine() % 1000000U) / 1000000.0;
+		}
+
+		// Returns a random element of the array.
+		template<typename _T, size_t _Size>
+		const _T& Choice(_In_ const _T(&values)[_Size]) {
+			return values[m_engine() % _Size];
+		}
+
+	private:
+		std::mt19937 m_engine;
+	};
+
+	// Writes the sections of the beatmap before the timing points.
+	void WriteBeatmapHeader(_Inout_ std::ostringstream& stream, _In_ const SyntheticBeatmap& beatmap) {
+		stream <<
+			"osu file format v14\r\n\r\n"
+			"[General]\r\nAudioFilename: audio.mp3\r\nStackLeniency: 0.7\r\nMode: 0\r\n\r\n"
+			"[Metadata]\r\nTitle:Synthetic\r\nArtist:Tests\r\nCreator:Tests\r\nVersion:Seed " << beatmap.m_seed << "\r\nBeatmapID:0\r\n\r\n"
+			"[Difficulty]\r\nHPDrainRate:5\r\nCircleSize:4\r\nOverallDifficulty:8\r\nApproachRate:" << beatmap.m_approachRate <<
+			"\r\nSliderMultiplier:1.8\r\nSliderTickRate:1\r\n\r\n"
+			"[Events]\r\n\r\n"
+			"[TimingPoints]\r\n";
+	}
+
+	// Writes a beatmap with all kinds of hit objects at random positions.
+	void WriteMixedHitObjects(_Inout_ std::ostringstream& stream, _In_ const SyntheticBeatmap& beatmap, _Inout_ SyntheticRandom& random) {
+		static const int circleIntervals[] = { 83, 166, 333 };
+		static const char sliderTypes[] = { 'L', 'P', 'B', 'B', 'C' };
+		static const UINT repeatCounts[] = { 1U, 1U, 2U, 3U };
+		static const char* pixelLenghts[] = { "70", "140", "210.5", "300" };
+		static const int velocities[] = { 50, 75, 100, 133, 200 };
+
+		// The red timing points are 20 seconds apart, with green timing points that change the slider velocity.
+		for (int i = 0; i < 200; i++) {
+			if (i % 10 == 0) {
+				stream << 1000 + i * 20000 << ",333.333333333333,4,2,0,60,1,0\r\n";
+			}
+			else {
+				stream << 1000 + i * 20000 << ",-" << random.Choice(velocities) << ",4,2,0,60,0,0\r\n";
+			}
+		}
+		stream << "\r\n[HitObjects]\r\n";
+
+		int time = 1000;
+		for (UINT i = 0U; i < beatmap.m_hitObjectCount; i++) {
+			const int x = random.Integer(0, 512);
+			const int y = random.Integer(0, 384);
+			const double kind = random.Fraction();
+
+			if (kind < 0.5) {
+				stream << x << ',' << y << ',' << time << ",1,0,0:0:0:0:\r\n";
+				time += random.Choice(circleIntervals);
+			}
+			else if (kind < 0.95) {
+				const char sliderType = random.Choice(sliderTypes);
+				const int pointCount = (sliderType == 'L') ? random.Integer(1, 3) :
+					(sliderType == 'P') ? 2 : (sliderType == 'B') ? random.Integer(2, 7) : random.Integer(2, 5);
+
+				stream << x << ',' << y << ',' << time << ",2,0," << sliderType;
+				for (int j = 0; j < pointCount; j++) {
+					const int pointX = random.Integer(0, 512);
+					const int pointY = random.Integer(0, 384);
+					stream << '|' << pointX << ':' << pointY;
+
+					// Some bezier sliders have a red anchor.
+					if (sliderType == 'B' && j == 1 && random.Fraction() < 0.5) {
+						stream << '|' << pointX << ':' << pointY;
+					}
+				}
+
+				const UINT repeatCount = random.Choice(repeatCounts);
+				stream << ',' << repeatCount << ',' << random.Choice(pixelLenghts) << ",0|0,0:0|0:0,0:0:0:0:\r\n";
+				time += 700 * repeatCount;
+			}
+			else {
+				stream << "256,192," << time << ",12,0," << time + 1500 << ",0:0:0:0:\r\n";
+				time += 2000;
+			}
+		}
+	}
+
+	// Writes a beatmap of streams stacked on a few spots, with linear sliders between the spots.
+	void WriteStackedStreams(_Inout_ std::ostringstream& stream, _In_ const SyntheticBeatmap& beatmap, _Inout_ SyntheticRandom& random) {
+		static const int stackOffsets[] = { 0, 0, 1, 2 };
+		static const int sliderPauses[] = { 60, 120, 250 };
+		static const UINT repeatCounts[] = { 1U, 1U, 2U };
+		static const int spinnerLenghts[] = { 100, 1500 };
+		static const int spinnerPauses[] = { 150, 2000 };
+
+		stream << "1000,333.333333333333,4,2,0,60,1,0\r\n\r\n[HitObjects]\r\n";
+
+		POINT spots[12];
+		for (POINT& spot : spots) {
+			spot.x = random.Integer(0, 512);
+			spot.y = random.Integer(0, 384);
+		}
+
+		int time = 1000;
+		UINT hitObjectCount = 0U;
+		while (hitObjectCount < beatmap.m_hitObjectCount) {
+			const POINT& spot = random.Choice(spots);
+			const double kind = random.Fraction();
+
+			if (kind < 0.55) {
+				// A stream stacked on the spot.
+				const int circleCount = random.Integer(1, 12);
+				for (int i = 0; i < circleCount && hitObjectCount < beatmap.m_hitObjectCount; i++) {
+					stream << spot.x + random.Choice(stackOffsets) << ',' << spot.y << ',' << time << ",1,0,0:0:0:0:\r\n";
+					time += beatmap.m_circleInterval;
+					hitObjectCount++;
+				}
+			}
+			else if (kind < 0.95) {
+				const POINT& endSpot = random.Choice(spots);
+				const double pixelLenght = std::hypot(endSpot.x - spot.x, endSpot.y - spot.y);
+				if (pixelLenght < 5.0) {
+					continue;
+				}
+
+				const UINT repeatCount = random.Choice(repeatCounts);
+				stream << spot.x << ',' << spot.y << ',' << time << ",2,0,L|" << endSpot.x << ':' << endSpot.y << ',' <<
+					repeatCount << ',' << pixelLenght << ",0|0,0:0|0:0,0:0:0:0:\r\n";
+				time += random.Choice(sliderPauses) + static_cast<int>(pixelLenght / 1.8 / 100.0 * 333.0 * repeatCount);
+				hitObjectCount++;
+			}
+			else {
+				stream << "256,192," << time << ",12,0," << time + random.Choice(spinnerLenghts) << ",0:0:0:0:\r\n";
+				time += random.Choice(spinnerPauses);
+				hitObjectCount++;
+			}
+		}
+	}
+
+	// Writes a beatmap of circles at random positions.
+	void WriteCircles(_Inout_ std::ostringstream& stream, _In_ const SyntheticBeatmap& beatmap, _Inout_ SyntheticRandom& random) {
+		stream << "1000,333.333333333333,4,2,0,60,1,0\r\n\r\n[HitObjects]\r\n";
+
+		for (UINT i = 0U; i < beatmap.m_hitObjectCount; i++) {
+			const int x = random.Integer(0, 512);
+			const int y = random.Integer(0, 384);
+			stream << x << ',' << y << ',' << 1000 + static_cast<int>(i) * beatmap.m_circleInterval << ",1,0,0:0:0:0:\r\n";
+		}
+	}
+}
+
+
+// This function returns the path of the beatmap, the beatmaps folder is set by the build.
+std::wstring OsuBotTests::GetTestBeatmapPath(_In_ const char* fileName) {
+	const std::string path = std::string(OSUBOT_TEST_BEATMAPS) + "/" + fileName;
+	return std::wstring(path.begin(), path.end());
+}
+
+// This function writes the synthetic beatmap, the hit objects are generated from its seed.
+std::string OsuBotTests::MakeSyntheticBeatmap(_In_ const SyntheticBeatmap& beatmap) {
+	std::ostringstream stream;
+	stream.precision(10);
+	SyntheticRandom random(beatmap.m_seed);
+
+	WriteBeatmapHeader(stream, beatmap);
+	switch (beatmap.m_kind) {
+	case BeatmapKind::Mixed:
+		WriteMixedHitObjects(stream, beatmap, random);
+		break;
+	case BeatmapKind::StackedStreams:
+		WriteStackedStreams(stream, beatmap, random);
+		break;
+	case BeatmapKind::Circles:
+		WriteCircles(stream, beatmap, random);
+		break;
+	}
+
+	return stream.str();
+}
+
+
+// Constructor.
+TestDirectory::TestDirectory(_In_ const std::string& name) :
+	m_path(std::filesystem::temp_directory_path() / ("OsuBotTests_" + name)),
+	m_previousWorkingDirectory(std::filesystem::current_path())
+{
+	std::filesystem::remove_all(m_path);
+	std::filesystem::create_directories(m_path);
+	std::filesystem::current_path(m_path);
+}
+
+// Destructor.
+TestDirectory::~TestDirectory() {
+	std::error_code error;
+	std::filesystem::current_path(m_previousWorkingDirectory, error);
+	std::filesystem::remove_all(m_path, error);
+}
+
+// This function writes the file, the content is written as is.
+std::wstring TestDirectory::WriteFile(_In_ const std::string& fileName, _In_ const std::string& content) const {
+	const std::filesystem::path path = m_path / fileName;
+	std::ofstream file(path, std::ios::binary);
+	file << content;
+	return path.wstring();
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+// TestBeatmaps.h : Declares the synthetic beatmaps of the tests and benchmarks,
+// and a directory that the tests write their beatmaps to.
+
+#pragma once
+
+#include <Common/Pch.h>
+
+#include <filesystem>
+#include <string>
+
+
+namespace OsuBotTests
+{
+	// The kinds of synthetic beatmaps.
+	enum class BeatmapKind {
+		// Circles, linear, perfect circle, bezier and catmull sliders with repeats, and spinners,
+		// at random positions, with 200 timing points that change the slider velocity.
+		Mixed,
+		// Streams of circles stacked on a few spots, linear sliders between them, and spinners.
+		StackedStreams,
+		// Circles at random positions, the circle interval apart.
+		Circles
+	};
+
+	// The settings of a synthetic beatmap, the same settings always give the same beatmap.
+	struct SyntheticBeatmap {
+		BeatmapKind m_kind = BeatmapKind::Mixed;
+		UINT m_hitObjectCount = 1000U;
+		UINT m_seed = 1U;
+		float m_approachRate = 9.f;
+		// The time between two circles of a stream (StackedStreams) or between all circles (Circles), in milliseconds.
+		int m_circleInterval = 40;
+	};
+
+	// Returns the path of a beatmap in Tests/Beatmaps.
+	std::wstring GetTestBeatmapPath(_In_ const char* fileName);
+
+	// Returns the content of the .osu file of the synthetic beatmap.
+	std::string MakeSyntheticBeatmap(_In_ const SyntheticBeatmap& beatmap);
+
+	// A new empty directory that is the working directory while the object lives.
+	// The compiled beatmaps of the beatmap cache are written to the working directory.
+	class TestDirectory {
+	public:
+		// Constructor and destructor.
+		explicit TestDirectory(_In_ const std::string& name);
+		~TestDirectory();
+
+		TestDirectory(const TestDirectory&) = delete;
+		TestDirectory& operator=(const TestDirectory&) = delete;
+
+		// Member functions.
+		// Writes the file into the directory, returns its full path.
+		std::wstring WriteFile(_In_ const std::string& fileName, _In_ const std::string& content) const;
+
+		// Accessor functions.
+		const std::filesystem::path& GetPath() const { return m_path; }
+
+
+	private:
+		// Member variables.
+		std::filesystem::path m_path;
+		std::filesystem::path m_previousWorkingDirectory;
+	};
+}
\ No newline at end of file
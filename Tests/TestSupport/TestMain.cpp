@@ -0,0 +1,79 @@
+// TestMain.cpp : Runs the test cases of a test executable.
+// Pass test case names to only run those. Returns 1 if a test case failed.
+
+#include <TestSupport/Test.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+using namespace OsuBotTests;
+
+
+namespace
+{
+	struct TestCase {
+		const char* name;
+		TestFunction function;
+	};
+
+	// The registered test cases, in order of registration.
+	std::vector<TestCase>& GetTestCases() {
+		static std::vector<TestCase> testCases;
+		return testCases;
+	}
+
+	// The failures of the running test case.
+	UINT failureCount = 0U;
+}
+
+
+TestRegistration::TestRegistration(_In_ const char* name, _In_ TestFunction function) {
+	GetTestCases().push_back({ name, function });
+}
+
+void OsuBotTests::ReportFailure(_In_ const char* file, _In_ const int& line, _In_ const std::string& message) {
+	fprintf(stderr, "%s:%d: failed %s\n", file, line, message.c_str());
+	failureCount++;
+}
+
+
+int main(int argc, char** argv) {
+	UINT failedTestCount = 0U;
+	UINT testCount = 0U;
+
+	for (const TestCase& testCase : GetTestCases()) {
+		// Only run the named test cases, if any are named.
+		bool selected = argc < 2;
+		for (int i = 1; i < argc && !selected; i++) {
+			selected = strcmp(argv[i], testCase.name) == 0;
+		}
+		if (!selected) {
+			continue;
+		}
+
+		failureCount = 0U;
+		try {
+			testCase.function();
+		}
+		catch (const RequireFailed&) {
+			// The failure is reported already.
+		}
+		catch (const std::exception& exception) {
+			ReportFailure(testCase.name, 0, std::string("exception: ") + exception.what());
+		}
+		catch (...) {
+			ReportFailure(testCase.name, 0, "unknown exception");
+		}
+
+		printf("[%s] %s\n", failureCount == 0U ? "  OK  " : "FAILED", testCase.name);
+		testCount++;
+		if (failureCount > 0U) {
+			failedTestCount++;
+		}
+	}
+
+	printf("%u of %u test cases passed.\n", testCount - failedTestCount, testCount);
+	return (failedTestCount == 0U && testCount > 0U) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+// UpdateRateTests.cpp : Tests that the cursor is at the same position at the same song time,
+// whatever the number of updates per second the bot plays with.
+
+#include <TestSupport/Test.h>
+#include <TestSupport/TestBeatmaps.h>
+
+#include <Content/OsuBot/HeadlessDriver.h>
+
+#include <cmath>
+#include <map>
+
+
+using namespace OsuBot;
+using namespace OsuBotTests;
+
+
+namespace
+{
+	const DX::Size<INT> windowSize(1920, 1080);
+
+	// The cursor positions at the end of every tick, and the clicks, of a song played at an update rate.
+	struct PlayedSong {
+		// The song time in microseconds, and the last cursor position of the tick at that time.
+		std::map<long long, POINT> m_cursorPositions;
+		UINT m_pressCount = 0U;
+		UINT m_releaseCount = 0U;
+	};
+
+	PlayedSong PlaySong(_In_ const std::wstring& beatmapPath, _In_ const UINT& updatesPerSecond) {
+		PlayedSong song;
+		HeadlessDriver driver(windowSize, updatesPerSecond);
+		if (!driver.Play(beatmapPath)) {
+			return song;
+		}
+
+		for (const OutputEvent& event : driver.GetEvents()) {
+			if (event.m_type == OutputEvent::Move) {
+				song.m_cursorPositions[llround(event.m_songTime * 1000.0)] = event.m_position;
+			}
+			else if (event.m_type == OutputEvent::Press) {
+				song.m_pressCount++;
+			}
+			else {
+				song.m_releaseCount++;
+			}
+		}
+		return song;
+	}
+
+	// Plays the beatmap at 120, 240 and 500 updates per second and checks the cursor against 1000 updates per second,
+	// at every song time both rates have a tick at.
+	void CheckUpdateRates(_In_ const std::wstring& beatmapPath) {
+		const PlayedSong referenceSong = PlaySong(beatmapPath, 1000U);
+		REQUIRE(!referenceSong.m_cursorPositions.empty());
+
+		for (const UINT updatesPerSecond : { 120U, 240U, 500U }) {
+			const PlayedSong song = PlaySong(beatmapPath, updatesPerSecond);
+			CHECK_EQUAL(referenceSong.m_pressCount, song.m_pressCount);
+			CHECK_EQUAL(referenceSong.m_releaseCount, song.m_releaseCount);
+
+			UINT comparedTickCount = 0U;
+			UINT differentTickCount = 0U;
+			for (const auto& [songTime, position] : song.m_cursorPositions) {
+				const auto referencePosition = referenceSong.m_cursorPositions.find(songTime);
+				if (referencePosition == referenceSong.m_cursorPositions.end()) {
+					continue;
+				}
+
+				comparedTickCount++;
+				if (position.x != referencePosition->second.x || position.y != referencePosition->second.y) {
+					differentTickCount++;
+				}
+			}
+
+			printf("%u UPS: %u ticks at the same song time as 1000 UPS, %u at a different position\n",
+				updatesPerSecond, comparedTickCount, differentTickCount);
+			CHECK(comparedTickCount > 100U);
+			CHECK_EQUAL(0U, differentTickCount);
+		}
+	}
+}
+
+
+TEST_CASE(AllObjectTypesAtEveryUpdateRate) {
+	CheckUpdateRates(GetTestBeatmapPath("AllObjectTypes.osu"));
+}
+
+TEST_CASE(MixedBeatmapAtEveryUpdateRate) {
+	const TestDirectory directory("MixedBeatmapAtEveryUpdateRate");
+	SyntheticBeatmap synthetic;
+	synthetic.m_hitObjectCount = 400U;
+	CheckUpdateRates(directory.WriteFile("Mixed.osu", MakeSyntheticBeatmap(synthetic)));
+}
+
+TEST_CASE(StackedStreamsAtEveryUpdateRate) {
+	const TestDirectory directory("StackedStreamsAtEveryUpdateRate");
+	SyntheticBeatmap synthetic;
+	synthetic.m_kind = BeatmapKind::StackedStreams;
+	synthetic.m_hitObjectCount = 400U;
+	synthetic.m_circleInterval = 83;
+	CheckUpdateRates(directory.WriteFile("StackedStreams.osu", MakeSyntheticBeatmap(synthetic)));
+}
\ No newline at end of file